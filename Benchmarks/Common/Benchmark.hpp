@@ -0,0 +1,171 @@
+#ifndef MATHLIB_BENCHMARKS_COMMON_BENCHMARK_HPP
+#define MATHLIB_BENCHMARKS_COMMON_BENCHMARK_HPP
+
+#include <Math/Base.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+// Note(3011):
+// Minimal timing harness shared by the benchmark targets. Every measurement
+// is repeated and the fastest run is reported, which filters out most of the
+// noise from the scheduler and frequency scaling. Cycles come from the time
+// stamp counter, which ticks at a constant reference rate rather than the
+// actual core clock, so they are only comparable on the same machine.
+
+namespace Benchmark
+{
+    using namespace Math::Types;
+
+    [[nodiscard]] inline
+    bool HasCycleCounter() noexcept
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] inline
+    u64 ReadCycleCounter() noexcept
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    // Note(3011): Forces the value to be computed, without storing it anywhere.
+    template <typename T>
+    inline
+    void DoNotOptimize(const T& value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Measurement
+    {
+        u64 Count;
+        f64 Seconds;
+        f64 Cycles;
+
+        [[nodiscard]]
+        f64 PerSecond() const noexcept
+        {
+            return Math::Cast<f64>(Count) / Seconds;
+        }
+
+        [[nodiscard]]
+        f64 NanosecondsPerItem() const noexcept
+        {
+            return Seconds * 1.0e9 / Math::Cast<f64>(Count);
+        }
+
+        [[nodiscard]]
+        f64 CyclesPerItem() const noexcept
+        {
+            return Cycles / Math::Cast<f64>(Count);
+        }
+    };
+
+    // Note(3011): Runs func (which should process count items) repeatedly and
+    // keeps the fastest run.
+    template <Math::Concept::Invocable<> Func>
+    [[nodiscard]]
+    Measurement Measure(u64 count, Func&& func, u32 repetitions = 5)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Note(3011): Warm up caches and branch predictors.
+        func();
+
+        Measurement best{ count, f64::Infinity(), f64::Infinity() };
+        for (u32 i = 0; i < repetitions; ++i)
+        {
+            Clock::time_point start = Clock::now();
+            u64 startCycles = ReadCycleCounter();
+            func();
+            u64 endCycles = ReadCycleCounter();
+            Clock::time_point end = Clock::now();
+
+            f64 seconds = std::chrono::duration<double>(end - start).count();
+            if (seconds < best.Seconds)
+            {
+                best.Seconds = seconds;
+                best.Cycles = Math::Cast<f64>(endCycles - startCycles);
+            }
+        }
+        return best;
+    }
+
+    inline
+    void PrintHeader(std::string_view title, std::string_view unit)
+    {
+        std::cout << '\n' << title << '\n'
+                  << std::left << std::setw(40) << "Name"
+                  << std::right << std::setw(16) << ("M" + std::string(unit) + "/s")
+                  << std::setw(16) << ("ns/" + std::string(unit))
+                  << std::setw(16) << ("cycles/" + std::string(unit)) << '\n'
+                  << std::string(88, '-') << '\n';
+    }
+
+    inline
+    void PrintRow(std::string_view name, const Measurement& measurement)
+    {
+        std::cout << std::left << std::setw(40) << name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(16) << Math::ToUnderlying(measurement.PerSecond() / 1.0e6)
+                  << std::setw(16) << Math::ToUnderlying(measurement.NanosecondsPerItem());
+        if (HasCycleCounter())
+        {
+            std::cout << std::setw(16) << Math::ToUnderlying(measurement.CyclesPerItem());
+        }
+        else
+        {
+            std::cout << std::setw(16) << "n/a";
+        }
+        std::cout << '\n';
+    }
+
+    // Note(3011): Machine readable output, one CSV line per measurement. The
+    // leading columns (keys) describe the measurement and are up to the
+    // benchmark, the values must not contain commas.
+    inline
+    void PrintCsvHeader(std::string_view keys)
+    {
+        std::cout << keys << ",count,seconds,ns_per_item,items_per_second,cycles_per_item\n";
+    }
+
+    inline
+    void PrintCsvRow(std::string_view values, const Measurement& measurement)
+    {
+        std::cout << values << ',' << Math::ToUnderlying(measurement.Count)
+                  << ',' << std::scientific << std::setprecision(6) << Math::ToUnderlying(measurement.Seconds)
+                  << ',' << Math::ToUnderlying(measurement.NanosecondsPerItem())
+                  << ',' << Math::ToUnderlying(measurement.PerSecond())
+                  << ',';
+        if (HasCycleCounter())
+        {
+            std::cout << Math::ToUnderlying(measurement.CyclesPerItem());
+        }
+        std::cout << std::defaultfloat << '\n';
+    }
+}
+
+#endif //MATHLIB_BENCHMARKS_COMMON_BENCHMARK_HPP
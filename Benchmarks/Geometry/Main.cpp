@@ -0,0 +1,328 @@
+#include <Benchmark.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Random.hpp>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace Math::Types;
+
+namespace
+{
+    constexpr u64 PairCount = u64(1) << 20;
+
+    // Note(3011): The triangle test the library had before the Moller-Trumbore
+    // and watertight ones, kept here as the baseline.
+    template <Math::Concept::StrongFloatType T>
+    [[nodiscard]]
+    Math::Geometry::Intersection<T> ProjectionIntersection(const Math::Geometry::Ray<T>& ray, const Math::Geometry::Interval<T>& interval,
+                                                           const Math::Geometry::Triangle<T>& triangle) noexcept
+    {
+        using Float = T;
+        using PointType = typename Math::Geometry::Ray<Float>::PointType;
+        using VectorType = typename Math::Geometry::Ray<Float>::VectorType;
+        using Math::Cast;
+        using Math::Geometry::Intersection;
+
+        VectorType u = triangle.B - triangle.A;
+        VectorType v = triangle.C - triangle.A;
+
+        VectorType normal = Math::Cross(u, v);
+        if (Math::Equal(normal, VectorType(Cast<Float>(0))))
+        {
+            return Intersection<Float>(Float::NaN());
+        }
+
+        Float a = -Math::Dot(normal, ray.Origin - triangle.A);
+        Float b = Math::Dot(normal, ray.Direction);
+        if (Math::Equal(b, Cast<Float>(0), Math::Constant::GeometryEpsilon<Float>))
+        {
+            if (Math::Equal(a, Cast<Float>(0), Math::Constant::GeometryEpsilon<Float>))
+            {
+                return Intersection<Float>(Cast<Float>(0));
+            }
+            else
+            {
+                return Intersection<Float>(Float::NaN());
+            }
+        }
+
+        Float distance = a / b;
+        if (distance < Cast<Float>(0))
+        {
+            return Intersection<Float>(Float::NaN());
+        }
+
+        PointType intersect = ray.Project(distance);
+        VectorType w = intersect - triangle.A;
+        Float det = Math::Squared(Math::Dot(u, v)) - u.LenSqr() * v.LenSqr();
+        Float s = (Math::Dot(u, v) * Math::Dot(w, v) - v.LenSqr() * Math::Dot(u, w)) / det;
+        Float t = (Math::Dot(u, v) * Math::Dot(u, w) - u.LenSqr() * Math::Dot(w, v)) / det;
+
+        if (s > Cast<Float>(0) && t > Cast<Float>(0) && (s + t) <= Cast<Float>(1))
+        {
+            return Intersection<Float>(interval.Pick(distance));
+        }
+        else
+        {
+            return Intersection<Float>(Float::NaN());
+        }
+    }
+
+    template <typename Float>
+    struct TestCase
+    {
+        Math::Geometry::Ray<Float> Ray;
+        Math::Geometry::Triangle<Float> Triangle;
+    };
+
+    // Note(3011): Rays from around the origin towards random triangles, aimed
+    // at a point of the plane of the triangle. The aim point is inside the
+    // triangle for roughly hitRate of the cases, so the early outs of the
+    // tests get exercised in proportion.
+    template <typename Float>
+    [[nodiscard]]
+    std::vector<TestCase<Float>> MakeTestCases(f64 hitRate)
+    {
+        using Point = Math::Geometry::Point<Float>;
+
+        Math::Random64 rng(1);
+        Math::UniformDistribution<Float> position(Math::Cast<Float>(-10), Math::Cast<Float>(10));
+        Math::UniformDistribution<Float> unit(Math::Cast<Float>(0), Math::Cast<Float>(1));
+        Math::UniformDistribution<f64> chance(0.0, 1.0);
+
+        std::vector<TestCase<Float>> cases;
+        cases.reserve(Math::ToUnderlying(PairCount));
+        for (u64 i = 0; i < PairCount; ++i)
+        {
+            Point a(position(rng), position(rng), position(rng));
+            Point b = a + Math::Vector3T<Float>(unit(rng), unit(rng), unit(rng));
+            Point c = a + Math::Vector3T<Float>(unit(rng), unit(rng), unit(rng));
+
+            Float u = unit(rng);
+            Float v = unit(rng);
+            if ((chance(rng) < hitRate) == (u + v > Math::Cast<Float>(1)))
+            {
+                u = Math::Cast<Float>(1) - u;
+                v = Math::Cast<Float>(1) - v;
+            }
+
+            Point target = a + (b - a) * u + (c - a) * v;
+            Point origin(unit(rng), unit(rng), unit(rng));
+            cases.push_back({ Math::Geometry::Ray<Float>(origin, target - origin), Math::Geometry::Triangle<Float>(a, b, c) });
+        }
+        return cases;
+    }
+
+    template <typename Float, typename Test>
+    void BenchmarkTest(std::string_view name, const std::vector<TestCase<Float>>& cases, Test&& test)
+    {
+        Benchmark::PrintRow(name, Benchmark::Measure(PairCount, [&]()
+        {
+            u64 hits = 0;
+            for (const TestCase<Float>& testCase : cases)
+            {
+                hits += test(testCase.Ray, Math::Geometry::Interval<Float>(), testCase.Triangle).IsValid() ? 1 : 0;
+            }
+            Benchmark::DoNotOptimize(hits);
+        }));
+    }
+
+    template <typename Float>
+    void BenchmarkTriangles(std::string_view type)
+    {
+        using Math::Geometry::TriangleTest;
+
+        for (f64 hitRate : { 0.1, 0.5, 0.9 })
+        {
+            std::vector<TestCase<Float>> cases = MakeTestCases<Float>(hitRate);
+            std::string suffix = " (" + std::to_string(Math::ToUnderlying(Math::Cast<u32>(hitRate * 100.0))) + "% hits)";
+
+            Benchmark::PrintHeader("Ray-triangle<" + std::string(type) + ">" + suffix, "tests");
+            BenchmarkTest<Float>("Projection (previous)", cases, [](const auto& ray, const auto& interval, const auto& triangle)
+            {
+                return ProjectionIntersection(ray, interval, triangle);
+            });
+            BenchmarkTest<Float>("Moller-Trumbore", cases, [](const auto& ray, const auto& interval, const auto& triangle)
+            {
+                return Math::Geometry::NearestIntersection<TriangleTest::MollerTrumbore>(ray, interval, triangle);
+            });
+            BenchmarkTest<Float>("Watertight", cases, [](const auto& ray, const auto& interval, const auto& triangle)
+            {
+                return Math::Geometry::NearestIntersection<TriangleTest::Watertight>(ray, interval, triangle);
+            });
+
+            // Note(3011): With the ray set up once, as when it is tested
+            // against many triangles.
+            std::vector<Math::Geometry::RayPrecomputed<Float>> rays;
+            rays.reserve(cases.size());
+            for (const TestCase<Float>& testCase : cases)
+            {
+                rays.emplace_back(testCase.Ray);
+            }
+
+            Benchmark::PrintRow("Watertight (precomputed ray)", Benchmark::Measure(PairCount, [&]()
+            {
+                u64 hits = 0;
+                for (std::size_t i = 0; i < cases.size(); ++i)
+                {
+                    hits += Math::Geometry::NearestIntersection<TriangleTest::Watertight>(rays[i], Math::Geometry::Interval<Float>(), cases[i].Triangle).IsValid() ? 1 : 0;
+                }
+                Benchmark::DoNotOptimize(hits);
+            }));
+        }
+    }
+
+    constexpr u32 ImageSize = 512;
+
+    // Note(3011): A displaced grid of triangles filling the view, traced with
+    // pinhole camera rays through the pixels, the way primary visibility is.
+    // The packets cover 2x2 and 4x2 pixel tiles.
+    [[nodiscard]]
+    Math::Geometry::TriangleMesh<f32> MakeTerrain(u32 resolution)
+    {
+        Math::Random64 rng(2);
+        Math::UniformDistribution<f32> height(-0.05f, 0.05f);
+
+        std::vector<Math::Geometry::Point<f32>> positions;
+        std::vector<u32> indices;
+        f32 step = 4.0f / Math::Cast<f32>(resolution);
+        for (u32 y = 0; y <= resolution; ++y)
+        {
+            for (u32 x = 0; x <= resolution; ++x)
+            {
+                positions.emplace_back(Math::Cast<f32>(x) * step - 2.0f, Math::Cast<f32>(y) * step - 2.0f, height(rng));
+            }
+        }
+        for (u32 y = 0; y < resolution; ++y)
+        {
+            for (u32 x = 0; x < resolution; ++x)
+            {
+                u32 corner = y * (resolution + 1) + x;
+                indices.insert(indices.end(), { corner, corner + 1, corner + resolution + 1 });
+                indices.insert(indices.end(), { corner + 1, corner + resolution + 2, corner + resolution + 1 });
+            }
+        }
+        return Math::Geometry::TriangleMesh<f32>(positions, indices);
+    }
+
+    [[nodiscard]]
+    Math::Geometry::Ray<f32> CameraRay(u32 x, u32 y) noexcept
+    {
+        f32 u = (Math::Cast<f32>(x) + 0.5f) / Math::Cast<f32>(ImageSize) * 2.0f - 1.0f;
+        f32 v = (Math::Cast<f32>(y) + 0.5f) / Math::Cast<f32>(ImageSize) * 2.0f - 1.0f;
+        return Math::Geometry::Ray<f32>(Math::Geometry::Point<f32>(0.0f, 0.0f, 3.0f), Math::Normalize(Math::Vector3f(u, v, -1.5f)));
+    }
+
+    template <SizeType Width, SizeType Height, typename Hierarchy>
+    void BenchmarkPackets(std::string_view name, const Hierarchy& bvh)
+    {
+        constexpr SizeType N = Width * Height;
+
+        Benchmark::PrintRow(name, Benchmark::Measure(Math::Cast<u64>(ImageSize * ImageSize), [&]()
+        {
+            u64 hits = 0;
+            for (u32 y = 0; y < ImageSize; y += Math::Cast<u32>(Height))
+            {
+                for (u32 x = 0; x < ImageSize; x += Math::Cast<u32>(Width))
+                {
+                    Math::Geometry::RayPacket<f32, N> rays;
+                    for (SizeType lane = 0; lane < N; ++lane)
+                    {
+                        rays.Set(lane, CameraRay(x + Math::Cast<u32>(lane % Width), y + Math::Cast<u32>(lane / Width)));
+                    }
+
+                    Math::Geometry::BVHIntersectionPacket<f32, N> nearest = bvh.NearestIntersection(rays, Math::Geometry::Interval<f32>());
+                    for (SizeType lane = 0; lane < N; ++lane)
+                    {
+                        hits += nearest.IsValid(lane) ? 1 : 0;
+                    }
+                }
+            }
+            Benchmark::DoNotOptimize(hits);
+        }));
+    }
+
+    // Note(3011): The packets gain less once the triangles get smaller than
+    // the pixels, the rays of a packet then part ways above the leaves.
+    void BenchmarkPrimaryRays(u32 resolution)
+    {
+        Math::Geometry::TriangleMesh<f32> mesh = MakeTerrain(resolution);
+        std::vector<Math::Geometry::MeshTriangle<f32>> triangles = Math::Geometry::MeshTriangles(mesh);
+        Math::Geometry::BVH<Math::Geometry::MeshTriangle<f32>> bvh{std::span<const Math::Geometry::MeshTriangle<f32>>(triangles)};
+
+        Benchmark::PrintHeader("Primary rays, " + std::to_string(Math::ToUnderlying(mesh.TriangleCount())) + " triangles", "rays");
+        Benchmark::PrintRow("Single rays", Benchmark::Measure(Math::Cast<u64>(ImageSize * ImageSize), [&]()
+        {
+            u64 hits = 0;
+            for (u32 y = 0; y < ImageSize; ++y)
+            {
+                for (u32 x = 0; x < ImageSize; ++x)
+                {
+                    hits += bvh.NearestIntersection(CameraRay(x, y), Math::Geometry::Interval<f32>()).IsValid() ? 1 : 0;
+                }
+            }
+            Benchmark::DoNotOptimize(hits);
+        }));
+        BenchmarkPackets<2, 2>("Packets of 4 (2x2)", bvh);
+        BenchmarkPackets<4, 2>("Packets of 8 (4x2)", bvh);
+    }
+
+    // Note(3011): Build throughput in primitives per second, every preset on
+    // 1, 2, 4, ... threads up to all of them, to show how the builds scale.
+    // The builds give the same hierarchy for any thread count, only the time
+    // differs. Linear is the one to rebuild every frame.
+    void BenchmarkBuilds(u32 resolution)
+    {
+        using Math::Geometry::BVHBuildSettings;
+        using Math::Geometry::BVHPreset;
+
+        Math::Geometry::TriangleMesh<f32> mesh = MakeTerrain(resolution);
+        std::vector<Math::Geometry::MeshTriangle<f32>> triangles = Math::Geometry::MeshTriangles(mesh);
+        std::span<const Math::Geometry::MeshTriangle<f32>> primitives(triangles);
+
+        SizeType threads = Math::HardwareThreadCount();
+        Benchmark::PrintHeader("BVH builds, " + std::to_string(Math::ToUnderlying(mesh.TriangleCount())) + " triangles, "
+                               + std::to_string(Math::ToUnderlying(threads)) + " hardware threads", "prims");
+
+        std::vector<SizeType> threadCounts;
+        for (SizeType threadCount = 1; threadCount < threads; threadCount *= 2)
+        {
+            threadCounts.push_back(threadCount);
+        }
+        threadCounts.push_back(threads);
+
+        std::pair<std::string_view, BVHPreset> presets[] = {
+            { "Fast", BVHPreset::Fast },
+            { "Balanced", BVHPreset::Balanced },
+            { "Quality", BVHPreset::Quality },
+            { "Linear", BVHPreset::Linear },
+            { "LinearOptimized", BVHPreset::LinearOptimized },
+        };
+        for (const auto& [name, preset] : presets)
+        {
+            for (SizeType threadCount : threadCounts)
+            {
+                std::string row = std::string(name) + ", " + std::to_string(Math::ToUnderlying(threadCount))
+                                  + ((threadCount == 1) ? " thread" : " threads");
+                Benchmark::PrintRow(row, Benchmark::Measure(Math::Cast<u64>(mesh.TriangleCount()), [&]()
+                {
+                    Math::Geometry::BVH<Math::Geometry::MeshTriangle<f32>> bvh(primitives, BVHBuildSettings(preset), threadCount);
+                    Benchmark::DoNotOptimize(bvh.Nodes().size());
+                }, 3));
+            }
+        }
+    }
+}
+
+int main()
+{
+    BenchmarkTriangles<f32>("f32");
+    BenchmarkTriangles<f64>("f64");
+    BenchmarkPrimaryRays(64);
+    BenchmarkPrimaryRays(256);
+    BenchmarkBuilds(512);
+}
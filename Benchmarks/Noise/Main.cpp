@@ -0,0 +1,196 @@
+#include <Benchmark.hpp>
+#include <Math/Noise.hpp>
+
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Math::Types;
+
+namespace
+{
+    constexpr u64 SampleCount = u64(1) << 18;
+    constexpr SizeType PacketWidth = 8;
+
+    // Note(3011): The grids have SampleCount samples too, 512^2 and 64^3.
+    constexpr SizeType GridSize2 = 512;
+    constexpr SizeType GridSize3 = 64;
+
+    // Note(3011):
+    // Collects the measurements and prints them either as tables for reading
+    // or as CSV for tracking regressions, with the columns
+    //   noise,type,dimension,mode,threads,count,seconds,ns_per_item,
+    //   items_per_second,cycles_per_item
+    // Modes are scalar (a call per point), packet (PacketWidth points per
+    // call) and grid (Noise::FillGrid, with the given number of threads).
+    class Reporter
+    {
+    public:
+        explicit Reporter(bool csv)
+            : mCsv(csv)
+        {
+            if (mCsv)
+            {
+                Benchmark::PrintCsvHeader("noise,type,dimension,mode,threads");
+            }
+        }
+
+        void Section(std::string_view title) const
+        {
+            if (!mCsv)
+            {
+                Benchmark::PrintHeader(title, "samples");
+            }
+        }
+
+        void Add(std::string_view noise, std::string_view type, u32 dimension, std::string_view mode,
+                 SizeType threads, const Benchmark::Measurement& measurement) const
+        {
+            std::string dimensionText = std::to_string(Math::ToUnderlying(dimension));
+            std::string threadText = std::to_string(Math::ToUnderlying(threads));
+            if (mCsv)
+            {
+                Benchmark::PrintCsvRow(std::string(noise) + ',' + std::string(type) + ',' + dimensionText + ','
+                                       + std::string(mode) + ',' + threadText, measurement);
+            }
+            else
+            {
+                std::string name = std::string(noise) + ' ' + dimensionText + "D " + std::string(mode);
+                if (mode == "grid")
+                {
+                    name += " (" + threadText + " threads)";
+                }
+                Benchmark::PrintRow(name, measurement);
+            }
+        }
+    private:
+        bool mCsv;
+    };
+
+    // Note(3011): Points along a line that crosses all the axes at different
+    // rates, so the samples hit different places in their cells and the cells
+    // change often.
+    template <typename Vec>
+    [[nodiscard]]
+    Vec SamplePoint(u64 i)
+    {
+        using Float = typename Vec::ScalarType;
+
+        constexpr Math::Array<f64, 4> rates(0.0137, 0.0101, -0.0073, 0.0049);
+
+        Vec point;
+        for (SizeType d = 0; d < Vec::Dimension; ++d)
+        {
+            point[d] = Math::Cast<Float>(Math::Cast<f64>(i) * rates[d]);
+        }
+        return point;
+    }
+
+    // Note(3011): The points and the packets are generated before the timing,
+    // so the timed loops only contain the noise calls and the sums.
+    template <typename Vec, typename Packet, typename Noise>
+    void BenchmarkPoints(const Reporter& reporter, std::string_view name, std::string_view type, const Noise& noise)
+    {
+        using Float = typename Vec::ScalarType;
+
+        constexpr u32 dimension = Math::Cast<u32>(Vec::Dimension);
+
+        std::vector<Vec> points(Math::ToUnderlying(SampleCount));
+        std::vector<Packet> packets(Math::ToUnderlying(SampleCount / Math::Cast<u64>(PacketWidth)));
+        for (u64 i = 0; i < SampleCount; ++i)
+        {
+            points[Math::ToUnderlying(i)] = SamplePoint<Vec>(i);
+            packets[Math::ToUnderlying(i / Math::Cast<u64>(PacketWidth))].Set(Math::Cast<SizeType>(i % Math::Cast<u64>(PacketWidth)), points[Math::ToUnderlying(i)]);
+        }
+
+        reporter.Add(name, type, dimension, "scalar", 1, Benchmark::Measure(SampleCount, [&]()
+        {
+            Float accumulator = 0;
+            for (const Vec& point : points)
+            {
+                accumulator += noise(point);
+            }
+            Benchmark::DoNotOptimize(accumulator);
+        }));
+
+        reporter.Add(name, type, dimension, "packet", 1, Benchmark::Measure(SampleCount, [&]()
+        {
+            Float accumulator = 0;
+            for (const Packet& packet : packets)
+            {
+                Math::Array<Float, PacketWidth> values = noise(packet);
+                for (SizeType lane = 0; lane < PacketWidth; ++lane)
+                {
+                    accumulator += values[lane];
+                }
+            }
+            Benchmark::DoNotOptimize(accumulator);
+        }));
+    }
+
+    template <typename Float, typename Noise>
+    void BenchmarkGrids(const Reporter& reporter, std::string_view name, std::string_view type, const Noise& noise)
+    {
+        std::vector<Float> values(Math::ToUnderlying(SampleCount));
+        std::span<Float> out(values);
+        Float step = Math::Cast<Float>(0.0137);
+
+        // Note(3011): Single threaded and on all the hardware threads, the
+        // second run is skipped on machines with a single hardware thread.
+        std::vector<SizeType> threadCounts = { 1 };
+        if (Math::HardwareThreadCount() > 1)
+        {
+            threadCounts.push_back(Math::HardwareThreadCount());
+        }
+
+        for (SizeType threads : threadCounts)
+        {
+            reporter.Add(name, type, 2, "grid", threads, Benchmark::Measure(SampleCount, [&]()
+            {
+                Math::Noise::FillGrid(noise, Math::Vector2T<Float>(Math::Cast<Float>(0)), Math::Vector2T<Float>(step),
+                                      Math::Vector2sz(GridSize2), out, threads);
+                Benchmark::DoNotOptimize(values.data());
+            }));
+
+            reporter.Add(name, type, 3, "grid", threads, Benchmark::Measure(SampleCount, [&]()
+            {
+                Math::Noise::FillGrid(noise, Math::Vector3T<Float>(Math::Cast<Float>(0)), Math::Vector3T<Float>(step),
+                                      Math::Vector3sz(GridSize3), out, threads);
+                Benchmark::DoNotOptimize(values.data());
+            }));
+        }
+    }
+
+    template <typename Float, typename Noise>
+    void BenchmarkNoise(const Reporter& reporter, std::string_view name, std::string_view type, const Noise& noise)
+    {
+        BenchmarkPoints<Math::Vector2T<Float>, Math::Vector2PacketT<Float, PacketWidth>>(reporter, name, type, noise);
+        BenchmarkPoints<Math::Vector3T<Float>, Math::Vector3PacketT<Float, PacketWidth>>(reporter, name, type, noise);
+        BenchmarkPoints<Math::Vector4T<Float>, Math::Vector4PacketT<Float, PacketWidth>>(reporter, name, type, noise);
+        BenchmarkGrids<Float>(reporter, name, type, noise);
+    }
+
+    template <typename Float>
+    void BenchmarkType(const Reporter& reporter, std::string_view type)
+    {
+        reporter.Section("Noise<" + std::string(type) + ">");
+        BenchmarkNoise<Float>(reporter, "Perlin", type, Math::Noise::Perlin<Float>(1));
+        BenchmarkNoise<Float>(reporter, "HashedPerlin", type, Math::Noise::HashedPerlin<Float>(1));
+        BenchmarkNoise<Float>(reporter, "Simplex", type, Math::Noise::Simplex<Float>(1));
+        BenchmarkNoise<Float>(reporter, "Worley", type, Math::Noise::Worley<Float>(1));
+        BenchmarkNoise<Float>(reporter, "Layer<Perlin>", type, Math::Noise::Layer<Float, Math::Noise::Perlin>(1));
+        BenchmarkNoise<Float>(reporter, "Layer<Simplex>", type, Math::Noise::Layer<Float, Math::Noise::Simplex>(1));
+    }
+}
+
+// Note(3011): Prints tables by default, "csv" switches to CSV output.
+int main(int argc, char** argv)
+{
+    std::string_view format = (argc > 1) ? std::string_view(argv[1]) : std::string_view();
+    Reporter reporter(format == "csv");
+
+    BenchmarkType<f32>(reporter, "f32");
+    BenchmarkType<f64>(reporter, "f64");
+}
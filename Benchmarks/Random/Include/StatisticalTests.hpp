@@ -0,0 +1,181 @@
+#ifndef MATHLIB_BENCHMARKS_RANDOM_STATISTICAL_TESTS_HPP
+#define MATHLIB_BENCHMARKS_RANDOM_STATISTICAL_TESTS_HPP
+
+#include <Math/Base.hpp>
+#include <Math/Constants.hpp>
+#include <Math/Functions.hpp>
+
+#include <algorithm>
+#include <span>
+#include <string>
+#include <vector>
+
+// Note(3011):
+// A small offline subset of the classic empirical tests for uniform random
+// numbers, following D. Knuth, "The Art of Computer Programming", Vol. 2,
+// Section 3.3.2, and G. Marsaglia's Diehard battery for the birthday spacings.
+// Every test consumes 32-bit values from a source and produces a p-value,
+// which should be uniformly distributed on [0, 1] for a good generator.
+// These are smoke tests that catch broken generators and conversions, they
+// are no replacement for TestU01 or PractRand.
+
+namespace RandomBenchmark
+{
+    using namespace Math::Types;
+
+    struct TestResult
+    {
+        std::string Name;
+        f64 Statistic;
+        f64 PValue;
+
+        // Note(3011): Both tails are suspicious, a chi-square statistic that
+        // is too good to be true is as much of a red flag as a large one.
+        [[nodiscard]]
+        bool Passed(f64 threshold = 1.0e-5) const noexcept
+        {
+            return PValue >= threshold && PValue <= 1.0 - threshold;
+        }
+    };
+
+    // Note(3011): Probability that a chi-square variable with the given degrees
+    // of freedom exceeds the statistic.
+    [[nodiscard]]
+    f64 ChiSquarePValue(f64 statistic, f64 degreesOfFreedom);
+
+    // Note(3011): Two sided tail probability of a standard normal variable.
+    [[nodiscard]]
+    f64 NormalPValue(f64 z);
+
+    [[nodiscard]]
+    f64 ChiSquareStatistic(std::span<const u64> observed, std::span<const f64> expected);
+
+    // Note(3011): Equidistribution of the top bits.
+    template <typename Source>
+    [[nodiscard]]
+    TestResult ChiSquareTest(Source&& source, u32 bitCount = 10, u64 count = u64(1) << 22)
+    {
+        u32 binCount = u32(1) << bitCount;
+        std::vector<u64> observed(Math::ToUnderlying(binCount), 0);
+        for (u64 i = 0; i < count; ++i)
+        {
+            u32 value = source();
+            ++observed[Math::ToUnderlying(value >> (32 - bitCount))];
+        }
+
+        std::vector<f64> expected(Math::ToUnderlying(binCount), Math::Cast<f64>(count) / Math::Cast<f64>(binCount));
+        f64 statistic = ChiSquareStatistic(observed, expected);
+        return { "Chi-square", statistic, ChiSquarePValue(statistic, Math::Cast<f64>(binCount - 1)) };
+    }
+
+    // Note(3011): Lengths of the runs of values outside of [0, 1/2) between two
+    // values inside of it, these are geometrically distributed.
+    template <typename Source>
+    [[nodiscard]]
+    TestResult GapTest(Source&& source, u32 maxGap = 16, u64 gapCount = u64(1) << 20)
+    {
+        std::vector<u64> observed(Math::ToUnderlying(maxGap) + 1, 0);
+        for (u64 i = 0; i < gapCount; ++i)
+        {
+            u32 gap = 0;
+            while (source() >= (u32(1) << 31))
+            {
+                ++gap;
+            }
+            ++observed[Math::ToUnderlying(Math::Min(gap, maxGap))];
+        }
+
+        std::vector<f64> expected(observed.size());
+        f64 probability = 0.5;
+        for (u32 gap = 0; gap < maxGap; ++gap)
+        {
+            expected[Math::ToUnderlying(gap)] = Math::Cast<f64>(gapCount) * probability;
+            probability *= 0.5;
+        }
+        // Note(3011): The last category collects all the longer gaps.
+        expected[Math::ToUnderlying(maxGap)] = Math::Cast<f64>(gapCount) * probability * 2.0;
+
+        f64 statistic = ChiSquareStatistic(observed, expected);
+        return { "Gap", statistic, ChiSquarePValue(statistic, Math::Cast<f64>(maxGap)) };
+    }
+
+    // Note(3011): Birthdays are full 32-bit values, with m = 4096 of them the
+    // number of repeated spacings is close to Poisson with lambda = m^3 / 4n = 4.
+    template <typename Source>
+    [[nodiscard]]
+    TestResult BirthdaySpacingTest(Source&& source, u32 trialCount = 2000)
+    {
+        constexpr std::size_t birthdayCount = 4096;
+        constexpr u32 maxRepeats = 10;
+        constexpr f64 lambda = 4.0;
+
+        std::vector<u64> observed(Math::ToUnderlying(maxRepeats) + 1, 0);
+        std::vector<u32> birthdays(birthdayCount);
+        std::vector<u32> spacings(birthdayCount);
+        for (u32 trial = 0; trial < trialCount; ++trial)
+        {
+            for (u32& birthday : birthdays)
+            {
+                birthday = source();
+            }
+            std::sort(birthdays.begin(), birthdays.end());
+
+            spacings[0] = birthdays[0];
+            for (std::size_t i = 1; i < birthdayCount; ++i)
+            {
+                spacings[i] = birthdays[i] - birthdays[i - 1];
+            }
+            std::sort(spacings.begin(), spacings.end());
+
+            u32 repeats = 0;
+            for (std::size_t i = 1; i < birthdayCount; ++i)
+            {
+                repeats += (spacings[i] == spacings[i - 1]) ? 1 : 0;
+            }
+            ++observed[Math::ToUnderlying(Math::Min(repeats, maxRepeats))];
+        }
+
+        std::vector<f64> expected(observed.size());
+        f64 probability = Math::Exp(-lambda);
+        f64 remaining = 1.0;
+        for (u32 k = 0; k < maxRepeats; ++k)
+        {
+            expected[Math::ToUnderlying(k)] = Math::Cast<f64>(trialCount) * probability;
+            remaining -= probability;
+            probability *= lambda / Math::Cast<f64>(k + 1);
+        }
+        expected[Math::ToUnderlying(maxRepeats)] = Math::Cast<f64>(trialCount) * remaining;
+
+        f64 statistic = ChiSquareStatistic(observed, expected);
+        return { "Birthday spacing", statistic, ChiSquarePValue(statistic, Math::Cast<f64>(maxRepeats)) };
+    }
+
+    // Note(3011): Knuth's circular serial correlation coefficient of consecutive
+    // values, approximately normal with mean -1/(n - 1) and variance 1/n.
+    template <typename Source>
+    [[nodiscard]]
+    TestResult SerialCorrelationTest(Source&& source, u64 count = u64(1) << 22)
+    {
+        f64 first = Math::Cast<f64>(source()) * 0x1.0p-32;
+        f64 previous = first;
+        f64 sum = first;
+        f64 sumSquares = first * first;
+        f64 sumProducts = 0.0;
+        for (u64 i = 1; i < count; ++i)
+        {
+            f64 value = Math::Cast<f64>(source()) * 0x1.0p-32;
+            sum += value;
+            sumSquares += value * value;
+            sumProducts += previous * value;
+            previous = value;
+        }
+        sumProducts += previous * first;
+
+        f64 n = Math::Cast<f64>(count);
+        f64 correlation = (n * sumProducts - sum * sum) / (n * sumSquares - sum * sum);
+        f64 z = (correlation + 1.0 / (n - 1.0)) * Math::Sqrt(n);
+        return { "Serial correlation", correlation, NormalPValue(z) };
+    }
+}
+
+#endif //MATHLIB_BENCHMARKS_RANDOM_STATISTICAL_TESTS_HPP
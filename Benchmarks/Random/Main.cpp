@@ -0,0 +1,267 @@
+#include "StatisticalTests.hpp"
+
+#include <Benchmark.hpp>
+#include <Math/Random.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Math::Types;
+
+namespace
+{
+    constexpr u64 ItemCount = u64(1) << 24;
+    constexpr std::size_t BatchSize = 4096;
+
+    template <typename RNG>
+    void BenchmarkGenerator(std::string_view name)
+    {
+        using ValueType = typename RNG::ValueType;
+
+        RNG scalarRng(1);
+        Benchmark::PrintRow(std::string(name) + " (scalar)", Benchmark::Measure(ItemCount, [&]()
+        {
+            ValueType accumulator = 0;
+            for (u64 i = 0; i < ItemCount; ++i)
+            {
+                accumulator ^= scalarRng();
+            }
+            Benchmark::DoNotOptimize(accumulator);
+        }));
+
+        RNG batchRng(1);
+        std::vector<ValueType> buffer(BatchSize);
+        Benchmark::PrintRow(std::string(name) + " (batch)", Benchmark::Measure(ItemCount, [&]()
+        {
+            for (u64 i = 0; i < ItemCount / BatchSize; ++i)
+            {
+                for (ValueType& value : buffer)
+                {
+                    value = batchRng();
+                }
+                Benchmark::DoNotOptimize(buffer.data());
+            }
+        }));
+    }
+
+    template <typename Dist>
+    void BenchmarkDistribution(std::string_view name, const Dist& dist)
+    {
+        using ValueType = typename Dist::ValueType;
+
+        Math::Random64 scalarRng(1);
+        Benchmark::PrintRow(std::string(name) + " (scalar)", Benchmark::Measure(ItemCount, [&]()
+        {
+            ValueType accumulator = 0;
+            for (u64 i = 0; i < ItemCount; ++i)
+            {
+                accumulator += dist(scalarRng);
+            }
+            Benchmark::DoNotOptimize(accumulator);
+        }));
+
+        Math::Random64 batchRng(1);
+        std::vector<ValueType> buffer(BatchSize);
+        Benchmark::PrintRow(std::string(name) + " (batch)", Benchmark::Measure(ItemCount, [&]()
+        {
+            for (u64 i = 0; i < ItemCount / BatchSize; ++i)
+            {
+                Math::Generate(std::span<ValueType>(buffer), dist, batchRng);
+                Benchmark::DoNotOptimize(buffer.data());
+            }
+        }));
+    }
+
+    class QualityReport
+    {
+    public:
+        QualityReport()
+        {
+            std::cout << '\n' << "Statistical tests" << '\n'
+                      << std::left << std::setw(32) << "Source" << std::setw(20) << "Test"
+                      << std::right << std::setw(16) << "Statistic" << std::setw(12) << "p-value" << "  Result" << '\n'
+                      << std::string(88, '-') << '\n';
+        }
+
+        void Add(std::string_view source, const RandomBenchmark::TestResult& result)
+        {
+            bool passed = result.Passed();
+            mFailures += passed ? 0 : 1;
+            std::cout << std::left << std::setw(32) << source << std::setw(20) << result.Name
+                      << std::right << std::setprecision(4) << std::setw(16) << Math::ToUnderlying(result.Statistic)
+                      << std::setprecision(6) << std::setw(12) << Math::ToUnderlying(result.PValue)
+                      << (passed ? "  PASS" : "  FAIL") << '\n';
+        }
+
+        // Note(3011): Runs the whole battery, which needs all 32 bits to be random.
+        template <typename Source>
+        void AddBattery(std::string_view name, Source&& source)
+        {
+            AddUniformBattery(name, source);
+            Add(name, RandomBenchmark::BirthdaySpacingTest(source));
+        }
+
+        // Note(3011): Skips the birthday spacings, which look at the low bits
+        // too, for sources with fewer than 32 random bits (e.g. f32 values).
+        template <typename Source>
+        void AddUniformBattery(std::string_view name, Source&& source)
+        {
+            Add(name, RandomBenchmark::ChiSquareTest(source));
+            Add(name, RandomBenchmark::GapTest(source));
+            Add(name, RandomBenchmark::SerialCorrelationTest(source));
+        }
+
+        [[nodiscard]]
+        u32 Failures() const noexcept
+        {
+            return mFailures;
+        }
+    private:
+        u32 mFailures = 0;
+    };
+
+    // Note(3011): Goodness of fit of a discrete distribution to its probability
+    // mass function, the last category collects the rest of the support.
+    template <typename Dist>
+    RandomBenchmark::TestResult DiscreteFitTest(const Dist& dist, std::span<const f64> pmf, u64 count = u64(1) << 22)
+    {
+        Math::Random64 rng(7);
+        std::vector<u64> observed(pmf.size() + 1, 0);
+        for (u64 i = 0; i < count; ++i)
+        {
+            u64 value = Math::Cast<u64>(dist(rng));
+            ++observed[Math::ToUnderlying(Math::Min(value, Math::Cast<u64>(pmf.size())))];
+        }
+
+        std::vector<f64> expected(observed.size());
+        f64 remaining = 1.0;
+        for (std::size_t i = 0; i < pmf.size(); ++i)
+        {
+            expected[i] = pmf[i] * Math::Cast<f64>(count);
+            remaining -= pmf[i];
+        }
+        expected.back() = Math::Max(remaining, f64(0.0)) * Math::Cast<f64>(count);
+
+        // Note(3011): Drops the tail category if it is too small for the
+        // chi-square approximation to hold.
+        if (expected.back() < 5.0)
+        {
+            observed[observed.size() - 2] += observed.back();
+            expected[expected.size() - 2] += expected.back();
+            observed.pop_back();
+            expected.pop_back();
+        }
+
+        f64 statistic = RandomBenchmark::ChiSquareStatistic(observed, expected);
+        return { "Chi-square fit", statistic, RandomBenchmark::ChiSquarePValue(statistic, Math::Cast<f64>(observed.size() - 1)) };
+    }
+
+    std::vector<f64> PoissonProbabilities(f64 mean, u32 count)
+    {
+        std::vector<f64> pmf(Math::ToUnderlying(count));
+        f64 probability = Math::Exp(-mean);
+        for (u32 k = 0; k < count; ++k)
+        {
+            pmf[Math::ToUnderlying(k)] = probability;
+            probability *= mean / Math::Cast<f64>(k + 1);
+        }
+        return pmf;
+    }
+
+    void RunSpeed()
+    {
+        Benchmark::PrintHeader("Generators", "numbers");
+        BenchmarkGenerator<Math::Implementation::Splitmix32>("Splitmix32");
+        BenchmarkGenerator<Math::Implementation::Splitmix64>("Splitmix64");
+        BenchmarkGenerator<Math::Xoshiro128StarStar>("Xoshiro128StarStar");
+        BenchmarkGenerator<Math::Xoshiro256StarStar>("Xoshiro256StarStar");
+
+        std::vector<f64> weights;
+        for (u32 i = 0; i < 100; ++i)
+        {
+            weights.push_back(Math::Cast<f64>(i + 1));
+        }
+
+        Benchmark::PrintHeader("Distributions (Xoshiro256StarStar)", "numbers");
+        BenchmarkDistribution("UniformUnit<f32>", Math::UniformUnitDistribution<f32>());
+        BenchmarkDistribution("UniformUnit<f64>", Math::UniformUnitDistribution<f64>());
+        BenchmarkDistribution("Uniform<f64>[-1, 1]", Math::UniformDistribution<f64>(-1.0, 1.0));
+        BenchmarkDistribution("Uniform<u32>[0, 999]", Math::UniformDistribution<u32>(0, 999));
+        BenchmarkDistribution("Uniform<u64>", Math::UniformDistribution<u64>());
+        BenchmarkDistribution("Poisson<u32>(4)", Math::PoissonDistribution<u32>(4.0f));
+        BenchmarkDistribution("Poisson<u32>(9.9)", Math::PoissonDistribution<u32>(9.9f));
+        BenchmarkDistribution("Poisson<u64>(4)", Math::PoissonDistribution<u64>(4.0));
+        BenchmarkDistribution("Poisson<u32>(100)", Math::PoissonDistribution<u32>(100.0f));
+        BenchmarkDistribution("AliasTable<f64>(100)", Math::AliasTable<f64>(weights));
+    }
+
+    u32 RunQuality()
+    {
+        QualityReport report;
+
+        Math::Implementation::Splitmix32 splitmix32(3);
+        report.AddBattery("Splitmix32", [&]() { return splitmix32(); });
+
+        Math::Implementation::Splitmix64 splitmix64(3);
+        report.AddBattery("Splitmix64 (high)", [&]() { return Math::Cast<u32>(splitmix64() >> 32); });
+        report.AddBattery("Splitmix64 (low)", [&]() { return Math::Cast<u32>(splitmix64()); });
+
+        Math::Xoshiro128StarStar xoshiro128(3);
+        report.AddBattery("Xoshiro128StarStar", [&]() { return xoshiro128(); });
+
+        Math::Xoshiro256StarStar xoshiro256(3);
+        report.AddBattery("Xoshiro256StarStar (high)", [&]() { return Math::Cast<u32>(xoshiro256() >> 32); });
+        report.AddBattery("Xoshiro256StarStar (low)", [&]() { return Math::Cast<u32>(xoshiro256()); });
+
+        Math::Random64 rng(3);
+        Math::UniformUnitDistribution<f64> unit64;
+        report.AddBattery("UniformUnit<f64>", [&]() { return Math::Cast<u32>(unit64(rng) * 0x1.0p32); });
+        Math::UniformUnitDistribution<f32> unit32;
+        report.AddUniformBattery("UniformUnit<f32>", [&]() { return Math::Cast<u32>(Math::Cast<f64>(unit32(rng)) * 0x1.0p32); });
+
+        std::vector<f64> smallPoisson = PoissonProbabilities(4.0, 16);
+        report.Add("Poisson<u32>(4)", DiscreteFitTest(Math::PoissonDistribution<u32>(4.0f), smallPoisson));
+        std::vector<f64> largePoisson = PoissonProbabilities(50.0, 90);
+        report.Add("Poisson<u32>(50)", DiscreteFitTest(Math::PoissonDistribution<u32>(50.0f), largePoisson));
+
+        std::vector<f64> weights;
+        f64 totalWeight = 0.0;
+        for (u32 i = 0; i < 64; ++i)
+        {
+            weights.push_back(Math::Cast<f64>(i % 7 + 1));
+            totalWeight += weights.back();
+        }
+        std::vector<f64> aliasPmf;
+        for (f64 weight : weights)
+        {
+            aliasPmf.push_back(weight / totalWeight);
+        }
+        report.Add("AliasTable<f64>(64)", DiscreteFitTest(Math::AliasTable<f64>(weights), aliasPmf));
+
+        return report.Failures();
+    }
+}
+
+// Note(3011): Runs both parts by default, "speed" or "quality" selects one.
+int main(int argc, char** argv)
+{
+    std::string_view mode = (argc > 1) ? std::string_view(argv[1]) : std::string_view();
+
+    if (mode.empty() || mode == "speed")
+    {
+        RunSpeed();
+    }
+
+    u32 failures = 0;
+    if (mode.empty() || mode == "quality")
+    {
+        failures = RunQuality();
+        std::cout << '\n' << Math::ToUnderlying(failures) << " test(s) failed" << std::endl;
+    }
+
+    return (failures == 0) ? 0 : 1;
+}
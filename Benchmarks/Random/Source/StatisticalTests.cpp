@@ -0,0 +1,89 @@
+#include "StatisticalTests.hpp"
+
+#include <cmath>
+
+namespace RandomBenchmark
+{
+    namespace
+    {
+        // Note(3011): Regularized incomplete gamma functions, the series for
+        // P(a, x) converges quickly below a + 1, the continued fraction (in the
+        // modified Lentz form) for Q(a, x) above it.
+
+        f64 GammaSeries(f64 a, f64 x, f64 logGammaA)
+        {
+            f64 term = 1.0 / a;
+            f64 sum = term;
+            for (u32 n = 1; n < 1000; ++n)
+            {
+                term *= x / (a + Math::Cast<f64>(n));
+                sum += term;
+                if (Math::Abs(term) < Math::Abs(sum) * 1.0e-15)
+                {
+                    break;
+                }
+            }
+            return sum * Math::Exp(-x + a * Math::Log(x) - logGammaA);
+        }
+
+        f64 GammaContinuedFraction(f64 a, f64 x, f64 logGammaA)
+        {
+            constexpr f64 tiny = 1.0e-300;
+
+            f64 b = x + 1.0 - a;
+            f64 c = 1.0 / tiny;
+            f64 d = 1.0 / b;
+            f64 h = d;
+            for (u32 i = 1; i < 1000; ++i)
+            {
+                f64 an = -Math::Cast<f64>(i) * (Math::Cast<f64>(i) - a);
+                b += 2.0;
+                d = an * d + b;
+                d = (Math::Abs(d) < tiny) ? tiny : d;
+                c = b + an / c;
+                c = (Math::Abs(c) < tiny) ? tiny : c;
+                d = 1.0 / d;
+                f64 delta = d * c;
+                h *= delta;
+                if (Math::Abs(delta - 1.0) < 1.0e-15)
+                {
+                    break;
+                }
+            }
+            return Math::Exp(-x + a * Math::Log(x) - logGammaA) * h;
+        }
+    }
+
+    f64 ChiSquarePValue(f64 statistic, f64 degreesOfFreedom)
+    {
+        f64 a = degreesOfFreedom * 0.5;
+        f64 x = statistic * 0.5;
+        if (x <= 0.0)
+        {
+            return 1.0;
+        }
+
+        f64 logGammaA = std::lgamma(Math::ToUnderlying(a));
+        if (x < a + 1.0)
+        {
+            return 1.0 - GammaSeries(a, x, logGammaA);
+        }
+        return GammaContinuedFraction(a, x, logGammaA);
+    }
+
+    f64 NormalPValue(f64 z)
+    {
+        return std::erfc(Math::ToUnderlying(Math::Abs(z) * Math::Constant::InvSqrt2<f64>));
+    }
+
+    f64 ChiSquareStatistic(std::span<const u64> observed, std::span<const f64> expected)
+    {
+        f64 statistic = 0.0;
+        for (std::size_t i = 0; i < observed.size(); ++i)
+        {
+            f64 difference = Math::Cast<f64>(observed[i]) - expected[i];
+            statistic += difference * difference / expected[i];
+        }
+        return statistic;
+    }
+}
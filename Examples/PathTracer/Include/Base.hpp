@@ -8,6 +8,8 @@
 #include <Math/Transform.hpp>
 #include <Math/Geometry.hpp>
 #include <Math/Random.hpp>
+#include <Math/Sampling.hpp>
+#include <Math/Sequences.hpp>
 
 #include <vector>
 
@@ -30,6 +32,12 @@ namespace PathTracer
     using Plane = Math::Geometry::Plane<f32>;
     using Triangle = Math::Geometry::Triangle<f32>;
     using Sphere = Math::Geometry::Sphere<f32>;
+    using Mesh = Math::Geometry::TriangleMesh<f32>;
+
+    // Note(3011): Camera rays through neighbouring pixels are traced together,
+    // 8 lanes fill an AVX register.
+    inline constexpr SizeType PacketWidth = 8;
+    using RayPacket = Math::Geometry::RayPacket<f32, PacketWidth>;
 }
 
 #endif //MATHLIB_EXAMPLES_PATHTRACER_BASE_HPP
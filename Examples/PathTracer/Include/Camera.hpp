@@ -11,6 +11,7 @@ namespace PathTracer
         Camera(const Point3f& position, const Vector3f& direction, const Vector2sz& resolution, f32 fov);
 
         Ray GenerateRay(const Vector2f& screenSample) const;
+        RayPacket GenerateRays(const Math::Vector2fPacket<PacketWidth>& screenSamples) const;
     private:
         Point3f   mPosition;
         Matrix4f  mScreenToWorld;
@@ -36,11 +36,15 @@ namespace PathTracer
                 Vector3f Normal;
                 SizeType MaterialIndex;
             };
+            using IntersectionPacket = Math::Array<Intersection, PacketWidth>;
 
+            // Note(3011): The packet intersection defaults to the rays one by
+            // one, the objects with packet tests override it.
             struct GenericObject
             {
             public:
                 virtual Intersection Intersect(const Ray& ray, const Interval& interval) const noexcept = 0;
+                virtual IntersectionPacket Intersect(const RayPacket& rays, const Interval& interval) const noexcept;
                 virtual bool HasIntersection(const Ray& ray, const Interval& interval) const noexcept = 0;
                 virtual ~GenericObject() noexcept {}
             };
@@ -64,6 +68,29 @@ namespace PathTracer
                     };
                 }
 
+                IntersectionPacket Intersect(const RayPacket& rays, const Interval& interval) const noexcept override
+                {
+                    using PacketType = Math::Geometry::IntersectionPacket<f32, PacketWidth>;
+                    if constexpr (requires { { Math::Geometry::NearestIntersection(rays, interval, mObject) } -> Math::Concept::IsSame<PacketType>; })
+                    {
+                        PacketType nearest = Math::Geometry::NearestIntersection(rays, interval, mObject);
+                        IntersectionPacket result;
+                        for (SizeType lane = 0; lane < PacketWidth; ++lane)
+                        {
+                            result[lane] = {
+                                .Distance = nearest.Distance[lane],
+                                .Normal = mObject.SurfaceNormal(rays.Get(lane).Project(nearest.Distance[lane])),
+                                .MaterialIndex = 0,
+                            };
+                        }
+                        return result;
+                    }
+                    else
+                    {
+                        return GenericObject::Intersect(rays, interval);
+                    }
+                }
+
                 bool HasIntersection(const Ray& ray, const Interval& interval) const noexcept override
                 {
                     return Math::Geometry::NearestIntersection(ray, interval, mObject).IsValid();
@@ -72,12 +99,34 @@ namespace PathTracer
                 ObjectType mObject;
             };
 
+            // Note(3011): Meshes get a hierarchy over their triangles, it
+            // refers to the mesh, so the container keeps its own copy and
+            // cannot be copied or moved (the hierarchy would keep pointing
+            // at the old mesh).
+            struct MeshContainer : public GenericObject
+            {
+            public:
+                MeshContainer(const Mesh& mesh);
+                MeshContainer(const MeshContainer&) = delete;
+                MeshContainer& operator= (const MeshContainer&) = delete;
+
+                Intersection Intersect(const Ray& ray, const Interval& interval) const noexcept override;
+                IntersectionPacket Intersect(const RayPacket& rays, const Interval& interval) const noexcept override;
+                bool HasIntersection(const Ray& ray, const Interval& interval) const noexcept override;
+            private:
+                Mesh mMesh;
+                Math::Geometry::BVH<Math::Geometry::MeshTriangle<f32>> mHierarchy;
+            };
+
             template <typename ObjectType>
             Object(const ObjectType& object, SizeType materialIndex)
                 : mObject(std::make_unique<ObjectContainer<ObjectType>>(object)), mMaterialIndex(materialIndex)
             {}
 
+            Object(const Mesh& mesh, SizeType materialIndex);
+
             Intersection Intersect(const Ray& ray, const Interval& interval) const noexcept;
+            IntersectionPacket Intersect(const RayPacket& rays, const Interval& interval) const noexcept;
             bool HasIntersection(const Ray& ray, const Interval& interval) const noexcept;
         private:
             // Note(3011): It might make sense to replace this
@@ -94,11 +143,14 @@ namespace PathTracer
         Scene(const Vector2sz& resolution);
 
         Intersection Intersect(const Ray& ray, const Interval& interval) const;
+        Math::Array<Intersection, PacketWidth> Intersect(const RayPacket& rays, const Interval& interval) const;
         bool HasIntersection(const Ray& ray, const Interval& interval) const;
 
         const Camera& GetCamera() const;
         std::span<const Light> GetLights() const;
     private:
+        Intersection Resolve(const Object::Intersection& intersection) const;
+
         Camera mCamera;
         std::vector<Object> mObjects;
         std::vector<Light> mLights;
@@ -26,10 +26,16 @@ int main(int argc, char **argv)
     PathTracer::Framebuffer fb(resolution.x, resolution.y);
     std::mutex fbMutex;
 
+    // Note(3011): The pixel jitter comes from a progressive sequence indexed by
+    // the global sample index, so the threads together render consecutive
+    // prefixes of it regardless of how the samples are split between them.
+    Math::PMJ02Sampler pixelSampler(15);
+
     std::vector<std::thread> threads;
     SizeType hwThreads = std::thread::hardware_concurrency();
     SizeType totalSamples = 4;
     SizeType samplesRemainder = totalSamples % hwThreads;
+    SizeType firstSample = 0;
     for (SizeType i = 0; i < hwThreads; ++i)
     {
         SizeType samples = totalSamples / hwThreads + ((samplesRemainder > 0) ? 1 : 0);
@@ -42,96 +48,111 @@ int main(int argc, char **argv)
             continue;
         }
         PathTracer::RNG rng = commonRng.Jump();
-        threads.push_back(std::thread([samples, rng, resolution, &scene, &fb, &fbMutex]() mutable {
+        threads.push_back(std::thread([samples, firstSample, rng, resolution, pixelSampler, &scene, &fb, &fbMutex]() mutable {
             PathTracer::Uniform dist;
             PathTracer::Framebuffer localFramebuffer(fb.Size());
             for (SizeType sample = 0; sample < samples; ++sample)
             {
                 for (SizeType y = 0; y < resolution.y; ++y)
                 {
-                    for (SizeType x = 0; x < resolution.x; ++x)
+                    // Note(3011): The camera rays of PacketWidth neighbouring
+                    // pixels are traced together, the bounces one by one.
+                    for (SizeType x = 0; x < resolution.x; x += PathTracer::PacketWidth)
                     {
-                        f32 xf = Math::Cast<f32>(x) + dist(rng);
-                        f32 yf = Math::Cast<f32>(y) + dist(rng);
-                        PathTracer::Ray ray = scene.GetCamera().GenerateRay({xf, yf});
+                        Math::Vector2fPacket<PathTracer::PacketWidth> screenSamples;
+                        for (SizeType lane = 0; lane < PathTracer::PacketWidth; ++lane)
+                        {
+                            u32 pixel = Math::Cast<u32>(y * resolution.x + Math::Min(x + lane, resolution.x - 1));
+                            PathTracer::Vector2f jitter = pixelSampler.Sample2D<f32>(Math::Cast<u32>(firstSample + sample), pixel);
+                            f32 xf = Math::Cast<f32>(x + lane) + jitter.x;
+                            f32 yf = Math::Cast<f32>(y) + jitter.y;
+                            screenSamples.Set(lane, {xf, yf});
+                        }
+                        PathTracer::RayPacket rays = scene.GetCamera().GenerateRays(screenSamples);
 
                         using Intersection = PathTracer::Scene::Intersection;
-                        Intersection intersection = scene.Intersect(ray, {});
+                        Math::Array<Intersection, PathTracer::PacketWidth> primary = scene.Intersect(rays, {});
 
-                        PathTracer::Vector3f accumulator(0.0f);
-                        PathTracer::Vector3f throughput(1.0f);
-                        SizeType bounce = 0;
-                        while (true)
+                        for (SizeType lane = 0; lane < PathTracer::PacketWidth && x + lane < resolution.x; ++lane)
                         {
-                            if (!intersection.IsValid())
-                            {
-                                // HDRI handling goes here.
-                                break;
-                            }
-
-                            PathTracer::Point3f intersectedPoint = ray.Project(intersection.Distance);
-                            PathTracer::Transform3f intersectedBase = Math::OrthonormalBaseFromZ(intersection.Normal);
-                            PathTracer::Vector3f incomingDirection = intersectedBase * -ray.Direction;
+                            PathTracer::Ray ray = rays.Get(lane);
+                            Intersection intersection = primary[lane];
 
-                            if (intersection.Light)
+                            PathTracer::Vector3f accumulator(0.0f);
+                            PathTracer::Vector3f throughput(1.0f);
+                            SizeType bounce = 0;
+                            while (true)
                             {
-                                PathTracer::Vector3f intensity = intersection.Light->Sample(rng, ray.Origin).Intensity;
-                                if (bounce == 0 && intensity.Max() > 0.0f)
+                                if (!intersection.IsValid())
                                 {
-                                    accumulator += intensity;
+                                    // HDRI handling goes here.
+                                    break;
                                 }
-                                break;
-                            }
 
-                            PathTracer::Vector3f mis(0.0f);
-                            {   // Explicit lightsource sampling
-                                for (const auto& light : scene.GetLights())
+                                PathTracer::Point3f intersectedPoint = ray.Project(intersection.Distance);
+                                PathTracer::Transform3f intersectedBase = Math::OrthonormalBaseFromZ(intersection.Normal);
+                                PathTracer::Vector3f incomingDirection = intersectedBase * -ray.Direction;
+
+                                if (intersection.Light)
                                 {
-                                    PathTracer::LightSample sample = light.Sample(rng, intersectedPoint);
-                                    PathTracer::Ray lightRay(intersectedPoint, sample.OutgoingDirection);
-                                    PathTracer::Vector3f outgoingDirection = intersectedBase * sample.OutgoingDirection;
-                                    f32 cosTheta = Math::Dot(intersection.Normal, lightRay.Direction);
-                                    f32 brdfPdf = Math::Equal(sample.PDF, 1.0f) ? 0.0f : intersection.Material->PDF(incomingDirection, outgoingDirection);
-                                    if (cosTheta > 0.0f && sample.Intensity.Max() > 0.0f && !scene.HasIntersection(lightRay, {Math::Constant::GeometryEpsilon<f32>, sample.Distance - 2.0f * Math::Constant::GeometryEpsilon<f32>}))
+                                    PathTracer::Vector3f intensity = intersection.Light->Sample(rng, ray.Origin).Intensity;
+                                    if (bounce == 0 && intensity.Max() > 0.0f)
                                     {
-                                        mis += (intersection.Material->BRDF(incomingDirection, outgoingDirection) * sample.Intensity * cosTheta) / (sample.PDF + brdfPdf);
+                                        accumulator += intensity;
                                     }
+                                    break;
                                 }
-                            }
-                            {   // BRDF sampling
-                                PathTracer::MaterialSample sample = intersection.Material->Sample(rng, incomingDirection);
-                                PathTracer::Vector3f outgoingDirection = sample.OutgoingDirection * intersectedBase;
-                                f32 cosTheta = Math::Dot(intersection.Normal, outgoingDirection);
 
-                                ray = PathTracer::Ray(intersectedPoint, outgoingDirection);
-                                intersection = scene.Intersect(ray, {Math::Constant::GeometryEpsilon<f32>});
+                                PathTracer::Vector3f mis(0.0f);
+                                {   // Explicit lightsource sampling
+                                    for (const auto& light : scene.GetLights())
+                                    {
+                                        PathTracer::LightSample sample = light.Sample(rng, intersectedPoint);
+                                        PathTracer::Ray lightRay(intersectedPoint, sample.OutgoingDirection);
+                                        PathTracer::Vector3f outgoingDirection = intersectedBase * sample.OutgoingDirection;
+                                        f32 cosTheta = Math::Dot(intersection.Normal, lightRay.Direction);
+                                        f32 brdfPdf = Math::Equal(sample.PDF, 1.0f) ? 0.0f : intersection.Material->PDF(incomingDirection, outgoingDirection);
+                                        if (cosTheta > 0.0f && sample.Intensity.Max() > 0.0f && !scene.HasIntersection(lightRay, {Math::Constant::GeometryEpsilon<f32>, sample.Distance - 2.0f * Math::Constant::GeometryEpsilon<f32>}))
+                                        {
+                                            mis += (intersection.Material->BRDF(incomingDirection, outgoingDirection) * sample.Intensity * cosTheta) / (sample.PDF + brdfPdf);
+                                        }
+                                    }
+                                }
+                                {   // BRDF sampling
+                                    PathTracer::MaterialSample sample = intersection.Material->Sample(rng, incomingDirection);
+                                    PathTracer::Vector3f outgoingDirection = sample.OutgoingDirection * intersectedBase;
+                                    f32 cosTheta = Math::Dot(intersection.Normal, outgoingDirection);
 
-                                if (intersection.Light && cosTheta > 0.0f && sample.Intensity.Max() > 0.0f)
-                                {
-                                    PathTracer::Point3f lightPoint = ray.Project(intersection.Distance);
-                                    mis += sample.Intensity * intersection.Light->Evaluate(intersectedPoint, lightPoint) * cosTheta / (sample.PDF + intersection.Light->PDF(intersectedPoint, lightPoint));
+                                    ray = PathTracer::Ray(intersectedPoint, outgoingDirection);
+                                    intersection = scene.Intersect(ray, {Math::Constant::GeometryEpsilon<f32>});
+
+                                    if (intersection.Light && cosTheta > 0.0f && sample.Intensity.Max() > 0.0f)
+                                    {
+                                        PathTracer::Point3f lightPoint = ray.Project(intersection.Distance);
+                                        mis += sample.Intensity * intersection.Light->Evaluate(intersectedPoint, lightPoint) * cosTheta / (sample.PDF + intersection.Light->PDF(intersectedPoint, lightPoint));
+                                    }
+
+                                    accumulator += throughput * mis;
+                                    throughput *= sample.Intensity * cosTheta / sample.PDF;
                                 }
 
-                                accumulator += throughput * mis;
-                                throughput *= sample.Intensity * cosTheta / sample.PDF;
-                            }
 
+                                // Russian roulette
+                                f32 survive = Math::Min(throughput.Max(), f32(1.0f));
+                                if (dist(rng) < survive)
+                                {
+                                    throughput /= survive;
+                                }
+                                else
+                                {
+                                    break;
+                                }
 
-                            // Russian roulette
-                            f32 survive = Math::Min(throughput.Max(), f32(1.0f));
-                            if (dist(rng) < survive)
-                            {
-                                throughput /= survive;
-                            }
-                            else
-                            {
-                                break;
+                                ++bounce;
                             }
 
-                            ++bounce;
+                            localFramebuffer(x + lane, y) += accumulator;
                         }
-
-                        localFramebuffer(x, y) += accumulator;
                     }
                 }
             }
@@ -141,6 +162,7 @@ int main(int argc, char **argv)
                 fb.Add(localFramebuffer);
             }
         }));
+        firstSample += samples;
     }
 
     // We need to wait for the computation in all threads to finish.
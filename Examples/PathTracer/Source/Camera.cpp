@@ -23,4 +23,14 @@ namespace PathTracer
         Point3f worldScreen = mScreenToWorld * Point3f(screenSample);
         return Ray(mPosition, Math::Normalize(worldScreen - mPosition));
     }
+
+    RayPacket Camera::GenerateRays(const Math::Vector2fPacket<PacketWidth>& screenSamples) const
+    {
+        RayPacket rays;
+        for (SizeType lane = 0; lane < PacketWidth; ++lane)
+        {
+            rays.Set(lane, GenerateRay(screenSamples.Get(lane)));
+        }
+        return rays;
+    }
 }
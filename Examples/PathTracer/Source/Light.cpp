@@ -1,5 +1,4 @@
 #include "Light.hpp"
-#include "Sampling.hpp"
 
 namespace PathTracer
 {
@@ -36,7 +35,10 @@ namespace PathTracer
     LightSample SphericalLight::Sample(RNG& rng, const Point3f& distantPoint) const
     {
         // Note(3011): This is the most naive sampling, it's incredibly ineffective, should be replaced later.
-        Point3f lightPoint = SampleSphere(rng, mSphere);
+        Uniform dist;
+        f32 r1 = dist(rng);
+        f32 r2 = dist(rng);
+        Point3f lightPoint = Math::Sampling::SampleSphere(mSphere, Vector2f(r1, r2));
         Vector3f direction = lightPoint - distantPoint;
         Vector3f normal = mSphere.SurfaceNormal(lightPoint);
         f32 lambert = Math::Dot(normal, Math::Normalize(direction));
@@ -55,6 +57,6 @@ namespace PathTracer
 
     f32 SphericalLight::PDF(const Point3f& distantPoint, const Point3f& lightPoint) const
     {
-        return 1.0f / (4.0f * Math::Constant::Pi<f32> * Math::Squared(mSphere.Radius));
+        return Math::Sampling::PdfSphere(mSphere);
     }
 }
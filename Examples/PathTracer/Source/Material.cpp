@@ -1,5 +1,4 @@
 #include "Material.hpp"
-#include "Sampling.hpp"
 
 namespace PathTracer
 {
@@ -9,7 +8,10 @@ namespace PathTracer
 
     MaterialSample Material::Sample(RNG& rng, const Vector3f& incomingDirection) const
     {
-        Vector3f outgoingDirection = Vector3f(SampleHemisphereCosWeighted(rng));
+        Uniform dist;
+        f32 r1 = dist(rng);
+        f32 r2 = dist(rng);
+        Vector3f outgoingDirection = Math::Sampling::SampleCosineHemisphere(Vector2f(r1, r2));
         return {
             .OutgoingDirection = outgoingDirection,
             .Intensity = BRDF(incomingDirection, outgoingDirection),
@@ -13,6 +13,65 @@ namespace PathTracer
         return Distance == Distance;
     }
 
+    Scene::Object::IntersectionPacket Scene::Object::GenericObject::Intersect(const RayPacket& rays, const Interval& interval) const noexcept
+    {
+        IntersectionPacket result;
+        for (SizeType lane = 0; lane < PacketWidth; ++lane)
+        {
+            result[lane] = Intersect(rays.Get(lane), interval);
+        }
+        return result;
+    }
+
+    Scene::Object::MeshContainer::MeshContainer(const Mesh& mesh)
+        : mMesh(mesh), mHierarchy()
+    {
+        std::vector<Math::Geometry::MeshTriangle<f32>> triangles = Math::Geometry::MeshTriangles(mMesh);
+        mHierarchy.Build(triangles);
+    }
+
+    Scene::Object::Intersection Scene::Object::MeshContainer::Intersect(const Ray& ray, const Interval& interval) const noexcept
+    {
+        Math::Geometry::BVHIntersection<f32> nearest = Math::Geometry::NearestIntersection(ray, interval, mHierarchy);
+        if (!nearest.IsValid())
+        {
+            return { .Distance = nearest.Distance, .Normal = Vector3f(0.0f), .MaterialIndex = 0 };
+        }
+
+        // Note(3011): The hierarchy was built from all the triangles in order,
+        // the primitive index is the triangle index.
+        return {
+            .Distance = nearest.Distance,
+            .Normal = mMesh.Normal(nearest.Primitive, nearest.U, nearest.V),
+            .MaterialIndex = 0,
+        };
+    }
+
+    Scene::Object::IntersectionPacket Scene::Object::MeshContainer::Intersect(const RayPacket& rays, const Interval& interval) const noexcept
+    {
+        Math::Geometry::BVHIntersectionPacket<f32, PacketWidth> nearest = Math::Geometry::NearestIntersection(rays, interval, mHierarchy);
+
+        IntersectionPacket result;
+        for (SizeType lane = 0; lane < PacketWidth; ++lane)
+        {
+            result[lane] = {
+                .Distance = nearest.Distance[lane],
+                .Normal = nearest.IsValid(lane) ? mMesh.Normal(nearest.Primitive[lane], nearest.U[lane], nearest.V[lane]) : Vector3f(0.0f),
+                .MaterialIndex = 0,
+            };
+        }
+        return result;
+    }
+
+    bool Scene::Object::MeshContainer::HasIntersection(const Ray& ray, const Interval& interval) const noexcept
+    {
+        return Math::Geometry::HasIntersection(ray, interval, mHierarchy);
+    }
+
+    Scene::Object::Object(const Mesh& mesh, SizeType materialIndex)
+        : mObject(std::make_unique<MeshContainer>(mesh)), mMaterialIndex(materialIndex)
+    {}
+
     Scene::Object::Intersection Scene::Object::Intersect(const Ray& ray, const Interval& interval) const noexcept
     {
         Object::Intersection intersection = mObject->Intersect(ray, interval);
@@ -23,6 +82,19 @@ namespace PathTracer
         return intersection;
     }
 
+    Scene::Object::IntersectionPacket Scene::Object::Intersect(const RayPacket& rays, const Interval& interval) const noexcept
+    {
+        IntersectionPacket intersections = mObject->Intersect(rays, interval);
+        for (SizeType lane = 0; lane < PacketWidth; ++lane)
+        {
+            if (intersections[lane].IsValid())
+            {
+                intersections[lane].MaterialIndex = mMaterialIndex;
+            }
+        }
+        return intersections;
+    }
+
     bool Scene::Object::HasIntersection(const Ray& ray, const Interval& interval) const noexcept
     {
         return mObject->HasIntersection(ray, interval);
@@ -43,6 +115,17 @@ namespace PathTracer
         mObjects.push_back({Plane({-1.5f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}), 2});
         mObjects.push_back({Triangle({1.5f, 0.0f, 0.0f}, {1.5f, 0.0f, 1.0f}, {1.5f, 2.0f, 1.0f}), 1});
 
+        // Note(3011): A small octahedron, floating above the floor.
+        std::vector<Point3f> octahedronPositions = {
+            { 0.9f, -0.6f, 1.2f}, { 1.2f, -0.3f, 1.2f}, { 0.6f, -0.3f, 1.2f},
+            { 0.9f, -0.3f, 1.5f}, { 0.9f, -0.3f, 0.9f}, { 0.9f, 0.0f, 1.2f},
+        };
+        std::vector<u32> octahedronIndices = {
+            0, 1, 3,  0, 3, 2,  0, 2, 4,  0, 4, 1,
+            5, 3, 1,  5, 2, 3,  5, 4, 2,  5, 1, 4,
+        };
+        mObjects.push_back({Mesh(octahedronPositions, octahedronIndices), 1});
+
         // Point light
         // mLights.push_back({PointLight({0.8f, 0.8f, 0.0f}, Vector3f(15.0f))});
 
@@ -66,12 +149,31 @@ namespace PathTracer
             }
         }
 
-        return {
-            .Distance = nearest.Distance,
-            .Normal = nearest.Normal,
-            .Material = nearest.MaterialIndex != 1000 ? &mMaterials[Math::ToUnderlying(nearest.MaterialIndex)] : nullptr,
-            .Light = nearest.MaterialIndex != 1000 ? nullptr : &mLights[0],
-        };
+        return Resolve(nearest);
+    }
+
+    Math::Array<Scene::Intersection, PacketWidth> Scene::Intersect(const RayPacket& rays, const Interval& interval) const
+    {
+        Object::IntersectionPacket nearest = mObjects[0].Intersect(rays, interval);
+
+        for (SizeType i = 1; i < mObjects.size(); ++i)
+        {
+            Object::IntersectionPacket candidates = mObjects[Math::ToUnderlying(i)].Intersect(rays, interval);
+            for (SizeType lane = 0; lane < PacketWidth; ++lane)
+            {
+                if (!nearest[lane].IsValid() || nearest[lane].Distance > candidates[lane].Distance)
+                {
+                    nearest[lane] = candidates[lane];
+                }
+            }
+        }
+
+        Math::Array<Intersection, PacketWidth> result;
+        for (SizeType lane = 0; lane < PacketWidth; ++lane)
+        {
+            result[lane] = Resolve(nearest[lane]);
+        }
+        return result;
     }
 
     bool Scene::HasIntersection(const Ray& ray, const Interval& interval) const
@@ -87,6 +189,16 @@ namespace PathTracer
         return false;
     }
 
+    Scene::Intersection Scene::Resolve(const Object::Intersection& intersection) const
+    {
+        return {
+            .Distance = intersection.Distance,
+            .Normal = intersection.Normal,
+            .Material = intersection.MaterialIndex != 1000 ? &mMaterials[Math::ToUnderlying(intersection.MaterialIndex)] : nullptr,
+            .Light = intersection.MaterialIndex != 1000 ? nullptr : &mLights[0],
+        };
+    }
+
     const Camera& Scene::GetCamera() const
     {
         return mCamera;
@@ -5,5 +5,6 @@
 #include "Implementation/Base/Types.hpp"
 #include "Implementation/Base/Concepts.hpp"
 #include "Implementation/Base/Array.hpp"
+#include "Implementation/Base/Parallel.hpp"
 
 #endif //MATHLIB_BASE_HPP
@@ -14,6 +14,9 @@ namespace Math::Constant
     template <typename T>
     static constexpr T Tau             = Pi<T> * static_cast<T>(2);
 
+    template <typename T>
+    static constexpr T InvPi           = static_cast<T>(1) / Pi<T>;
+
     template <typename T>
     static constexpr T E               = Implementation::E<T>::Value;
 
@@ -43,6 +46,9 @@ namespace Math::Constant
 
     template <typename T>
     static constexpr T GeometryEpsilon = Implementation::GeometryEpsilon<T>::Value;
+
+    template <typename T>
+    static constexpr T OneMinusEpsilon = Implementation::OneMinusEpsilon<T>::Value;
 }
 
 #endif //MATHLIB_CONSTANTS_HPP
@@ -11,5 +11,6 @@
 #include "Implementation/Functions/Angles.hpp"
 #include "Implementation/Functions/IntUtils.hpp"
 #include "Implementation/Functions/FloatUtils.hpp"
+#include "Implementation/Functions/Hash.hpp"
 
 #endif //MATHLIB_FUNCTIONS_HPP
@@ -3,6 +3,9 @@
 
 #include "Implementation/Geometry/Shapes.hpp"
 #include "Implementation/Geometry/Intersections.hpp"
+#include "Implementation/Geometry/Bounds.hpp"
+#include "Implementation/Geometry/Mesh.hpp"
+#include "Implementation/Geometry/BVH.hpp"
 
 #include "Implementation/Geometry/2D/Shapes.hpp"
 #include "Implementation/Geometry/2D/Contains.hpp"
@@ -105,19 +105,6 @@ namespace Math
             }
         }
 
-        template <Concept::RandomNumberGenerator RNG, template <typename> typename Dist>
-            requires Concept::Distribution<Dist<SizeType>, RNG>
-        constexpr
-        void Shuffle(RNG& rng) noexcept
-        {
-            Dist<SizeType> dist(0, Size - 1);
-            for (SizeType i = 0; i < Size; ++i)
-            {
-                SizeType j = dist(rng);
-                std::swap((*this)[i], (*this)[j]);
-            }
-        }
-
         [[nodiscard]] constexpr
         T Min() const noexcept
         {
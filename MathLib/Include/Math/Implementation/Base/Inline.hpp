@@ -0,0 +1,16 @@
+#ifndef MATHLIB_IMPLEMENTATION_BASE_INLINE_HPP
+#define MATHLIB_IMPLEMENTATION_BASE_INLINE_HPP
+
+// Note(3011): For the small helpers called in the lane loops of the packet
+// kernels. The loops only vectorize if every call in them is inlined, and in
+// large translation units GCC runs out of its inlining budget and keeps some
+// of the helpers as calls, which makes the packets slower than the scalars.
+#if defined(_MSC_VER)
+#   define MATH_FORCE_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#   define MATH_FORCE_INLINE [[gnu::always_inline]] inline
+#else
+#   define MATH_FORCE_INLINE inline
+#endif
+
+#endif //MATHLIB_IMPLEMENTATION_BASE_INLINE_HPP
@@ -0,0 +1,385 @@
+#ifndef MATHLIB_IMPLEMENTATION_BASE_PARALLEL_HPP
+#define MATHLIB_IMPLEMENTATION_BASE_PARALLEL_HPP
+
+#include "Types.hpp"
+#include "Concepts.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Math
+{
+    [[nodiscard]] inline
+    SizeType HardwareThreadCount() noexcept
+    {
+        unsigned count = std::thread::hardware_concurrency();
+        return (count == 0) ? 1 : count;
+    }
+
+    // Note(3011):
+    // Calls func(i) for every i in [0, count), spread over threadCount threads
+    // (the calling thread included). The indices are handed out one at a time
+    // through an atomic counter, so uneven work items balance out, but every
+    // item should be large enough to amortize that. Nothing is run in parallel
+    // if there is only a single item or thread.
+
+    template <Concept::Invocable<SizeType> Func>
+    void ParallelFor(SizeType count, Func&& func, SizeType threadCount = HardwareThreadCount())
+    {
+        threadCount = (threadCount < count) ? threadCount : count;
+        if (threadCount <= 1)
+        {
+            for (SizeType i = 0; i < count; ++i)
+            {
+                func(i);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next = 0;
+        auto worker = [&]()
+        {
+            for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                 i < ToUnderlying(count);
+                 i = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                func(SizeType(i));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(ToUnderlying(threadCount) - 1);
+        for (SizeType i = 1; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Note(3011): The tasks spawned into a group, TaskPool::Wait returns once
+    // all of them have finished.
+    class TaskGroup final
+    {
+    public:
+        [[nodiscard]]
+        TaskGroup() noexcept = default;
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator= (const TaskGroup&) = delete;
+
+        [[nodiscard]]
+        bool Done() const noexcept
+        {
+            return mPending.load(std::memory_order_acquire) == 0;
+        }
+    private:
+        friend class TaskPool;
+
+        std::atomic<std::size_t> mPending = 0;
+    };
+
+    // Note(3011):
+    // A work stealing thread pool for recursive work, threadCount threads in
+    // total, the ones calling Wait included (only threadCount - 1 threads are
+    // started). Every thread has its own deque of tasks, the tasks it spawns
+    // go to the back and it runs them from the back too, depth first, while
+    // idle threads steal from the front of the other deques, where the oldest
+    // tasks are. For divide and conquer work those are the largest ones, so
+    // few steals are needed to spread the work.
+    //
+    // Waiting threads keep running tasks until the group is done, which lets
+    // tasks spawn subtasks and wait for them. The deques are guarded by a
+    // mutex each, which is cheap next to tasks of some microseconds, but too
+    // slow for tiny ones. Tasks must not throw.
+
+    class TaskPool final
+    {
+    public:
+        using Task = std::function<void()>;
+
+        [[nodiscard]] explicit
+        TaskPool(SizeType threadCount = HardwareThreadCount())
+        {
+            std::size_t count = (threadCount == 0) ? 1 : ToUnderlying(threadCount);
+            mQueues.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                mQueues.push_back(std::make_unique<Queue>());
+            }
+
+            mThreads.reserve(count - 1);
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                mThreads.emplace_back([this, i]() { Work(i); });
+            }
+        }
+
+        TaskPool(const TaskPool&) = delete;
+        TaskPool& operator= (const TaskPool&) = delete;
+
+        ~TaskPool()
+        {
+            {
+                std::lock_guard lock(mSleepMutex);
+                mStop = true;
+            }
+            mWake.notify_all();
+
+            for (std::thread& thread : mThreads)
+            {
+                thread.join();
+            }
+        }
+
+        [[nodiscard]]
+        SizeType ThreadCount() const noexcept
+        {
+            return mQueues.size();
+        }
+
+        void Spawn(TaskGroup& group, Task task)
+        {
+            group.mPending.fetch_add(1, std::memory_order_relaxed);
+
+            Queue& queue = *mQueues[CurrentQueue()];
+            {
+                std::lock_guard lock(queue.Mutex);
+                queue.Tasks.push_back({ std::move(task), &group });
+            }
+
+            // Note(3011): Counting under the lock the sleepers wait on, so
+            // none of them misses the new task.
+            {
+                std::lock_guard lock(mSleepMutex);
+                mQueued.fetch_add(1, std::memory_order_relaxed);
+            }
+            mWake.notify_one();
+        }
+
+        void Wait(TaskGroup& group)
+        {
+            std::size_t self = CurrentQueue();
+            while (!group.Done())
+            {
+                if (!TryRun(self))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    private:
+        struct Entry
+        {
+            Task Run;
+            TaskGroup* Group;
+        };
+
+        struct Queue
+        {
+            std::mutex Mutex;
+            std::deque<Entry> Tasks;
+        };
+
+        // Note(3011): The threads of the pool own a queue each, every other
+        // thread shares the first one.
+        [[nodiscard]]
+        std::size_t CurrentQueue() const noexcept
+        {
+            return (sCurrentPool == this) ? sCurrentQueue : 0;
+        }
+
+        bool TryRun(std::size_t self)
+        {
+            Entry entry;
+            bool found = false;
+            {
+                Queue& queue = *mQueues[self];
+                std::lock_guard lock(queue.Mutex);
+                if (!queue.Tasks.empty())
+                {
+                    entry = std::move(queue.Tasks.back());
+                    queue.Tasks.pop_back();
+                    found = true;
+                }
+            }
+
+            for (std::size_t i = 1; i < mQueues.size() && !found; ++i)
+            {
+                Queue& queue = *mQueues[(self + i) % mQueues.size()];
+                std::lock_guard lock(queue.Mutex);
+                if (!queue.Tasks.empty())
+                {
+                    entry = std::move(queue.Tasks.front());
+                    queue.Tasks.pop_front();
+                    found = true;
+                }
+            }
+
+            if (!found)
+            {
+                return false;
+            }
+
+            mQueued.fetch_sub(1, std::memory_order_relaxed);
+            entry.Run();
+            entry.Group->mPending.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        void Work(std::size_t self)
+        {
+            sCurrentPool = this;
+            sCurrentQueue = self;
+
+            while (true)
+            {
+                if (TryRun(self))
+                {
+                    continue;
+                }
+
+                std::unique_lock lock(mSleepMutex);
+                mWake.wait(lock, [this]() { return mStop || mQueued.load(std::memory_order_relaxed) > 0; });
+                if (mStop)
+                {
+                    return;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> mQueues;
+        std::vector<std::thread> mThreads;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWake;
+        std::atomic<std::size_t> mQueued = 0;
+        bool mStop = false;
+
+        static inline thread_local const TaskPool* sCurrentPool = nullptr;
+        static inline thread_local std::size_t sCurrentQueue = 0;
+    };
+
+    // Note(3011):
+    // Sorts keys in ascending order of their low keyBits bits and moves the
+    // values along, least significant digit first, 8 bits per pass. Every
+    // pass counts the digits of a chunk of the keys per thread of the pool,
+    // and then every chunk scatters its keys where the counts put them, so
+    // the sort is stable and the result is the same for any thread count.
+    // Passes over a digit that all the keys share are skipped. Takes a copy of
+    // the keys and the values as scratch space, both spans have to be equally
+    // long.
+
+    inline
+    void RadixSort(std::span<u64> keys, std::span<u32> values, u32 keyBits, TaskPool& pool)
+    {
+        constexpr std::size_t DigitBits = 8;
+        constexpr std::size_t DigitCount = std::size_t(1) << DigitBits;
+        // Note(3011): The fewest keys a chunk gets.
+        constexpr std::size_t Grain = 16384;
+
+        std::size_t count = keys.size();
+        std::size_t passes = (ToUnderlying(keyBits) + DigitBits - 1) / DigitBits;
+        if (count <= 1 || passes == 0)
+        {
+            return;
+        }
+
+        std::size_t chunks = std::max(std::min(ToUnderlying(pool.ThreadCount()), count / Grain), std::size_t(1));
+        auto forChunks = [&](auto&& func)
+        {
+            if (chunks == 1)
+            {
+                func(std::size_t(0), std::size_t(0), count);
+                return;
+            }
+
+            TaskGroup group;
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+            {
+                pool.Spawn(group, [&, chunk]() { func(chunk, count * chunk / chunks, count * (chunk + 1) / chunks); });
+            }
+            func(std::size_t(0), std::size_t(0), count / chunks);
+            pool.Wait(group);
+        };
+
+        std::vector<u64> keyScratch(count);
+        std::vector<u32> valueScratch(count);
+        std::span<u64> sourceKeys = keys;
+        std::span<u32> sourceValues = values;
+        std::span<u64> targetKeys = keyScratch;
+        std::span<u32> targetValues = valueScratch;
+
+        std::vector<std::array<std::size_t, DigitCount>> offsets(chunks);
+        for (std::size_t pass = 0; pass < passes; ++pass)
+        {
+            std::size_t shift = pass * DigitBits;
+            forChunks([&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                std::array<std::size_t, DigitCount>& histogram = offsets[chunk];
+                histogram.fill(0);
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    ++histogram[(ToUnderlying(sourceKeys[i]) >> shift) & (DigitCount - 1)];
+                }
+            });
+
+            // Note(3011): The keys of a digit go after the smaller digits, and
+            // within a digit in the order of the chunks.
+            bool shared = false;
+            std::size_t offset = 0;
+            for (std::size_t digit = 0; digit < DigitCount; ++digit)
+            {
+                std::size_t digitStart = offset;
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+                {
+                    std::size_t digitCount = offsets[chunk][digit];
+                    offsets[chunk][digit] = offset;
+                    offset += digitCount;
+                }
+                shared = shared || (offset - digitStart == count);
+            }
+
+            if (shared)
+            {
+                continue;
+            }
+
+            forChunks([&](std::size_t chunk, std::size_t begin, std::size_t end)
+            {
+                std::array<std::size_t, DigitCount>& chunkOffsets = offsets[chunk];
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    std::size_t target = chunkOffsets[(ToUnderlying(sourceKeys[i]) >> shift) & (DigitCount - 1)]++;
+                    targetKeys[target] = sourceKeys[i];
+                    targetValues[target] = sourceValues[i];
+                }
+            });
+
+            std::swap(sourceKeys, targetKeys);
+            std::swap(sourceValues, targetValues);
+        }
+
+        if (sourceKeys.data() != keys.data())
+        {
+            std::copy(sourceKeys.begin(), sourceKeys.end(), keys.begin());
+            std::copy(sourceValues.begin(), sourceValues.end(), values.begin());
+        }
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_BASE_PARALLEL_HPP
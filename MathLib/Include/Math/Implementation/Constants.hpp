@@ -195,6 +195,28 @@ namespace Math::Constant::Implementation
     {
         static constexpr StrongFloatType<T> Value = GeometryEpsilon<T>::Value;
     };
+
+    template <typename T>
+    struct OneMinusEpsilon final
+    {};
+
+    template <>
+    struct OneMinusEpsilon<float> final
+    {
+        static constexpr float Value = 0x1.FFFFFEp-1f;
+    };
+
+    template <>
+    struct OneMinusEpsilon<double> final
+    {
+        static constexpr double Value = 0x1.FFFFFFFFFFFFFp-1;
+    };
+
+    template <typename T>
+    struct OneMinusEpsilon<StrongFloatType<T>> final
+    {
+        static constexpr StrongFloatType<T> Value = OneMinusEpsilon<T>::Value;
+    };
 }
 
 #endif //MATHLIB_IMPLEMENTATION_CONSTANTS_HPP
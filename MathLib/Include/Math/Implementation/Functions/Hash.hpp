@@ -0,0 +1,48 @@
+#ifndef MATHLIB_IMPLEMENTATION_FUNCTIONS_HASH_HPP
+#define MATHLIB_IMPLEMENTATION_FUNCTIONS_HASH_HPP
+
+#include "../Base/Concepts.hpp"
+
+// Note(3011):
+// Small stateless integer hashes, meant for procedural generation (noise,
+// scrambling, per-pixel seeds) and not for hash tables of untrusted input.
+// Hash32 is the "lowbias32" function by Chris Wellons, Hash64 is the
+// finalizer of SplitMix64.
+
+namespace Math
+{
+    [[nodiscard]] constexpr
+    u32 Hash32(u32 val) noexcept
+    {
+        val ^= val >> 16;
+        val *= 0x7FEB352D;
+        val ^= val >> 15;
+        val *= 0x846CA68B;
+        val ^= val >> 16;
+        return val;
+    }
+
+    [[nodiscard]] constexpr
+    u64 Hash64(u64 val) noexcept
+    {
+        val = (val ^ (val >> 30)) * 0xBF58476D1CE4E5B9;
+        val = (val ^ (val >> 27)) * 0x94D049BB133111EB;
+        return val ^ (val >> 31);
+    }
+
+    [[nodiscard]] constexpr
+    u32 HashCombine(u32 seed, u32 val) noexcept
+    {
+        return Hash32(seed ^ (val + 0x9E3779B9 + (seed << 6) + (seed >> 2)));
+    }
+
+    template <typename... Ts>
+        requires (Concept::IsSame<Ts, u32> && ...)
+    [[nodiscard]] constexpr
+    u32 HashCombine(u32 seed, u32 val, Ts... values) noexcept
+    {
+        return HashCombine(HashCombine(seed, val), values...);
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_FUNCTIONS_HASH_HPP
@@ -25,14 +25,120 @@ namespace Math
     [[nodiscard]] constexpr
     Int CountLeadingZeros(Int val) noexcept
     {
-        return std::countl_zero(val);
+        return std::countl_zero(ToUnderlying(val));
     }
 
     template <Concept::UnsignedIntegralType Int>
     [[nodiscard]] constexpr
     Int CountTrailingZeros(Int val) noexcept
     {
-        return std::countr_zero(val);
+        return std::countr_zero(ToUnderlying(val));
+    }
+
+    template <Concept::UnsignedIntegralType Int>
+    [[nodiscard]] constexpr
+    Int PopCount(Int val) noexcept
+    {
+        return std::popcount(ToUnderlying(val));
+    }
+
+    template <Concept::UnsignedIntegralType Int>
+        requires (sizeof(Int) == 4)
+    [[nodiscard]] constexpr
+    Int ReverseBits(Int val) noexcept
+    {
+        val = ((val >> 1) & Int(0x55555555)) | ((val & Int(0x55555555)) << 1);
+        val = ((val >> 2) & Int(0x33333333)) | ((val & Int(0x33333333)) << 2);
+        val = ((val >> 4) & Int(0x0F0F0F0F)) | ((val & Int(0x0F0F0F0F)) << 4);
+        val = ((val >> 8) & Int(0x00FF00FF)) | ((val & Int(0x00FF00FF)) << 8);
+        return (val >> 16) | (val << 16);
+    }
+
+    template <Concept::UnsignedIntegralType Int>
+        requires (sizeof(Int) == 8)
+    [[nodiscard]] constexpr
+    Int ReverseBits(Int val) noexcept
+    {
+        val = ((val >> 1) & Int(0x5555555555555555)) | ((val & Int(0x5555555555555555)) << 1);
+        val = ((val >> 2) & Int(0x3333333333333333)) | ((val & Int(0x3333333333333333)) << 2);
+        val = ((val >> 4) & Int(0x0F0F0F0F0F0F0F0F)) | ((val & Int(0x0F0F0F0F0F0F0F0F)) << 4);
+        val = ((val >> 8) & Int(0x00FF00FF00FF00FF)) | ((val & Int(0x00FF00FF00FF00FF)) << 8);
+        val = ((val >> 16) & Int(0x0000FFFF0000FFFF)) | ((val & Int(0x0000FFFF0000FFFF)) << 16);
+        return (val >> 32) | (val << 32);
+    }
+
+    // Note(3011): Spreads the low 10 (32-bit) or 21 (64-bit) bits of val
+    // apart, with two zero bits between every pair, the building block of the
+    // Morton codes below.
+    template <Concept::UnsignedIntegralType Int>
+        requires (sizeof(Int) == 4)
+    [[nodiscard]] constexpr
+    Int SpreadBits3(Int val) noexcept
+    {
+        val = val & Int(0x000003FF);
+        val = (val | (val << 16)) & Int(0x030000FF);
+        val = (val | (val << 8)) & Int(0x0300F00F);
+        val = (val | (val << 4)) & Int(0x030C30C3);
+        val = (val | (val << 2)) & Int(0x09249249);
+        return val;
+    }
+
+    template <Concept::UnsignedIntegralType Int>
+        requires (sizeof(Int) == 8)
+    [[nodiscard]] constexpr
+    Int SpreadBits3(Int val) noexcept
+    {
+        val = val & Int(0x00000000001FFFFF);
+        val = (val | (val << 32)) & Int(0x001F00000000FFFF);
+        val = (val | (val << 16)) & Int(0x001F0000FF0000FF);
+        val = (val | (val << 8)) & Int(0x100F00F00F00F00F);
+        val = (val | (val << 4)) & Int(0x10C30C30C30C30C3);
+        val = (val | (val << 2)) & Int(0x1249249249249249);
+        return val;
+    }
+
+    // Note(3011): The Morton (Z-order) code of a cell of a 3D grid, the bits
+    // of the coordinates interleaved from the most significant ones down, x
+    // first. That is a 30-bit code of 10-bit coordinates for 32-bit integers
+    // and a 63-bit code of 21-bit coordinates for 64-bit ones, the higher
+    // bits of the coordinates are ignored. Sorting cells by their codes
+    // keeps nearby cells mostly close together.
+    template <Concept::UnsignedIntegralType Int>
+    [[nodiscard]] constexpr
+    Int MortonCode(Int x, Int y, Int z) noexcept
+    {
+        return (SpreadBits3(x) << 2) | (SpreadBits3(y) << 1) | SpreadBits3(z);
+    }
+
+    struct WideProduct
+    {
+        u64 High;
+        u64 Low;
+    };
+
+    // Note(3011): Full 128-bit product of two 64-bit values, used mostly to map
+    // random bits to a range without divisions.
+    [[nodiscard]] constexpr
+    WideProduct MultiplyWide(u64 a, u64 b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using u128 = unsigned __int128;
+        u128 product = static_cast<u128>(ToUnderlying(a)) * static_cast<u128>(ToUnderlying(b));
+        return { Cast<u64>(static_cast<std::uint64_t>(product >> 64)), Cast<u64>(static_cast<std::uint64_t>(product)) };
+#else
+        u64 aLow = a & u64(0xFFFFFFFF);
+        u64 aHigh = a >> 32;
+        u64 bLow = b & u64(0xFFFFFFFF);
+        u64 bHigh = b >> 32;
+
+        u64 lowLow = aLow * bLow;
+        u64 highLow = aHigh * bLow;
+        u64 lowHigh = aLow * bHigh;
+        u64 highHigh = aHigh * bHigh;
+
+        u64 cross = (lowLow >> 32) + (highLow & u64(0xFFFFFFFF)) + lowHigh;
+        return { highHigh + (highLow >> 32) + (cross >> 32), (cross << 32) | (lowLow & u64(0xFFFFFFFF)) };
+#endif
     }
 }
 
@@ -13,6 +13,21 @@ namespace Math
     {
         return std::log(ToUnderlying(val));
     }
+
+    // Note(3011): log(1 + val), without the rounding of 1 + val for small values.
+    template <Concept::FloatingPointType T>
+    [[nodiscard]] constexpr
+    T Log1p(T val) noexcept
+    {
+        return std::log1p(ToUnderlying(val));
+    }
+
+    template <Concept::FloatingPointType T>
+    [[nodiscard]] constexpr
+    T LogGamma(T val) noexcept
+    {
+        return std::lgamma(ToUnderlying(val));
+    }
 }
 
 #endif //MATHLIB_IMPLEMENTATION_FUNCTIONS_LOG_HPP
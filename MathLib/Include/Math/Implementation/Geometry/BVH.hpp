@@ -0,0 +1,1560 @@
+#ifndef MATHLIB_IMPLEMENTATION_GEOMETRY_BVH_HPP
+#define MATHLIB_IMPLEMENTATION_GEOMETRY_BVH_HPP
+
+#include "../Base/Array.hpp"
+#include "../Base/Parallel.hpp"
+#include "Bounds.hpp"
+#include "Intersections.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Math::Geometry
+{
+    // Note(3011): Leaves hold Count primitives starting at Offset, interior
+    // nodes have Count == 0, their first child follows them and the second
+    // one is at Offset.
+    template <Concept::StrongFloatType T>
+    struct BVHNode
+    {
+    public:
+        [[nodiscard]] constexpr
+        bool IsLeaf() const noexcept
+        {
+            return Count > 0;
+        }
+
+        Box<T> Bounds = Box<T>(Point<T>(), Point<T>());
+        u32 Offset = 0;
+        u32 Count = 0;
+    };
+
+    template <Concept::StrongFloatType T>
+    struct BVHIntersection
+    {
+    public:
+        using ScalarType = T;
+
+        [[nodiscard]] constexpr
+        bool IsValid() const noexcept
+        {
+            return Distance == Distance;
+        }
+
+        [[nodiscard]] constexpr explicit
+        operator bool () const noexcept
+        {
+            return IsValid();
+        }
+
+        // Note(3011): U and V are the barycentric coordinates of the hit on the
+        // primitive, as in Intersection.
+        ScalarType Distance = ScalarType::NaN();
+        ScalarType U = Cast<T>(0);
+        ScalarType V = Cast<T>(0);
+        SizeType Primitive = 0;
+    };
+
+    template <Concept::StrongFloatType T, SizeType N>
+    struct BVHIntersectionPacket
+    {
+    public:
+        using ScalarType = T;
+        static constexpr SizeType Width = N;
+
+        [[nodiscard]] constexpr
+        BVHIntersectionPacket() noexcept
+        {
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                Distance[lane] = ScalarType::NaN();
+                U[lane] = Cast<T>(0);
+                V[lane] = Cast<T>(0);
+                Primitive[lane] = 0;
+            }
+        }
+
+        [[nodiscard]] constexpr
+        bool IsValid(SizeType lane) const noexcept
+        {
+            return Distance[lane] == Distance[lane];
+        }
+
+        [[nodiscard]] constexpr
+        BVHIntersection<T> Get(SizeType lane) const noexcept
+        {
+            BVHIntersection<T> result;
+            result.Distance = Distance[lane];
+            result.U = U[lane];
+            result.V = V[lane];
+            result.Primitive = Primitive[lane];
+            return result;
+        }
+
+        Array<T, N> Distance;
+        Array<T, N> U;
+        Array<T, N> V;
+        Array<SizeType, N> Primitive;
+    };
+
+    enum class BVHPreset
+    {
+        Fast,
+        Balanced,
+        Quality,
+        Linear,
+        LinearOptimized
+    };
+
+    enum class BVHBuilder
+    {
+        BinnedSAH,
+        Linear
+    };
+
+    // Note(3011):
+    // How a hierarchy is built, the presets trade build time for traversal
+    // speed:
+    //
+    // - Fast bins the centroids only along their largest extent, into 8 bins,
+    //   and allows leaves of up to 8 primitives.
+    // - Balanced bins along every axis, into 16 bins, with leaves of up to 4.
+    // - Quality bins along every axis into 32 bins, with leaves of up to 4.
+    // - Linear sorts the primitives along a Morton curve with 30-bit codes
+    //   instead of binning, with leaves of up to 4. The fastest build by far,
+    //   meant for geometry that changes every frame.
+    // - LinearOptimized does the same with 63-bit codes, which keep apart the
+    //   primitives of small, dense clusters in a large scene, and restructures
+    //   the result in 2 rounds of treelets, which gets it close to Balanced.
+    //
+    // The fields can be changed after picking a preset. BinCount and AllAxes
+    // only matter to the binned builder, WideMortonCodes and TreeletRounds to
+    // the linear one. BinCount is clamped to [2, MaxBinCount] and MaxLeafSize
+    // to at least 1.
+    struct BVHBuildSettings
+    {
+    public:
+        static constexpr SizeType MaxBinCount = 64;
+
+        [[nodiscard]] constexpr explicit
+        BVHBuildSettings(BVHPreset preset = BVHPreset::Balanced) noexcept
+        {
+            switch (preset)
+            {
+            case BVHPreset::Fast:
+                BinCount = 8;
+                MaxLeafSize = 8;
+                AllAxes = false;
+                break;
+            case BVHPreset::Balanced:
+                break;
+            case BVHPreset::Quality:
+                BinCount = 32;
+                break;
+            case BVHPreset::Linear:
+                Builder = BVHBuilder::Linear;
+                break;
+            case BVHPreset::LinearOptimized:
+                Builder = BVHBuilder::Linear;
+                WideMortonCodes = true;
+                TreeletRounds = 2;
+                break;
+            }
+        }
+
+        BVHBuilder Builder = BVHBuilder::BinnedSAH;
+        SizeType BinCount = 16;
+        SizeType MaxLeafSize = 4;
+        bool AllAxes = true;
+        bool WideMortonCodes = false;
+        SizeType TreeletRounds = 0;
+    };
+
+    // Note(3011):
+    // A bounding volume hierarchy over any primitive with a BoundingBox and a
+    // NearestIntersection overload (Triangle, Sphere, Box). It is built top
+    // down with the binned surface area heuristic (I. Wald, "On fast
+    // Construction of SAH-based Bounding Volume Hierarchies", 2007): the
+    // primitive centroids are binned along every axis and the split between
+    // bins with the smallest expected cost, the areas of the children times
+    // their primitive counts, wins. Nodes that would not get cheaper by a split
+    // become leaves, see BVHBuildSettings for the knobs.
+    //
+    // The linear builder (T. Karras, "Maximizing Parallelism in the
+    // Construction of BVHs, Octrees, and k-d Trees", 2012) trades quality for
+    // speed. It sorts the primitives by the Morton codes of their centroids,
+    // in a grid over the centroid bounds, with a RadixSort, and every interior
+    // node of the hierarchy over the sorted primitives is then found on its
+    // own from the highest differing bits of the codes. The bounds and the
+    // SAH costs are filled in bottom up, the last of the two children to
+    // finish goes on to the parent. The subtrees that a leaf would test
+    // faster than the node become leaves when the nodes are stored. Optionally
+    // the bottom up pass restructures the treelets of 7 subtrees below every
+    // node into their cheapest shape (T. Karras, T. Aila, "Fast Parallel
+    // Construction of High-Quality Bounding Volume Hierarchies", 2013), once
+    // per round, for the nodes with at least 7, 14, 28, ... primitives.
+    //
+    // The build runs on a TaskPool of threadCount threads. The two children of
+    // a large enough node are built as separate tasks, and the binning and the
+    // bounds of the large nodes near the root, where there are few subtrees
+    // to go around, are split into chunks over the threads, and so is their
+    // partitioning. The nodes are allocated from a shared
+    // counter while building and reordered depth first afterwards, so the
+    // hierarchy is the same for any number of threads. Hierarchies over fewer
+    // than ParallelGrain primitives per thread use fewer threads.
+    //
+    // The nodes are stored depth first in a single array, and the primitives
+    // are copied in leaf order, so a leaf is one contiguous range of them. The
+    // queries report the index of the primitive in the span the hierarchy was
+    // built from. Planes have no bounds, keep those out of the hierarchy.
+    //
+    // Coherent rays can be traced as a RayPacket, the packet walks the tree
+    // together with a mask of the lanes still interested in the current node,
+    // and the lanes that miss a node drop out of its subtree. This pays off
+    // as long as the rays mostly visit the same nodes (camera rays through a
+    // small tile of pixels), incoherent rays are better off traced alone.
+
+    template <typename PrimitiveType>
+        requires requires (const PrimitiveType& primitive,
+                           const Ray<typename PrimitiveType::ScalarType>& ray,
+                           const Interval<typename PrimitiveType::ScalarType>& interval)
+        {
+            { BoundingBox(primitive) } -> Concept::IsSame<Box<typename PrimitiveType::ScalarType>>;
+            { NearestIntersection(ray, interval, primitive) } -> Concept::IsSame<Intersection<typename PrimitiveType::ScalarType>>;
+        }
+    class BVH final
+    {
+    public:
+        using ScalarType = typename PrimitiveType::ScalarType;
+        using NodeType = BVHNode<ScalarType>;
+
+        // Note(3011): Deeper nodes become leaves regardless of their size, this
+        // bounds the traversal stack.
+        static constexpr SizeType MaxDepth = 64;
+        // Note(3011): The fewest primitives a build task works on.
+        static constexpr SizeType ParallelGrain = 8192;
+
+        [[nodiscard]]
+        BVH() noexcept = default;
+
+        [[nodiscard]] explicit
+        BVH(std::span<const PrimitiveType> primitives, const BVHBuildSettings& settings = BVHBuildSettings(),
+            SizeType threadCount = HardwareThreadCount())
+        {
+            Build(primitives, settings, threadCount);
+        }
+
+        void Build(std::span<const PrimitiveType> primitives, const BVHBuildSettings& settings = BVHBuildSettings(),
+                   SizeType threadCount = HardwareThreadCount())
+        {
+            mNodes.clear();
+            mPrimitives.clear();
+            mIndices.clear();
+            if (primitives.empty())
+            {
+                return;
+            }
+
+            SizeType count = primitives.size();
+            TaskPool pool(Max(Min(threadCount, count / ParallelGrain), SizeType(1)));
+
+            BVHBuildSettings buildSettings = settings;
+            buildSettings.BinCount = Min(Max(settings.BinCount, SizeType(2)), BVHBuildSettings::MaxBinCount);
+            buildSettings.MaxLeafSize = Max(settings.MaxLeafSize, SizeType(1));
+
+            std::vector<Box<Float>> bounds(ToUnderlying(count), Box<Float>(Point<Float>(), Point<Float>()));
+            std::vector<Point<Float>> centroids(ToUnderlying(count));
+            mIndices.resize(ToUnderlying(count));
+            ForChunks(pool, 0, count, [&]([[maybe_unused]] SizeType chunk, SizeType begin, SizeType end)
+            {
+                for (SizeType i = begin; i < end; ++i)
+                {
+                    bounds[ToUnderlying(i)] = BoundingBox(primitives[ToUnderlying(i)]);
+                    centroids[ToUnderlying(i)] = Centroid(bounds[ToUnderlying(i)]);
+                    mIndices[ToUnderlying(i)] = Cast<u32>(i);
+                }
+            });
+
+            if (buildSettings.Builder == BVHBuilder::Linear)
+            {
+                BuildLinear(pool, buildSettings, bounds, centroids);
+            }
+            else
+            {
+                TaskGroup group;
+                std::vector<NodeType> nodes(ToUnderlying(2 * count - 1));
+                std::atomic<std::uint32_t> nodeCount = 1;
+                BuildContext context{ pool, group, buildSettings, bounds, centroids, nodes, nodeCount };
+                BuildNode(context, 0, 0, count, 0);
+                pool.Wait(group);
+
+                mNodes.reserve(nodeCount.load());
+                Flatten(nodes, 0);
+            }
+
+            mPrimitives.reserve(ToUnderlying(count));
+            for (u32 index : mIndices)
+            {
+                mPrimitives.push_back(primitives[ToUnderlying(index)]);
+            }
+        }
+
+        [[nodiscard]]
+        BVHIntersection<ScalarType> NearestIntersection(const Ray<ScalarType>& ray, const Interval<ScalarType>& interval) const noexcept
+        {
+            BVHIntersection<ScalarType> nearest;
+            if (mNodes.empty())
+            {
+                return nearest;
+            }
+
+            RayPrecomputed<ScalarType> precomputed(ray);
+            ScalarType closest = interval.Max;
+
+            ScalarType entry;
+            if (!Overlaps(mNodes[0], precomputed, interval.Min, closest, entry))
+            {
+                return nearest;
+            }
+
+            // Note(3011): The far children wait on the stack together with the
+            // distance at which the ray enters them, they are skipped once a
+            // closer hit has been found.
+            Array<u32, MaxDepth> stack;
+            Array<ScalarType, MaxDepth> stackEntries;
+            SizeType stackSize = 0;
+
+            u32 current = 0;
+            while (true)
+            {
+                const NodeType& node = mNodes[ToUnderlying(current)];
+                if (node.IsLeaf())
+                {
+                    for (u32 i = node.Offset; i < node.Offset + node.Count; ++i)
+                    {
+                        Interval<ScalarType> remaining(interval.Min, closest);
+                        Intersection<ScalarType> hit = IntersectPrimitive(ray, precomputed, remaining, mPrimitives[ToUnderlying(i)]);
+                        if (hit.IsValid() && (!nearest.IsValid() || hit.Distance < nearest.Distance))
+                        {
+                            closest = hit.Distance;
+                            nearest.Distance = hit.Distance;
+                            nearest.U = hit.U;
+                            nearest.V = hit.V;
+                            nearest.Primitive = Cast<SizeType>(mIndices[ToUnderlying(i)]);
+                        }
+                    }
+                }
+                else
+                {
+                    u32 first = current + 1;
+                    u32 second = node.Offset;
+
+                    ScalarType firstEntry, secondEntry;
+                    bool hitFirst = Overlaps(mNodes[ToUnderlying(first)], precomputed, interval.Min, closest, firstEntry);
+                    bool hitSecond = Overlaps(mNodes[ToUnderlying(second)], precomputed, interval.Min, closest, secondEntry);
+
+                    if (hitFirst && hitSecond)
+                    {
+                        if (secondEntry < firstEntry)
+                        {
+                            Swap(first, second);
+                            Swap(firstEntry, secondEntry);
+                        }
+
+                        stack[stackSize] = second;
+                        stackEntries[stackSize] = secondEntry;
+                        ++stackSize;
+                        current = first;
+                        continue;
+                    }
+                    else if (hitFirst)
+                    {
+                        current = first;
+                        continue;
+                    }
+                    else if (hitSecond)
+                    {
+                        current = second;
+                        continue;
+                    }
+                }
+
+                bool found = false;
+                while (stackSize > 0)
+                {
+                    --stackSize;
+                    if (stackEntries[stackSize] <= closest)
+                    {
+                        current = stack[stackSize];
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (!found)
+                {
+                    break;
+                }
+            }
+
+            return nearest;
+        }
+
+        [[nodiscard]]
+        bool HasIntersection(const Ray<ScalarType>& ray, const Interval<ScalarType>& interval) const noexcept
+        {
+            if (mNodes.empty())
+            {
+                return false;
+            }
+
+            RayPrecomputed<ScalarType> precomputed(ray);
+
+            Array<u32, MaxDepth + 1> stack;
+            SizeType stackSize = 0;
+            stack[stackSize++] = 0;
+
+            while (stackSize > 0)
+            {
+                u32 index = stack[--stackSize];
+                const NodeType& node = mNodes[ToUnderlying(index)];
+
+                ScalarType entry;
+                if (!Overlaps(node, precomputed, interval.Min, interval.Max, entry))
+                {
+                    continue;
+                }
+
+                if (node.IsLeaf())
+                {
+                    for (u32 i = node.Offset; i < node.Offset + node.Count; ++i)
+                    {
+                        if (IntersectPrimitive(ray, precomputed, interval, mPrimitives[ToUnderlying(i)]).IsValid())
+                        {
+                            return true;
+                        }
+                    }
+                }
+                else
+                {
+                    stack[stackSize++] = node.Offset;
+                    stack[stackSize++] = index + 1;
+                }
+            }
+
+            return false;
+        }
+
+        // Note(3011): Only the lanes set in active are traced, the others
+        // miss. The children are visited in the order the first active ray
+        // would see them.
+        template <SizeType N>
+            requires (N <= 32)
+        [[nodiscard]]
+        BVHIntersectionPacket<ScalarType, N> NearestIntersection(const RayPacket<ScalarType, N>& rays, const Interval<ScalarType>& interval,
+                                                                 u32 active = RayPacket<ScalarType, N>::AllLanes) const noexcept
+        {
+            BVHIntersectionPacket<ScalarType, N> nearest;
+            if (mNodes.empty() || active == 0)
+            {
+                return nearest;
+            }
+
+            Array<ScalarType, N> closest;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                closest[lane] = interval.Max;
+            }
+
+            Array<u32, MaxDepth + 1> stack;
+            Array<u32, MaxDepth + 1> stackMasks;
+            SizeType stackSize = 0;
+            stack[stackSize] = 0;
+            stackMasks[stackSize] = active;
+            ++stackSize;
+
+            while (stackSize > 0)
+            {
+                --stackSize;
+                u32 index = stack[stackSize];
+                const NodeType& node = mNodes[ToUnderlying(index)];
+
+                std::uint32_t mask = Overlaps(node, rays, interval.Min, closest, ToUnderlying(stackMasks[stackSize]));
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                if (node.IsLeaf())
+                {
+                    for (u32 i = node.Offset; i < node.Offset + node.Count; ++i)
+                    {
+                        IntersectionPacket<ScalarType, N> hits = IntersectPrimitive(rays, interval, mPrimitives[ToUnderlying(i)], mask);
+                        for (SizeType lane = 0; lane < N; ++lane)
+                        {
+                            bool inMask = (mask & (std::uint32_t(1) << ToUnderlying(lane))) != 0;
+                            if (inMask && hits.IsValid(lane) && (!nearest.IsValid(lane) || hits.Distance[lane] < nearest.Distance[lane]))
+                            {
+                                closest[lane] = hits.Distance[lane];
+                                nearest.Distance[lane] = hits.Distance[lane];
+                                nearest.U[lane] = hits.U[lane];
+                                nearest.V[lane] = hits.V[lane];
+                                nearest.Primitive[lane] = Cast<SizeType>(mIndices[ToUnderlying(i)]);
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    u32 first = index + 1;
+                    u32 second = node.Offset;
+                    if (SecondIsNearer(mNodes[ToUnderlying(first)], mNodes[ToUnderlying(second)], rays, mask))
+                    {
+                        Swap(first, second);
+                    }
+
+                    stack[stackSize] = second;
+                    stackMasks[stackSize] = u32(mask);
+                    ++stackSize;
+                    stack[stackSize] = first;
+                    stackMasks[stackSize] = u32(mask);
+                    ++stackSize;
+                }
+            }
+
+            return nearest;
+        }
+
+        // Note(3011): The mask of the active lanes that hit anything, lanes
+        // stop tracing after their first hit.
+        template <SizeType N>
+            requires (N <= 32)
+        [[nodiscard]]
+        u32 HasIntersection(const RayPacket<ScalarType, N>& rays, const Interval<ScalarType>& interval,
+                            u32 active = RayPacket<ScalarType, N>::AllLanes) const noexcept
+        {
+            std::uint32_t remaining = ToUnderlying(active);
+            if (mNodes.empty() || remaining == 0)
+            {
+                return 0;
+            }
+
+            Array<ScalarType, N> far;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                far[lane] = interval.Max;
+            }
+
+            Array<u32, MaxDepth + 1> stack;
+            Array<u32, MaxDepth + 1> stackMasks;
+            SizeType stackSize = 0;
+            stack[stackSize] = 0;
+            stackMasks[stackSize] = active;
+            ++stackSize;
+
+            while (stackSize > 0 && remaining != 0)
+            {
+                --stackSize;
+                u32 index = stack[stackSize];
+                const NodeType& node = mNodes[ToUnderlying(index)];
+
+                std::uint32_t mask = Overlaps(node, rays, interval.Min, far, ToUnderlying(stackMasks[stackSize]) & remaining);
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                if (node.IsLeaf())
+                {
+                    for (u32 i = node.Offset; i < node.Offset + node.Count && mask != 0; ++i)
+                    {
+                        IntersectionPacket<ScalarType, N> hits = IntersectPrimitive(rays, interval, mPrimitives[ToUnderlying(i)], mask);
+                        for (SizeType lane = 0; lane < N; ++lane)
+                        {
+                            std::uint32_t bit = std::uint32_t(1) << ToUnderlying(lane);
+                            if ((mask & bit) != 0 && hits.IsValid(lane))
+                            {
+                                mask &= ~bit;
+                                remaining &= ~bit;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    stack[stackSize] = node.Offset;
+                    stackMasks[stackSize] = u32(mask);
+                    ++stackSize;
+                    stack[stackSize] = index + 1;
+                    stackMasks[stackSize] = u32(mask);
+                    ++stackSize;
+                }
+            }
+
+            return u32(ToUnderlying(active) & ~remaining);
+        }
+
+        [[nodiscard]]
+        bool Empty() const noexcept
+        {
+            return mNodes.empty();
+        }
+
+        [[nodiscard]]
+        Box<ScalarType> Bounds() const noexcept
+        {
+            return mNodes.empty() ? Box<ScalarType>(Point<ScalarType>(), Point<ScalarType>()) : mNodes[0].Bounds;
+        }
+
+        [[nodiscard]]
+        std::span<const NodeType> Nodes() const noexcept
+        {
+            return mNodes;
+        }
+
+        // Note(3011): The primitives in leaf order, PrimitiveIndices()[i] is
+        // the index of Primitives()[i] in the span the hierarchy was built from.
+        [[nodiscard]]
+        std::span<const PrimitiveType> Primitives() const noexcept
+        {
+            return mPrimitives;
+        }
+
+        [[nodiscard]]
+        std::span<const u32> PrimitiveIndices() const noexcept
+        {
+            return mIndices;
+        }
+    private:
+        using Float = ScalarType;
+
+        using RawFloat = UnderlyingType<Float>;
+
+        // Note(3011): The bins hold plain floats, so arrays of them are not
+        // zeroed up front like Array and the strong types would be, only the
+        // BinCount bins in use get cleared. A cleared bin is an inverted box,
+        // growing it needs no special case.
+        struct Bin
+        {
+            std::array<RawFloat, 3> Min;
+            std::array<RawFloat, 3> Max;
+            std::size_t Count;
+
+            void Clear() noexcept
+            {
+                RawFloat infinity = std::numeric_limits<RawFloat>::infinity();
+                Min = { infinity, infinity, infinity };
+                Max = { -infinity, -infinity, -infinity };
+                Count = 0;
+            }
+
+            void Grow(const Box<Float>& box) noexcept
+            {
+                Min[0] = std::min(Min[0], ToUnderlying(box.Min.x));
+                Min[1] = std::min(Min[1], ToUnderlying(box.Min.y));
+                Min[2] = std::min(Min[2], ToUnderlying(box.Min.z));
+                Max[0] = std::max(Max[0], ToUnderlying(box.Max.x));
+                Max[1] = std::max(Max[1], ToUnderlying(box.Max.y));
+                Max[2] = std::max(Max[2], ToUnderlying(box.Max.z));
+                ++Count;
+            }
+
+            void Merge(const Bin& other) noexcept
+            {
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    Min[axis] = std::min(Min[axis], other.Min[axis]);
+                    Max[axis] = std::max(Max[axis], other.Max[axis]);
+                }
+                Count += other.Count;
+            }
+
+            // Note(3011): SurfaceArea of the bounds, in the same order.
+            [[nodiscard]]
+            RawFloat Area() const noexcept
+            {
+                RawFloat x = Max[0] - Min[0];
+                RawFloat y = Max[1] - Min[1];
+                RawFloat z = Max[2] - Min[2];
+                return RawFloat(2) * (x * y + y * z + z * x);
+            }
+        };
+
+        // Note(3011): Primitives with an overload for precomputed rays (boxes,
+        // triangles) get that one.
+        [[nodiscard]] static
+        Intersection<Float> IntersectPrimitive(const Ray<Float>& ray, const RayPrecomputed<Float>& precomputed,
+                                               const Interval<Float>& interval, const PrimitiveType& primitive) noexcept
+        {
+            if constexpr (requires { { Geometry::NearestIntersection(precomputed, interval, primitive) } -> Concept::IsSame<Intersection<Float>>; })
+            {
+                return Geometry::NearestIntersection(precomputed, interval, primitive);
+            }
+            else
+            {
+                return Geometry::NearestIntersection(ray, interval, primitive);
+            }
+        }
+
+        [[nodiscard]] static
+        bool Overlaps(const NodeType& node, const RayPrecomputed<Float>& ray, Float near, Float far, Float& entry) noexcept
+        {
+            Implementation::ClipToBox(node.Bounds, ray, near, far);
+            entry = near;
+            return near <= far;
+        }
+
+        // Note(3011): The lanes of mask whose rays overlap the node closer than
+        // far.
+        template <SizeType N>
+        [[nodiscard]] static
+        std::uint32_t Overlaps(const NodeType& node, const RayPacket<Float, N>& rays, Float near, const Array<Float, N>& far, std::uint32_t mask) noexcept
+        {
+            Array<Float, N> laneNear;
+            Array<Float, N> laneFar = far;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                laneNear[lane] = near;
+            }
+            Implementation::ClipRaysToBox(node.Bounds, rays, laneNear, laneFar);
+
+            std::uint32_t overlaps = 0;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                overlaps |= ((ToUnderlying(laneNear[lane]) <= ToUnderlying(laneFar[lane])) ? 1u : 0u) << ToUnderlying(lane);
+            }
+            return overlaps & mask;
+        }
+
+        // Note(3011): Whether the first active ray of the mask meets the second
+        // child first, judged by its direction along the axis that separates
+        // the centers of the children the most.
+        template <SizeType N>
+        [[nodiscard]] static
+        bool SecondIsNearer(const NodeType& first, const NodeType& second, const RayPacket<Float, N>& rays, std::uint32_t mask) noexcept
+        {
+            SizeType lane = Cast<SizeType>(std::countr_zero(mask));
+            Vector3T<Float> offset = Centroid(second.Bounds) - Centroid(first.Bounds);
+            Vector3T<Float> direction = rays.Direction.Get(lane);
+
+            SizeType axis = 0;
+            if (Abs(offset.y) > Abs(offset[axis])) { axis = 1; }
+            if (Abs(offset.z) > Abs(offset[axis])) { axis = 2; }
+            return offset[axis] * direction[axis] < Cast<Float>(0);
+        }
+
+        // Note(3011): Primitives without a packet overload are tested lane by
+        // lane, only the lanes in mask.
+        template <SizeType N>
+        [[nodiscard]] static
+        IntersectionPacket<Float, N> IntersectPrimitive(const RayPacket<Float, N>& rays, const Interval<Float>& interval,
+                                                        const PrimitiveType& primitive, std::uint32_t mask) noexcept
+        {
+            if constexpr (requires { { Geometry::NearestIntersection(rays, interval, primitive) } -> Concept::IsSame<IntersectionPacket<Float, N>>; })
+            {
+                return Geometry::NearestIntersection(rays, interval, primitive);
+            }
+            else
+            {
+                IntersectionPacket<Float, N> hits;
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    Intersection<Float> hit(Float::NaN());
+                    if ((mask & (std::uint32_t(1) << ToUnderlying(lane))) != 0)
+                    {
+                        Ray<Float> ray = rays.Get(lane);
+                        hit = IntersectPrimitive(ray, RayPrecomputed<Float>(ray), interval, primitive);
+                    }
+                    hits.Distance[lane] = hit.Distance;
+                    hits.U[lane] = hit.U;
+                    hits.V[lane] = hit.V;
+                }
+                return hits;
+            }
+        }
+
+        // Note(3011): The state shared by the build tasks. The nodes are
+        // allocated in pairs, an interior node points at the first of its
+        // children with Offset while building.
+        struct BuildContext
+        {
+            TaskPool& Pool;
+            TaskGroup& Group;
+            const BVHBuildSettings& Settings;
+            const std::vector<Box<Float>>& Bounds;
+            const std::vector<Point<Float>>& Centroids;
+            std::vector<NodeType>& Nodes;
+            std::atomic<std::uint32_t>& NodeCount;
+        };
+
+        struct RangeBounds
+        {
+            Box<Float> Bounds;
+            Box<Float> Centroids;
+        };
+
+        using AxisBins = std::array<std::array<Bin, ToUnderlying(BVHBuildSettings::MaxBinCount)>, 3>;
+
+        [[nodiscard]] static
+        SizeType ChunkCount(const TaskPool& pool, SizeType count) noexcept
+        {
+            return Min(pool.ThreadCount() * 4, count / ParallelGrain);
+        }
+
+        // Note(3011): Calls func(chunk, begin, end) for chunks of [begin, end)
+        // on the pool and waits for them, small ranges are a single chunk.
+        template <typename Func>
+        static void ForChunks(TaskPool& pool, SizeType begin, SizeType end, Func&& func)
+        {
+            SizeType count = end - begin;
+            SizeType chunks = ChunkCount(pool, count);
+            if (chunks <= 1)
+            {
+                func(SizeType(0), begin, end);
+                return;
+            }
+
+            TaskGroup group;
+            for (SizeType i = 1; i < chunks; ++i)
+            {
+                pool.Spawn(group, [&, i]() { func(i, begin + count * i / chunks, begin + count * (i + 1) / chunks); });
+            }
+            func(SizeType(0), begin, begin + count / chunks);
+            pool.Wait(group);
+        }
+
+        // Note(3011): func(begin, end) over chunks of [begin, end), with the
+        // results merged in the order of the chunks.
+        template <typename Result, typename Func, typename Merge>
+        [[nodiscard]] static
+        Result Reduce(TaskPool& pool, SizeType begin, SizeType end, Func&& func, Merge&& merge)
+        {
+            SizeType count = end - begin;
+            SizeType chunks = ChunkCount(pool, count);
+            if (chunks <= 1)
+            {
+                return func(begin, end);
+            }
+
+            std::vector<std::optional<Result>> results(ToUnderlying(chunks));
+            ForChunks(pool, begin, end, [&](SizeType chunk, SizeType chunkBegin, SizeType chunkEnd)
+            {
+                results[ToUnderlying(chunk)] = func(chunkBegin, chunkEnd);
+            });
+
+            Result result = *results[0];
+            for (SizeType i = 1; i < chunks; ++i)
+            {
+                result = merge(result, *results[ToUnderlying(i)]);
+            }
+            return result;
+        }
+
+        // Note(3011): Builds the subtree of mIndices[begin, end) into
+        // context.Nodes[nodeIndex]. The second child of large nodes is left to
+        // another task.
+        void BuildNode(const BuildContext& context, std::uint32_t nodeIndex, SizeType begin, SizeType end, SizeType depth)
+        {
+            RangeBounds range = Reduce<RangeBounds>(context.Pool, begin, end, [&](SizeType chunkBegin, SizeType chunkEnd)
+            {
+                u32 firstIndex = mIndices[ToUnderlying(chunkBegin)];
+                RangeBounds result{ context.Bounds[ToUnderlying(firstIndex)], BoundingBox(context.Centroids[ToUnderlying(firstIndex)]) };
+                for (SizeType i = chunkBegin + 1; i < chunkEnd; ++i)
+                {
+                    u32 index = mIndices[ToUnderlying(i)];
+                    result.Bounds = Union(result.Bounds, context.Bounds[ToUnderlying(index)]);
+                    result.Centroids = Union(result.Centroids, context.Centroids[ToUnderlying(index)]);
+                }
+                return result;
+            }, [](const RangeBounds& a, const RangeBounds& b)
+            {
+                return RangeBounds{ Union(a.Bounds, b.Bounds), Union(a.Centroids, b.Centroids) };
+            });
+
+            NodeType& node = context.Nodes[nodeIndex];
+            node.Bounds = range.Bounds;
+
+            SizeType count = end - begin;
+            SizeType middle = Split(context, begin, end, depth, range.Bounds, range.Centroids);
+            if (middle == begin)
+            {
+                node.Offset = Cast<u32>(begin);
+                node.Count = Cast<u32>(count);
+                return;
+            }
+
+            std::uint32_t first = context.NodeCount.fetch_add(2, std::memory_order_relaxed);
+            node.Offset = u32(first);
+
+            if (context.Pool.ThreadCount() > 1 && end - middle >= ParallelGrain)
+            {
+                context.Pool.Spawn(context.Group, [this, &context, first, middle, end, depth]()
+                {
+                    BuildNode(context, first + 1, middle, end, depth + 1);
+                });
+                BuildNode(context, first, begin, middle, depth + 1);
+            }
+            else
+            {
+                BuildNode(context, first, begin, middle, depth + 1);
+                BuildNode(context, first + 1, middle, end, depth + 1);
+            }
+        }
+
+        // Note(3011): Partitions mIndices[begin, end) and returns where the
+        // second child starts, or begin if the node should be a leaf.
+        [[nodiscard]]
+        SizeType Split(const BuildContext& context, SizeType begin, SizeType end, SizeType depth,
+                       const Box<Float>& nodeBounds, const Box<Float>& centroidBounds)
+        {
+            const BVHBuildSettings& settings = context.Settings;
+
+            SizeType count = end - begin;
+            if (count == 1 || depth + 1 >= MaxDepth)
+            {
+                return begin;
+            }
+
+            Vector3T<Float> extent = centroidBounds.Max - centroidBounds.Min;
+            SizeType axis = 0;
+            if (extent.y > extent[axis]) { axis = 1; }
+            if (extent.z > extent[axis]) { axis = 2; }
+
+            // Note(3011): All the centroids are in the same place, binning
+            // cannot separate them. Halve the range if it is too large for a
+            // leaf, the order does not matter.
+            if (extent[axis] <= Cast<Float>(0))
+            {
+                return (count > settings.MaxLeafSize) ? begin + count / 2 : begin;
+            }
+
+            Array<bool, 3> binned;
+            for (SizeType a = 0; a < 3; ++a)
+            {
+                binned[a] = extent[a] > Cast<Float>(0) && (settings.AllAxes || a == axis);
+            }
+
+            std::size_t binCount = ToUnderlying(settings.BinCount);
+            AxisBins bins = Reduce<AxisBins>(context.Pool, begin, end, [&](SizeType chunkBegin, SizeType chunkEnd)
+            {
+                AxisBins result;
+                for (std::size_t a = 0; a < 3; ++a)
+                {
+                    for (std::size_t i = 0; i < binCount; ++i)
+                    {
+                        result[a][i].Clear();
+                    }
+                }
+
+                for (SizeType i = chunkBegin; i < chunkEnd; ++i)
+                {
+                    u32 index = mIndices[ToUnderlying(i)];
+                    const Box<Float>& primitiveBounds = context.Bounds[ToUnderlying(index)];
+                    const Point<Float>& centroid = context.Centroids[ToUnderlying(index)];
+                    for (SizeType a = 0; a < 3; ++a)
+                    {
+                        if (binned[a])
+                        {
+                            SizeType bin = BinIndex(centroid[a], centroidBounds.Min[a], extent[a], settings.BinCount);
+                            result[ToUnderlying(a)][ToUnderlying(bin)].Grow(primitiveBounds);
+                        }
+                    }
+                }
+                return result;
+            }, [&](const AxisBins& a, const AxisBins& b)
+            {
+                AxisBins result = a;
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    for (std::size_t i = 0; i < binCount; ++i)
+                    {
+                        result[axis][i].Merge(b[axis][i]);
+                    }
+                }
+                return result;
+            });
+
+            RawFloat bestCost = std::numeric_limits<RawFloat>::infinity();
+            SizeType bestAxis = 0;
+            SizeType bestBin = 0;
+            for (SizeType a = 0; a < 3; ++a)
+            {
+                if (!binned[a])
+                {
+                    continue;
+                }
+
+                // Note(3011): Sweep from the right to get the cost of the right
+                // sides, then from the left, splitting after bin i.
+                const std::array<Bin, ToUnderlying(BVHBuildSettings::MaxBinCount)>& axisBins = bins[ToUnderlying(a)];
+                std::array<RawFloat, ToUnderlying(BVHBuildSettings::MaxBinCount)> rightCosts;
+                Bin right;
+                right.Clear();
+                for (std::size_t i = binCount - 1; i > 0; --i)
+                {
+                    right.Merge(axisBins[i]);
+                    rightCosts[i - 1] = (right.Count == 0) ? std::numeric_limits<RawFloat>::infinity() : right.Area() * RawFloat(right.Count);
+                }
+
+                Bin left;
+                left.Clear();
+                for (std::size_t i = 0; i + 1 < binCount; ++i)
+                {
+                    left.Merge(axisBins[i]);
+                    if (left.Count == 0)
+                    {
+                        continue;
+                    }
+
+                    RawFloat cost = left.Area() * RawFloat(left.Count) + rightCosts[i];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = a;
+                        bestBin = i;
+                    }
+                }
+            }
+
+            // Note(3011): A traversal step costs about as much as a primitive
+            // test, so the split pays off when the hit probabilities (the area
+            // ratios) times the counts add up to less than the count minus one.
+            Float area = SurfaceArea(nodeBounds);
+            Float leafCost = Cast<Float>(count);
+            Float splitCost = Cast<Float>(1) + ((area > Cast<Float>(0)) ? Float(bestCost) / area : Cast<Float>(count));
+            if (count <= settings.MaxLeafSize && leafCost <= splitCost)
+            {
+                return begin;
+            }
+
+            if (bestCost == std::numeric_limits<RawFloat>::infinity())
+            {
+                return begin + count / 2;
+            }
+
+            return Partition(context.Pool, begin, end, [&](u32 index)
+            {
+                Float coordinate = context.Centroids[ToUnderlying(index)][bestAxis];
+                return BinIndex(coordinate, centroidBounds.Min[bestAxis], extent[bestAxis], settings.BinCount) <= bestBin;
+            });
+        }
+
+        // Note(3011):
+        // Moves the indices in mIndices[begin, end) that go left in front of
+        // the others and returns where the others start. Ranges of at least
+        // ParallelGrain indices are partitioned the way RadixSort scatters a
+        // digit: every chunk counts its left indices, the counts tell every
+        // chunk where its indices go on either side, and the chunks scatter
+        // them into a copy. That partition is stable, so the order does not
+        // depend on the number of chunks, and the hierarchy stays the same for
+        // any thread count. Smaller ranges use std::partition in place.
+        template <typename Predicate>
+        [[nodiscard]]
+        SizeType Partition(TaskPool& pool, SizeType begin, SizeType end, Predicate&& left)
+        {
+            SizeType count = end - begin;
+            if (count < ParallelGrain)
+            {
+                auto split = std::partition(mIndices.begin() + ToUnderlying(begin), mIndices.begin() + ToUnderlying(end), left);
+                return Cast<SizeType>(split - mIndices.begin());
+            }
+
+            // Note(3011): The chunks are the ones ForChunks picks.
+            SizeType chunks = Max(ChunkCount(pool, count), SizeType(1));
+            std::vector<SizeType> leftOffsets(ToUnderlying(chunks));
+            ForChunks(pool, begin, end, [&](SizeType chunk, SizeType chunkBegin, SizeType chunkEnd)
+            {
+                SizeType leftCount = 0;
+                for (SizeType i = chunkBegin; i < chunkEnd; ++i)
+                {
+                    if (left(mIndices[ToUnderlying(i)]))
+                    {
+                        ++leftCount;
+                    }
+                }
+                leftOffsets[ToUnderlying(chunk)] = leftCount;
+            });
+
+            SizeType leftTotal = 0;
+            for (SizeType& offset : leftOffsets)
+            {
+                SizeType leftCount = offset;
+                offset = leftTotal;
+                leftTotal += leftCount;
+            }
+
+            // Note(3011): The right indices of a chunk follow the right ones
+            // of the chunks before it, of which there are as many as indices
+            // before the chunk minus the left ones.
+            std::vector<u32> scratch(ToUnderlying(count));
+            ForChunks(pool, begin, end, [&](SizeType chunk, SizeType chunkBegin, SizeType chunkEnd)
+            {
+                SizeType leftTarget = leftOffsets[ToUnderlying(chunk)];
+                SizeType rightTarget = leftTotal + (chunkBegin - begin) - leftTarget;
+                for (SizeType i = chunkBegin; i < chunkEnd; ++i)
+                {
+                    u32 index = mIndices[ToUnderlying(i)];
+                    if (left(index))
+                    {
+                        scratch[ToUnderlying(leftTarget++)] = index;
+                    }
+                    else
+                    {
+                        scratch[ToUnderlying(rightTarget++)] = index;
+                    }
+                }
+            });
+
+            ForChunks(pool, begin, end, [&]([[maybe_unused]] SizeType chunk, SizeType chunkBegin, SizeType chunkEnd)
+            {
+                std::copy(scratch.begin() + ToUnderlying(chunkBegin - begin), scratch.begin() + ToUnderlying(chunkEnd - begin),
+                          mIndices.begin() + ToUnderlying(chunkBegin));
+            });
+            return begin + leftTotal;
+        }
+
+        [[nodiscard]] static
+        SizeType BinIndex(Float coordinate, Float min, Float extent, SizeType binCount) noexcept
+        {
+            Float scaled = (coordinate - min) * (Cast<Float>(binCount) / extent);
+            return Min(Cast<SizeType>(Max(scaled, Cast<Float>(0))), binCount - 1);
+        }
+
+        // Note(3011): Appends the subtree of nodes[index] to mNodes depth
+        // first and returns where it went.
+        u32 Flatten(const std::vector<NodeType>& nodes, std::uint32_t index)
+        {
+            u32 result = Cast<u32>(mNodes.size());
+            mNodes.push_back(nodes[index]);
+            if (!nodes[index].IsLeaf())
+            {
+                std::uint32_t first = ToUnderlying(nodes[index].Offset);
+                Flatten(nodes, first);
+                mNodes[ToUnderlying(result)].Offset = Flatten(nodes, first + 1);
+            }
+            return result;
+        }
+
+        // Note(3011): The binary hierarchy the linear builder works on, with a
+        // leaf per primitive. The leaves are the nodes [0, n) in Morton order,
+        // the interior nodes are [n, 2n - 1) and the root is n. Costs are the
+        // SAH costs of the subtrees relative to a primitive test, times the
+        // area of their root.
+        struct LinearTree
+        {
+            static constexpr std::uint32_t NoNode = ~std::uint32_t(0);
+            static constexpr std::size_t TreeletLeaves = 7;
+
+            std::size_t LeafCount;
+            std::size_t MaxLeafSize;
+            std::vector<Bin> Bins;
+            std::vector<RawFloat> Costs;
+            std::vector<std::uint32_t> Parents;
+            std::vector<std::array<std::uint32_t, 2>> Children;
+
+            [[nodiscard]]
+            bool IsLeaf(std::uint32_t node) const noexcept
+            {
+                return node < LeafCount;
+            }
+
+            [[nodiscard]]
+            std::array<std::uint32_t, 2>& ChildrenOf(std::uint32_t node) noexcept
+            {
+                return Children[node - LeafCount];
+            }
+
+            [[nodiscard]]
+            RawFloat LeafCost(const Bin& bin) const noexcept
+            {
+                return (bin.Count <= MaxLeafSize) ? bin.Area() * RawFloat(bin.Count) : std::numeric_limits<RawFloat>::infinity();
+            }
+
+            // Note(3011): Recomputes the bounds and the cost of an interior node
+            // from its children.
+            void Refit(std::uint32_t node) noexcept
+            {
+                const std::array<std::uint32_t, 2>& children = ChildrenOf(node);
+                Bin bin = Bins[children[0]];
+                bin.Merge(Bins[children[1]]);
+                Bins[node] = bin;
+                Costs[node] = std::min(bin.Area() + Costs[children[0]] + Costs[children[1]], LeafCost(bin));
+            }
+
+            // Note(3011): Gathers the 7 subtrees below node, expanding the one
+            // with the largest area each time, tries every way to join them
+            // into a binary tree and keeps the cheapest one if it beats the
+            // current shape. The interior nodes of the treelet are reused.
+            void RestructureTreelet(std::uint32_t root) noexcept
+            {
+                constexpr std::size_t SubsetCount = std::size_t(1) << TreeletLeaves;
+
+                std::array<std::uint32_t, TreeletLeaves> leaves;
+                std::array<std::uint32_t, TreeletLeaves - 1> interiors;
+                leaves[0] = ChildrenOf(root)[0];
+                leaves[1] = ChildrenOf(root)[1];
+                interiors[0] = root;
+                std::size_t leafCount = 2;
+                std::size_t interiorCount = 1;
+                while (leafCount < TreeletLeaves)
+                {
+                    std::size_t expand = leafCount;
+                    RawFloat largest = -std::numeric_limits<RawFloat>::infinity();
+                    for (std::size_t i = 0; i < leafCount; ++i)
+                    {
+                        if (!IsLeaf(leaves[i]) && Bins[leaves[i]].Area() > largest)
+                        {
+                            expand = i;
+                            largest = Bins[leaves[i]].Area();
+                        }
+                    }
+
+                    if (expand == leafCount)
+                    {
+                        break;
+                    }
+
+                    std::uint32_t node = leaves[expand];
+                    interiors[interiorCount++] = node;
+                    leaves[expand] = ChildrenOf(node)[0];
+                    leaves[leafCount++] = ChildrenOf(node)[1];
+                }
+
+                if (leafCount < 3)
+                {
+                    return;
+                }
+
+                // Note(3011): The cheapest tree over every subset of the
+                // leaves, from the smaller subsets up. A subset is split
+                // into the part with its lowest leaf and the rest, which
+                // covers every split once.
+                std::array<Bin, SubsetCount> unions;
+                std::array<RawFloat, SubsetCount> costs;
+                std::array<std::size_t, SubsetCount> splits;
+                std::size_t full = (std::size_t(1) << leafCount) - 1;
+                for (std::size_t set = 1; set <= full; ++set)
+                {
+                    std::size_t lowest = std::size_t(1) << std::countr_zero(set);
+                    std::uint32_t lowestLeaf = leaves[std::countr_zero(set)];
+                    if (set == lowest)
+                    {
+                        unions[set] = Bins[lowestLeaf];
+                        costs[set] = Costs[lowestLeaf];
+                        continue;
+                    }
+
+                    unions[set] = unions[set & (set - 1)];
+                    unions[set].Merge(Bins[lowestLeaf]);
+
+                    RawFloat best = std::numeric_limits<RawFloat>::infinity();
+                    std::size_t rest = set ^ lowest;
+                    std::size_t subset = rest;
+                    do
+                    {
+                        subset = (subset - 1) & rest;
+                        std::size_t part = subset | lowest;
+                        RawFloat cost = costs[part] + costs[set ^ part];
+                        if (cost < best)
+                        {
+                            best = cost;
+                            splits[set] = part;
+                        }
+                    }
+                    while (subset != 0);
+
+                    costs[set] = std::min(unions[set].Area() + best, LeafCost(unions[set]));
+                }
+
+                if (!(costs[full] < Costs[root]))
+                {
+                    return;
+                }
+
+                std::size_t nextInterior = 1;
+                auto rebuild = [&](auto& self, std::size_t set, std::uint32_t node) -> void
+                {
+                    std::array<std::size_t, 2> parts = { splits[set], set ^ splits[set] };
+                    for (std::size_t i = 0; i < 2; ++i)
+                    {
+                        std::uint32_t child;
+                        if (std::popcount(parts[i]) == 1)
+                        {
+                            child = leaves[std::countr_zero(parts[i])];
+                        }
+                        else
+                        {
+                            child = interiors[nextInterior++];
+                            self(self, parts[i], child);
+                        }
+                        ChildrenOf(node)[i] = child;
+                        Parents[child] = node;
+                    }
+                    Refit(node);
+                };
+                rebuild(rebuild, full, root);
+            }
+        };
+
+        // Note(3011): The length of the common prefix of the keys of leaves i
+        // and j, the keys being the Morton codes with the index appended to
+        // tell equal codes apart. -1 for j out of range.
+        [[nodiscard]] static
+        int CommonPrefix(std::span<const u64> codes, std::int64_t i, std::int64_t j) noexcept
+        {
+            if (j < 0 || j >= std::int64_t(codes.size()))
+            {
+                return -1;
+            }
+
+            std::uint64_t a = ToUnderlying(codes[std::size_t(i)]);
+            std::uint64_t b = ToUnderlying(codes[std::size_t(j)]);
+            if (a == b)
+            {
+                return 64 + std::countl_zero(std::uint64_t(i ^ j));
+            }
+            return std::countl_zero(a ^ b);
+        }
+
+        // Note(3011): Finds the range of leaves below interior node i and the
+        // split in it, see Karras 2012.
+        static void LinkInteriorNode(LinearTree& tree, std::span<const u64> codes, std::int64_t i) noexcept
+        {
+            std::int64_t direction = (CommonPrefix(codes, i, i + 1) > CommonPrefix(codes, i, i - 1)) ? 1 : -1;
+            int minPrefix = CommonPrefix(codes, i, i - direction);
+
+            std::int64_t maxLength = 2;
+            while (CommonPrefix(codes, i, i + maxLength * direction) > minPrefix)
+            {
+                maxLength *= 2;
+            }
+
+            std::int64_t length = 0;
+            for (std::int64_t step = maxLength / 2; step >= 1; step /= 2)
+            {
+                if (CommonPrefix(codes, i, i + (length + step) * direction) > minPrefix)
+                {
+                    length += step;
+                }
+            }
+
+            std::int64_t j = i + length * direction;
+            int nodePrefix = CommonPrefix(codes, i, j);
+            std::int64_t split = 0;
+            std::int64_t step = length;
+            do
+            {
+                step = (step + 1) / 2;
+                if (CommonPrefix(codes, i, i + (split + step) * direction) > nodePrefix)
+                {
+                    split += step;
+                }
+            }
+            while (step > 1);
+
+            std::int64_t gamma = i + split * direction + std::min(direction, std::int64_t(0));
+            std::uint32_t leafCount = std::uint32_t(tree.LeafCount);
+            std::uint32_t node = leafCount + std::uint32_t(i);
+            std::uint32_t left = std::uint32_t(gamma) + ((std::min(i, j) == gamma) ? 0 : leafCount);
+            std::uint32_t right = std::uint32_t(gamma + 1) + ((std::max(i, j) == gamma + 1) ? 0 : leafCount);
+            tree.ChildrenOf(node) = { left, right };
+            tree.Parents[left] = node;
+            tree.Parents[right] = node;
+        }
+
+        void BuildLinear(TaskPool& pool, const BVHBuildSettings& settings,
+                         const std::vector<Box<Float>>& bounds, const std::vector<Point<Float>>& centroids)
+        {
+            SizeType count = mIndices.size();
+            Box<Float> centroidBounds = Reduce<Box<Float>>(pool, 0, count, [&](SizeType begin, SizeType end)
+            {
+                Box<Float> result = BoundingBox(centroids[ToUnderlying(begin)]);
+                for (SizeType i = begin + 1; i < end; ++i)
+                {
+                    result = Union(result, centroids[ToUnderlying(i)]);
+                }
+                return result;
+            }, [](const Box<Float>& a, const Box<Float>& b)
+            {
+                return Union(a, b);
+            });
+
+            std::vector<u64> codes(ToUnderlying(count));
+            ForChunks(pool, 0, count, [&]([[maybe_unused]] SizeType chunk, SizeType begin, SizeType end)
+            {
+                for (SizeType i = begin; i < end; ++i)
+                {
+                    const Point<Float>& centroid = centroids[ToUnderlying(i)];
+                    codes[ToUnderlying(i)] = settings.WideMortonCodes ? MortonCode<u64>(centroid, centroidBounds)
+                                                                      : Cast<u64>(MortonCode<u32>(centroid, centroidBounds));
+                }
+            });
+            RadixSort(codes, mIndices, settings.WideMortonCodes ? 63 : 30, pool);
+
+            std::size_t leafCount = ToUnderlying(count);
+            LinearTree tree{ leafCount, ToUnderlying(settings.MaxLeafSize),
+                             std::vector<Bin>(2 * leafCount - 1), std::vector<RawFloat>(2 * leafCount - 1),
+                             std::vector<std::uint32_t>(2 * leafCount - 1), std::vector<std::array<std::uint32_t, 2>>(leafCount - 1) };
+            std::uint32_t root = (leafCount == 1) ? 0 : std::uint32_t(leafCount);
+            tree.Parents[root] = LinearTree::NoNode;
+
+            ForChunks(pool, 0, count, [&]([[maybe_unused]] SizeType chunk, SizeType begin, SizeType end)
+            {
+                for (SizeType i = begin; i < end; ++i)
+                {
+                    Bin& bin = tree.Bins[ToUnderlying(i)];
+                    bin.Clear();
+                    bin.Grow(bounds[ToUnderlying(mIndices[ToUnderlying(i)])]);
+                    tree.Costs[ToUnderlying(i)] = bin.Area();
+                    if (i + 1 < count)
+                    {
+                        LinkInteriorNode(tree, codes, std::int64_t(ToUnderlying(i)));
+                    }
+                }
+            });
+
+            // Note(3011): Every pass walks up from all the leaves, the first
+            // of the two children to get to a node stops there and the second
+            // one goes on, so the children are done by then. The nodes a
+            // treelet touches all belong to the subtree of its root, no other
+            // thread gets there anymore.
+            std::vector<std::atomic<std::uint32_t>> visits(leafCount - 1);
+            SizeType passes = Max(settings.TreeletRounds, SizeType(1));
+            for (SizeType pass = 0; pass < passes; ++pass)
+            {
+                bool restructure = pass < settings.TreeletRounds;
+                std::size_t minCount = LinearTree::TreeletLeaves << ToUnderlying(Min(pass, SizeType(32)));
+                for (std::atomic<std::uint32_t>& visit : visits)
+                {
+                    visit.store(0, std::memory_order_relaxed);
+                }
+
+                ForChunks(pool, 0, count, [&]([[maybe_unused]] SizeType chunk, SizeType begin, SizeType end)
+                {
+                    for (SizeType i = begin; i < end; ++i)
+                    {
+                        std::uint32_t node = tree.Parents[ToUnderlying(i)];
+                        while (node != LinearTree::NoNode)
+                        {
+                            if (visits[node - leafCount].fetch_add(1, std::memory_order_acq_rel) == 0)
+                            {
+                                break;
+                            }
+
+                            tree.Refit(node);
+                            if (restructure && tree.Bins[node].Count >= minCount)
+                            {
+                                tree.RestructureTreelet(node);
+                            }
+                            node = tree.Parents[node];
+                        }
+                    }
+                });
+            }
+
+            std::vector<u32> order;
+            order.reserve(leafCount);
+            mNodes.reserve(2 * leafCount - 1);
+            EmitLinear(tree, root, 0, order);
+            mIndices = std::move(order);
+        }
+
+        // Note(3011): Stores the subtree of node depth first and returns where
+        // it went. Subtrees that are cheaper as a leaf, or too deep, become
+        // leaves with their primitives in tree order.
+        u32 EmitLinear(LinearTree& tree, std::uint32_t node, SizeType depth, std::vector<u32>& order)
+        {
+            const Bin& bin = tree.Bins[node];
+            u32 result = Cast<u32>(mNodes.size());
+            NodeType& emitted = mNodes.emplace_back();
+            emitted.Bounds.Min = Point<Float>(Float(bin.Min[0]), Float(bin.Min[1]), Float(bin.Min[2]));
+            emitted.Bounds.Max = Point<Float>(Float(bin.Max[0]), Float(bin.Max[1]), Float(bin.Max[2]));
+
+            if (!tree.IsLeaf(node) && depth + 1 < MaxDepth && tree.Costs[node] != tree.LeafCost(bin))
+            {
+                std::array<std::uint32_t, 2> children = tree.ChildrenOf(node);
+                EmitLinear(tree, children[0], depth + 1, order);
+                u32 second = EmitLinear(tree, children[1], depth + 1, order);
+                mNodes[ToUnderlying(result)].Offset = second;
+                return result;
+            }
+
+            // Note(3011): Walks the leaves of the subtree left to right through
+            // the parents, which needs no stack.
+            u32 offset = Cast<u32>(order.size());
+            std::uint32_t current = node;
+            while (true)
+            {
+                while (!tree.IsLeaf(current))
+                {
+                    current = tree.ChildrenOf(current)[0];
+                }
+                order.push_back(mIndices[current]);
+
+                while (current != node && tree.ChildrenOf(tree.Parents[current])[1] == current)
+                {
+                    current = tree.Parents[current];
+                }
+
+                if (current == node)
+                {
+                    break;
+                }
+                current = tree.ChildrenOf(tree.Parents[current])[1];
+            }
+            mNodes[ToUnderlying(result)].Offset = offset;
+            mNodes[ToUnderlying(result)].Count = Cast<u32>(order.size()) - offset;
+            return result;
+        }
+
+        std::vector<NodeType> mNodes;
+        std::vector<PrimitiveType> mPrimitives;
+        std::vector<u32> mIndices;
+    };
+
+    template <typename PrimitiveType>
+    [[nodiscard]]
+    BVHIntersection<typename PrimitiveType::ScalarType> NearestIntersection(const Ray<typename PrimitiveType::ScalarType>& ray,
+                                                                            const Interval<typename PrimitiveType::ScalarType>& interval,
+                                                                            const BVH<PrimitiveType>& bvh) noexcept
+    {
+        return bvh.NearestIntersection(ray, interval);
+    }
+
+    template <typename PrimitiveType>
+    [[nodiscard]]
+    bool HasIntersection(const Ray<typename PrimitiveType::ScalarType>& ray,
+                         const Interval<typename PrimitiveType::ScalarType>& interval,
+                         const BVH<PrimitiveType>& bvh) noexcept
+    {
+        return bvh.HasIntersection(ray, interval);
+    }
+
+    template <typename PrimitiveType, SizeType N>
+        requires (N <= 32)
+    [[nodiscard]]
+    BVHIntersectionPacket<typename PrimitiveType::ScalarType, N> NearestIntersection(const RayPacket<typename PrimitiveType::ScalarType, N>& rays,
+                                                                                     const Interval<typename PrimitiveType::ScalarType>& interval,
+                                                                                     const BVH<PrimitiveType>& bvh) noexcept
+    {
+        return bvh.NearestIntersection(rays, interval);
+    }
+
+    template <typename PrimitiveType, SizeType N>
+        requires (N <= 32)
+    [[nodiscard]]
+    u32 HasIntersection(const RayPacket<typename PrimitiveType::ScalarType, N>& rays,
+                        const Interval<typename PrimitiveType::ScalarType>& interval,
+                        const BVH<PrimitiveType>& bvh) noexcept
+    {
+        return bvh.HasIntersection(rays, interval);
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_GEOMETRY_BVH_HPP
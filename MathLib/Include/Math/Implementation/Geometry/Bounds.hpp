@@ -0,0 +1,118 @@
+#ifndef MATHLIB_IMPLEMENTATION_GEOMETRY_BOUNDS_HPP
+#define MATHLIB_IMPLEMENTATION_GEOMETRY_BOUNDS_HPP
+
+#include "Shapes.hpp"
+#include "../Functions/IntUtils.hpp"
+
+namespace Math::Geometry
+{
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Box<T> BoundingBox(const Point<T>& point) noexcept
+    {
+        return Box<T>(point, point);
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Box<T> BoundingBox(const Triangle<T>& triangle) noexcept
+    {
+        Point<T> min(
+            Min(triangle.A.x, triangle.B.x, triangle.C.x),
+            Min(triangle.A.y, triangle.B.y, triangle.C.y),
+            Min(triangle.A.z, triangle.B.z, triangle.C.z)
+        );
+
+        Point<T> max(
+            Max(triangle.A.x, triangle.B.x, triangle.C.x),
+            Max(triangle.A.y, triangle.B.y, triangle.C.y),
+            Max(triangle.A.z, triangle.B.z, triangle.C.z)
+        );
+
+        return Box<T>(min, max);
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Box<T> BoundingBox(const Sphere<T>& sphere) noexcept
+    {
+        Point<T> min = sphere.Center - Vector3T<T>(sphere.Radius);
+        Point<T> max = sphere.Center + Vector3T<T>(sphere.Radius);
+        return Box<T>(min, max);
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Box<T> BoundingBox(const Box<T>& box) noexcept
+    {
+        return Box<T>(box.Min, box.Max);
+    }
+
+    // Note(3011): The corners are assigned directly, the constructor of Box
+    // would sort them again, and this runs for every primitive of every node
+    // while building a BVH.
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Box<T> Union(const Box<T>& first, const Box<T>& second) noexcept
+    {
+        Box<T> result = first;
+        result.Min = Point<T>(
+            Min(first.Min.x, second.Min.x),
+            Min(first.Min.y, second.Min.y),
+            Min(first.Min.z, second.Min.z)
+        );
+
+        result.Max = Point<T>(
+            Max(first.Max.x, second.Max.x),
+            Max(first.Max.y, second.Max.y),
+            Max(first.Max.z, second.Max.z)
+        );
+
+        return result;
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Box<T> Union(const Box<T>& box, const Point<T>& point) noexcept
+    {
+        return Union(box, Box<T>(point, point));
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Point<T> Centroid(const Box<T>& box) noexcept
+    {
+        return box.Min + (box.Max - box.Min) * Cast<T>(0.5);
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    T SurfaceArea(const Box<T>& box) noexcept
+    {
+        Vector3T<T> extent = box.Max - box.Min;
+        return Cast<T>(2) * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
+    // Note(3011): The Morton code of the cell holding point, in a grid over
+    // bounds with 2^10 (u32 codes) or 2^21 (u64 codes) cells along every
+    // axis. Points outside of the bounds end up in the border cells, flat
+    // axes of the bounds in the first one.
+    template <Concept::UnsignedIntegralType Int, Concept::StrongFloatType T>
+        requires (sizeof(Int) == 4 || sizeof(Int) == 8)
+    [[nodiscard]] constexpr
+    Int MortonCode(const Point<T>& point, const Box<T>& bounds) noexcept
+    {
+        constexpr Int cells = Int(1) << ((sizeof(Int) == 4) ? 10 : 21);
+
+        Array<Int, 3> cell;
+        for (SizeType axis = 0; axis < 3; ++axis)
+        {
+            T extent = bounds.Max[axis] - bounds.Min[axis];
+            T scaled = (extent > Cast<T>(0)) ? (point[axis] - bounds.Min[axis]) * (Cast<T>(cells) / extent) : Cast<T>(0);
+            cell[axis] = Cast<Int>(Clamp(scaled, Cast<T>(0), Cast<T>(cells - 1)));
+        }
+        return Math::MortonCode(cell[0], cell[1], cell[2]);
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_GEOMETRY_BOUNDS_HPP
@@ -3,53 +3,390 @@
 
 #include "Shapes.hpp"
 
-namespace Math::Geometry
+namespace Math::Implementation
 {
+    // Note(3011): The exit distances of the slab test are scaled up by a few
+    // ulps, rounding in the subtraction and the multiplication cannot make a
+    // ray that grazes a box miss it then (T. Ize, "Robust BVH Ray Traversal",
+    // 2013).
+    template <Concept::StrongFloatType T>
+    inline constexpr T SlabExitScale = Cast<T>(1) + Cast<T>(4) * T::Epsilon();
+
     template <Concept::StrongFloatType T>
     [[nodiscard]] constexpr
-    Intersection<T> NearestIntersection(const Ray<T> &ray, const Interval<T>& interval, const Plane<T>& plane) noexcept
+    const Point3T<T>& BoxCorner(const Geometry::Box<T>& box, u32 index) noexcept
+    {
+        return (index == 0) ? box.Min : box.Max;
+    }
+
+    template <Concept::StrongType T, SizeType N>
+    [[nodiscard]] constexpr
+    const Array<T, N>& PacketComponent(const Vector3PacketT<T, N>& packet, SizeType axis) noexcept
+    {
+        return (axis == 0) ? packet.x : (axis == 1) ? packet.y : packet.z;
+    }
+
+    // Note(3011): The slab test, clips [near, far] to the part of the ray
+    // inside the box. The ray misses the box (in that range) if near > far
+    // afterwards. The sign of the direction picks the entry and exit planes,
+    // so there is no Min/Max per axis. Zero direction components make the
+    // distances infinite, or NaN if the origin is on the plane, the NaNs go
+    // first in the comparisons so they never replace near or far, which
+    // counts the ray as inside the slab.
+    template <Concept::StrongFloatType T>
+    constexpr
+    void ClipToBox(const Geometry::Box<T>& box, const Geometry::RayPrecomputed<T>& ray, T& near, T& far) noexcept
+    {
+        for (SizeType axis = 0; axis < 3; ++axis)
+        {
+            T entry = (BoxCorner(box, ray.Sign[axis])[axis] - ray.Origin[axis]) * ray.InverseDirection[axis];
+            T exit = (BoxCorner(box, 1 - ray.Sign[axis])[axis] - ray.Origin[axis]) * ray.InverseDirection[axis];
+            near = Max(entry, near);
+            far = Min(exit * SlabExitScale<T>, far);
+        }
+    }
+
+    // Note(3011): ClipToBox for N boxes at once. The lanes run on the raw
+    // values with the axes spelled out, GCC does not vectorize the loop with
+    // strong type comparisons or with the planes picked per axis inside it.
+    template <Concept::StrongFloatType T, SizeType N>
+    constexpr
+    void ClipToBoxes(const Geometry::BoxPacket<T, N>& boxes, const Geometry::RayPrecomputed<T>& ray,
+                     Array<T, N>& near, Array<T, N>& far) noexcept
+    {
+        using Float = Math::UnderlyingType<T>;
+
+        auto planes = [&](SizeType axis, u32 side)
+        {
+            return reinterpret_cast<const Float*>(PacketComponent((ray.Sign[axis] == side) ? boxes.Min : boxes.Max, axis).Data());
+        };
+
+        const Float* entryX = planes(0, 0);
+        const Float* entryY = planes(1, 0);
+        const Float* entryZ = planes(2, 0);
+        const Float* exitX = planes(0, 1);
+        const Float* exitY = planes(1, 1);
+        const Float* exitZ = planes(2, 1);
+
+        Float originX = ToUnderlying(ray.Origin.x);
+        Float originY = ToUnderlying(ray.Origin.y);
+        Float originZ = ToUnderlying(ray.Origin.z);
+        Float inverseX = ToUnderlying(ray.InverseDirection.x);
+        Float inverseY = ToUnderlying(ray.InverseDirection.y);
+        Float inverseZ = ToUnderlying(ray.InverseDirection.z);
+        Float scale = ToUnderlying(SlabExitScale<T>);
+
+        Float* laneNear = reinterpret_cast<Float*>(near.Data());
+        Float* laneFar = reinterpret_cast<Float*>(far.Data());
+        for (std::size_t lane = 0; lane < ToUnderlying(N); ++lane)
+        {
+            Float tNear = laneNear[lane];
+            Float tFar = laneFar[lane];
+
+            Float entry = (entryX[lane] - originX) * inverseX;
+            Float exit = (exitX[lane] - originX) * inverseX * scale;
+            tNear = (entry > tNear) ? entry : tNear;
+            tFar = (exit < tFar) ? exit : tFar;
+
+            entry = (entryY[lane] - originY) * inverseY;
+            exit = (exitY[lane] - originY) * inverseY * scale;
+            tNear = (entry > tNear) ? entry : tNear;
+            tFar = (exit < tFar) ? exit : tFar;
+
+            entry = (entryZ[lane] - originZ) * inverseZ;
+            exit = (exitZ[lane] - originZ) * inverseZ * scale;
+            tNear = (entry > tNear) ? entry : tNear;
+            tFar = (exit < tFar) ? exit : tFar;
+
+            laneNear[lane] = tNear;
+            laneFar[lane] = tFar;
+        }
+    }
+
+    // Note(3011): ClipToBox for N rays and one box. The slab planes are
+    // picked per lane by the sign of the inverse direction, as Sign does for
+    // a single ray, and NaN distances are dropped the same way.
+    template <Concept::StrongFloatType T, SizeType N>
+    constexpr
+    void ClipRaysToBox(const Geometry::Box<T>& box, const Geometry::RayPacket<T, N>& rays,
+                       Array<T, N>& near, Array<T, N>& far) noexcept
+    {
+        using Float = Math::UnderlyingType<T>;
+
+        const Float* originX = reinterpret_cast<const Float*>(rays.Origin.x.Data());
+        const Float* originY = reinterpret_cast<const Float*>(rays.Origin.y.Data());
+        const Float* originZ = reinterpret_cast<const Float*>(rays.Origin.z.Data());
+        const Float* inverseX = reinterpret_cast<const Float*>(rays.InverseDirection.x.Data());
+        const Float* inverseY = reinterpret_cast<const Float*>(rays.InverseDirection.y.Data());
+        const Float* inverseZ = reinterpret_cast<const Float*>(rays.InverseDirection.z.Data());
+
+        Float minX = ToUnderlying(box.Min.x);
+        Float minY = ToUnderlying(box.Min.y);
+        Float minZ = ToUnderlying(box.Min.z);
+        Float maxX = ToUnderlying(box.Max.x);
+        Float maxY = ToUnderlying(box.Max.y);
+        Float maxZ = ToUnderlying(box.Max.z);
+        Float scale = ToUnderlying(SlabExitScale<T>);
+
+        Float* laneNear = reinterpret_cast<Float*>(near.Data());
+        Float* laneFar = reinterpret_cast<Float*>(far.Data());
+        for (std::size_t lane = 0; lane < ToUnderlying(N); ++lane)
+        {
+            Float tNear = laneNear[lane];
+            Float tFar = laneFar[lane];
+
+            bool negative = inverseX[lane] < Float(0);
+            Float entry = ((negative ? maxX : minX) - originX[lane]) * inverseX[lane];
+            Float exit = ((negative ? minX : maxX) - originX[lane]) * inverseX[lane] * scale;
+            tNear = (entry > tNear) ? entry : tNear;
+            tFar = (exit < tFar) ? exit : tFar;
+
+            negative = inverseY[lane] < Float(0);
+            entry = ((negative ? maxY : minY) - originY[lane]) * inverseY[lane];
+            exit = ((negative ? minY : maxY) - originY[lane]) * inverseY[lane] * scale;
+            tNear = (entry > tNear) ? entry : tNear;
+            tFar = (exit < tFar) ? exit : tFar;
+
+            negative = inverseZ[lane] < Float(0);
+            entry = ((negative ? maxZ : minZ) - originZ[lane]) * inverseZ[lane];
+            exit = ((negative ? minZ : maxZ) - originZ[lane]) * inverseZ[lane] * scale;
+            tNear = (entry > tNear) ? entry : tNear;
+            tFar = (exit < tFar) ? exit : tFar;
+
+            laneNear[lane] = tNear;
+            laneFar[lane] = tFar;
+        }
+    }
+
+    // Note(3011): The sphere test for N rays, the same arithmetic as the
+    // scalar test, without the branches.
+    template <Concept::StrongFloatType T, SizeType N>
+    constexpr
+    void IntersectRaysWithSphere(const Geometry::Sphere<T>& sphere, const Geometry::RayPacket<T, N>& rays,
+                                 const Geometry::Interval<T>& interval, Array<T, N>& distances) noexcept
+    {
+        using Float = Math::UnderlyingType<T>;
+
+        const Float* originX = reinterpret_cast<const Float*>(rays.Origin.x.Data());
+        const Float* originY = reinterpret_cast<const Float*>(rays.Origin.y.Data());
+        const Float* originZ = reinterpret_cast<const Float*>(rays.Origin.z.Data());
+        const Float* directionX = reinterpret_cast<const Float*>(rays.Direction.x.Data());
+        const Float* directionY = reinterpret_cast<const Float*>(rays.Direction.y.Data());
+        const Float* directionZ = reinterpret_cast<const Float*>(rays.Direction.z.Data());
+
+        Float centerX = ToUnderlying(sphere.Center.x);
+        Float centerY = ToUnderlying(sphere.Center.y);
+        Float centerZ = ToUnderlying(sphere.Center.z);
+        Float radiusSquared = ToUnderlying(Squared(sphere.Radius));
+        Float min = ToUnderlying(interval.Min);
+        Float max = ToUnderlying(interval.Max);
+        Float nan = ToUnderlying(T::NaN());
+
+        Float* result = reinterpret_cast<Float*>(distances.Data());
+        for (std::size_t lane = 0; lane < ToUnderlying(N); ++lane)
+        {
+            Float ox = originX[lane] - centerX;
+            Float oy = originY[lane] - centerY;
+            Float oz = originZ[lane] - centerZ;
+            Float dx = directionX[lane];
+            Float dy = directionY[lane];
+            Float dz = directionZ[lane];
+
+            Float a = dx * dx + dy * dy + dz * dz;
+            Float b = Float(2) * (dx * ox + dy * oy + dz * oz);
+            Float c = (ox * ox + oy * oy + oz * oz) - radiusSquared;
+            Float discriminant = b * b - Float(4) * a * c;
+
+            // Note(3011): Negative discriminants turn into NaN distances,
+            // which fail every comparison below.
+            Float discriminantSqrt = ToUnderlying(Sqrt(T(discriminant)));
+            Float a2 = Float(2) * a;
+            Float t0 = (-b + discriminantSqrt) / a2;
+            Float t1 = (-b - discriminantSqrt) / a2;
+
+            Float nearer = (t0 < t1) ? t0 : t1;
+            Float further = (t0 > t1) ? t0 : t1;
+            bool nearerValid = (min <= nearer) && (nearer <= max);
+            bool furtherValid = (min <= further) && (further <= max);
+            result[lane] = nearerValid ? nearer : (furtherValid ? further : nan);
+        }
+    }
+
+    // Note(3011): Moller-Trumbore for N rays against one triangle given by a
+    // vertex and the edges from it.
+    template <Concept::StrongFloatType T, SizeType N>
+    constexpr
+    void MollerTrumboreRays(const Geometry::RayPacket<T, N>& rays, const Geometry::Interval<T>& interval,
+                            const Point3T<T>& vertex, const Vector3T<T>& edge1, const Vector3T<T>& edge2,
+                            Geometry::IntersectionPacket<T, N>& result) noexcept
+    {
+        using Float = Math::UnderlyingType<T>;
+
+        const Float* originX = reinterpret_cast<const Float*>(rays.Origin.x.Data());
+        const Float* originY = reinterpret_cast<const Float*>(rays.Origin.y.Data());
+        const Float* originZ = reinterpret_cast<const Float*>(rays.Origin.z.Data());
+        const Float* directionX = reinterpret_cast<const Float*>(rays.Direction.x.Data());
+        const Float* directionY = reinterpret_cast<const Float*>(rays.Direction.y.Data());
+        const Float* directionZ = reinterpret_cast<const Float*>(rays.Direction.z.Data());
+
+        Float ax = ToUnderlying(vertex.x);
+        Float ay = ToUnderlying(vertex.y);
+        Float az = ToUnderlying(vertex.z);
+        Float e1x = ToUnderlying(edge1.x);
+        Float e1y = ToUnderlying(edge1.y);
+        Float e1z = ToUnderlying(edge1.z);
+        Float e2x = ToUnderlying(edge2.x);
+        Float e2y = ToUnderlying(edge2.y);
+        Float e2z = ToUnderlying(edge2.z);
+        Float min = ToUnderlying(interval.Min);
+        Float max = ToUnderlying(interval.Max);
+        Float nan = ToUnderlying(T::NaN());
+
+        Float* distances = reinterpret_cast<Float*>(result.Distance.Data());
+        Float* us = reinterpret_cast<Float*>(result.U.Data());
+        Float* vs = reinterpret_cast<Float*>(result.V.Data());
+        for (std::size_t lane = 0; lane < ToUnderlying(N); ++lane)
+        {
+            Float dx = directionX[lane];
+            Float dy = directionY[lane];
+            Float dz = directionZ[lane];
+
+            Float px = dy * e2z - dz * e2y;
+            Float py = dz * e2x - dx * e2z;
+            Float pz = dx * e2y - dy * e2x;
+            Float det = e1x * px + e1y * py + e1z * pz;
+            Float inverseDet = Float(1) / det;
+
+            Float sx = originX[lane] - ax;
+            Float sy = originY[lane] - ay;
+            Float sz = originZ[lane] - az;
+            Float u = (sx * px + sy * py + sz * pz) * inverseDet;
+
+            Float qx = sy * e1z - sz * e1y;
+            Float qy = sz * e1x - sx * e1z;
+            Float qz = sx * e1y - sy * e1x;
+            Float v = (dx * qx + dy * qy + dz * qz) * inverseDet;
+            Float distance = (e2x * qx + e2y * qy + e2z * qz) * inverseDet;
+
+            bool valid = (det != Float(0)) && !(u < Float(0)) && !(u > Float(1)) && !(v < Float(0)) && !(u + v > Float(1))
+                      && (min <= distance) && (distance <= max);
+            distances[lane] = valid ? distance : nan;
+            us[lane] = valid ? u : Float(0);
+            vs[lane] = valid ? v : Float(0);
+        }
+    }
+
+    // Note(3011): Edges from a to the other two vertices, meshes keep those
+    // precomputed.
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Geometry::Intersection<T> MollerTrumbore(const Point3T<T>& origin, const Vector3T<T>& direction, const Geometry::Interval<T>& interval,
+                                             const Point3T<T>& a, const Vector3T<T>& edge1, const Vector3T<T>& edge2) noexcept
     {
         using Float = T;
+        using VectorType = Vector3T<T>;
 
-        Float cosIncidence = Dot(ray.Direction, plane.Normal);
-        if (Equal(cosIncidence, Cast<Float>(0), Math::Constant::GeometryEpsilon<Float>))
+        VectorType p = Cross(direction, edge2);
+        Float det = Dot(edge1, p);
+        if (det == Cast<Float>(0))
         {
-            if (Equal(Dot(plane.Normal, plane.Origin - ray.Origin), Cast<Float>(0), Math::Constant::GeometryEpsilon<Float>))
-            {
-                return Intersection<Float>(Cast<Float>(0));
-            }
-            else
-            {
-                return Intersection<Float>(Float::NaN());
-            }
+            return Geometry::Intersection<Float>(Float::NaN());
         }
 
-        Float distance = Dot(plane.Normal, plane.Origin - ray.Origin) / cosIncidence;
-        return Intersection<Float>(interval.Pick(distance));
+        Float inverseDet = Cast<Float>(1) / det;
+        VectorType s = origin - a;
+        Float u = Dot(s, p) * inverseDet;
+        if (u < Cast<Float>(0) || u > Cast<Float>(1))
+        {
+            return Geometry::Intersection<Float>(Float::NaN());
+        }
+
+        VectorType q = Cross(s, edge1);
+        Float v = Dot(direction, q) * inverseDet;
+        if (v < Cast<Float>(0) || u + v > Cast<Float>(1))
+        {
+            return Geometry::Intersection<Float>(Float::NaN());
+        }
+
+        return Geometry::Intersection<Float>(interval.Pick(Dot(edge2, q) * inverseDet), u, v);
     }
 
     template <Concept::StrongFloatType T>
     [[nodiscard]] constexpr
-    Intersection<T> NearestIntersection(const Ray<T>& ray, const Interval<T>& interval, const Triangle<T>& triangle) noexcept
+    Geometry::Intersection<T> MollerTrumbore(const Point3T<T>& origin, const Vector3T<T>& direction,
+                                             const Geometry::Interval<T>& interval, const Geometry::Triangle<T>& triangle) noexcept
+    {
+        return MollerTrumbore(origin, direction, interval, triangle.A, triangle.B - triangle.A, triangle.C - triangle.A);
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Geometry::Intersection<T> Watertight(const Geometry::RayPrecomputed<T>& ray, const Geometry::Interval<T>& interval,
+                                         const Geometry::Triangle<T>& triangle) noexcept
     {
         using Float = T;
-        using PointType = typename Ray<Float>::PointType;
-        using VectorType = typename Ray<Float>::VectorType;
+        using VectorType = Vector3T<T>;
+
+        SizeType kx = ray.Axes[0];
+        SizeType ky = ray.Axes[1];
+        SizeType kz = ray.Axes[2];
+
+        VectorType a = triangle.A - ray.Origin;
+        VectorType b = triangle.B - ray.Origin;
+        VectorType c = triangle.C - ray.Origin;
 
-        VectorType u = triangle.B - triangle.A;
-        VectorType v = triangle.C - triangle.A;
+        Float ax = a[kx] - ray.Shear.x * a[kz];
+        Float ay = a[ky] - ray.Shear.y * a[kz];
+        Float bx = b[kx] - ray.Shear.x * b[kz];
+        Float by = b[ky] - ray.Shear.y * b[kz];
+        Float cx = c[kx] - ray.Shear.x * c[kz];
+        Float cy = c[ky] - ray.Shear.y * c[kz];
 
-        VectorType normal = Cross(u, v);
-        if (Equal(normal, VectorType(Cast<Float>(0))))
+        Float u = cx * by - cy * bx;
+        Float v = ax * cy - ay * cx;
+        Float w = bx * ay - by * ax;
+
+        if constexpr (sizeof(Float) < sizeof(f64))
         {
-            return Intersection<Float>(Float::NaN());
+            if (u == Cast<Float>(0) || v == Cast<Float>(0) || w == Cast<Float>(0))
+            {
+                u = Cast<Float>(Cast<f64>(cx) * Cast<f64>(by) - Cast<f64>(cy) * Cast<f64>(bx));
+                v = Cast<Float>(Cast<f64>(ax) * Cast<f64>(cy) - Cast<f64>(ay) * Cast<f64>(cx));
+                w = Cast<Float>(Cast<f64>(bx) * Cast<f64>(ay) - Cast<f64>(by) * Cast<f64>(ax));
+            }
+        }
+
+        bool anyNegative = u < Cast<Float>(0) || v < Cast<Float>(0) || w < Cast<Float>(0);
+        bool anyPositive = u > Cast<Float>(0) || v > Cast<Float>(0) || w > Cast<Float>(0);
+        if (anyNegative && anyPositive)
+        {
+            return Geometry::Intersection<Float>(Float::NaN());
         }
 
-        Float a = -Dot(normal, ray.Origin - triangle.A);
-        Float b = Dot(normal, ray.Direction);
-        if (Equal(b, Cast<Float>(0), Constant::GeometryEpsilon<Float>))
+        Float det = u + v + w;
+        if (det == Cast<Float>(0))
         {
-            if (Equal(a, Cast<Float>(0), Constant::GeometryEpsilon<Float>))
+            return Geometry::Intersection<Float>(Float::NaN());
+        }
+
+        Float distance = (u * a[kz] + v * b[kz] + w * c[kz]) * ray.Shear.z;
+        Float inverseDet = Cast<Float>(1) / det;
+        return Geometry::Intersection<Float>(interval.Pick(distance * inverseDet), v * inverseDet, w * inverseDet);
+    }
+}
+
+namespace Math::Geometry
+{
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Intersection<T> NearestIntersection(const Ray<T> &ray, const Interval<T>& interval, const Plane<T>& plane) noexcept
+    {
+        using Float = T;
+
+        Float cosIncidence = Dot(ray.Direction, plane.Normal);
+        if (Equal(cosIncidence, Cast<Float>(0), Math::Constant::GeometryEpsilon<Float>))
+        {
+            if (Equal(Dot(plane.Normal, plane.Origin - ray.Origin), Cast<Float>(0), Math::Constant::GeometryEpsilon<Float>))
             {
                 return Intersection<Float>(Cast<Float>(0));
             }
@@ -59,25 +396,58 @@ namespace Math::Geometry
             }
         }
 
-        Float distance = a / b;
-        if (distance < Cast<Float>(0))
+        Float distance = Dot(plane.Normal, plane.Origin - ray.Origin) / cosIncidence;
+        return Intersection<Float>(interval.Pick(distance));
+    }
+
+    // Note(3011):
+    // The two triangle tests, both report the barycentric coordinates of the
+    // hit and count hits from both sides.
+    //
+    // - MollerTrumbore (T. Moller, B. Trumbore, "Fast, Minimum Storage
+    //   Ray/Triangle Intersection", 1997) solves for the distance and the
+    //   barycentrics directly with Cramer's rule, two cross products and a
+    //   division. Rays through a shared edge or vertex can slip through both
+    //   triangles because of rounding.
+    // - Watertight (S. Woop, C. Benthin, I. Wald, "Watertight Ray/Triangle
+    //   Intersection", 2013) shears the triangle into the space of the ray
+    //   and tests the edges there, with an f64 fallback for f32 when an edge
+    //   function is exactly 0. Neighbouring triangles never both miss a ray
+    //   through their shared edge, which is what closed meshes need, at a
+    //   slightly higher cost.
+    enum class TriangleTest
+    {
+        MollerTrumbore,
+        Watertight
+    };
+
+    template <TriangleTest Test = TriangleTest::MollerTrumbore, Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Intersection<T> NearestIntersection(const RayPrecomputed<T>& ray, const Interval<T>& interval, const Triangle<T>& triangle) noexcept
+    {
+        if constexpr (Test == TriangleTest::MollerTrumbore)
         {
-            return Intersection<Float>(Float::NaN());
+            return Implementation::MollerTrumbore(ray.Origin, ray.Direction, interval, triangle);
         }
+        else
+        {
+            return Implementation::Watertight(ray, interval, triangle);
+        }
+    }
 
-        PointType intersect = ray.Project(distance);
-        VectorType w = intersect - triangle.A;
-        Float det = Squared(Dot(u, v)) - u.LenSqr() * v.LenSqr();
-        Float s = (Dot(u, v) * Dot(w, v) - v.LenSqr() * Dot(u, w)) / det;
-        Float t = (Dot(u, v) * Dot(u, w) - u.LenSqr() * Dot(w, v)) / det;
-
-        if (s > Cast<Float>(0) && t > Cast<Float>(0) && (s + t) <= Cast<Float>(1))
+    // Note(3011): Moller-Trumbore only needs the direction, the precomputation
+    // would only add divisions.
+    template <TriangleTest Test = TriangleTest::MollerTrumbore, Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Intersection<T> NearestIntersection(const Ray<T>& ray, const Interval<T>& interval, const Triangle<T>& triangle) noexcept
+    {
+        if constexpr (Test == TriangleTest::MollerTrumbore)
         {
-            return Intersection<Float>(interval.Pick(distance));
+            return Implementation::MollerTrumbore(ray.Origin, ray.Direction, interval, triangle);
         }
         else
         {
-            return Intersection<Float>(Float::NaN());
+            return Implementation::Watertight(RayPrecomputed<T>(ray), interval, triangle);
         }
     }
 
@@ -109,6 +479,202 @@ namespace Math::Geometry
         Float distance = interval.Pick(t0, t1);
         return Intersection<Float>(distance);
     }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Intersection<T> NearestIntersection(const RayPrecomputed<T>& ray, const Interval<T>& interval, const Box<T>& box) noexcept
+    {
+        using Float = T;
+
+        Float near = -Float::Infinity();
+        Float far = Float::Infinity();
+        Implementation::ClipToBox(box, ray, near, far);
+        if (near > far)
+        {
+            return Intersection<Float>(Float::NaN());
+        }
+
+        return Intersection<Float>(interval.Pick(near, far));
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    Intersection<T> NearestIntersection(const Ray<T>& ray, const Interval<T>& interval, const Box<T>& box) noexcept
+    {
+        return NearestIntersection(RayPrecomputed<T>(ray), interval, box);
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    bool HasIntersection(const RayPrecomputed<T>& ray, const Interval<T>& interval, const Box<T>& box) noexcept
+    {
+        T near = interval.Min;
+        T far = interval.Max;
+        Implementation::ClipToBox(box, ray, near, far);
+        return near <= far;
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    bool HasIntersection(const Ray<T>& ray, const Interval<T>& interval, const Box<T>& box) noexcept
+    {
+        return HasIntersection(RayPrecomputed<T>(ray), interval, box);
+    }
+
+    // Note(3011): The packet versions test one ray against N boxes (4 or 8
+    // map onto SSE and AVX registers for f32). Lanes that miss are NaN in the
+    // distances and 0 in the mask, bit i of the mask is lane i.
+    template <Concept::StrongFloatType T, SizeType N>
+    [[nodiscard]] constexpr
+    Array<T, N> NearestIntersection(const RayPrecomputed<T>& ray, const Interval<T>& interval, const BoxPacket<T, N>& boxes) noexcept
+    {
+        using Float = UnderlyingType<T>;
+
+        Array<T, N> near;
+        Array<T, N> far;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            near[lane] = -T::Infinity();
+            far[lane] = T::Infinity();
+        }
+        Implementation::ClipToBoxes(boxes, ray, near, far);
+
+        Float min = ToUnderlying(interval.Min);
+        Float max = ToUnderlying(interval.Max);
+        Float nan = ToUnderlying(T::NaN());
+
+        Array<T, N> result;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            Float laneNear = ToUnderlying(near[lane]);
+            Float laneFar = ToUnderlying(far[lane]);
+            Float distance = (laneNear >= min) ? laneNear : laneFar;
+            bool valid = (laneNear <= laneFar) && (min <= distance) && (distance <= max);
+            result[lane] = T(valid ? distance : nan);
+        }
+        return result;
+    }
+
+    template <Concept::StrongFloatType T, SizeType N>
+        requires (N <= 32)
+    [[nodiscard]] constexpr
+    u32 HasIntersection(const RayPrecomputed<T>& ray, const Interval<T>& interval, const BoxPacket<T, N>& boxes) noexcept
+    {
+        Array<T, N> near;
+        Array<T, N> far;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            near[lane] = interval.Min;
+            far[lane] = interval.Max;
+        }
+        Implementation::ClipToBoxes(boxes, ray, near, far);
+
+        std::uint32_t mask = 0;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            mask |= ((ToUnderlying(near[lane]) <= ToUnderlying(far[lane])) ? 1u : 0u) << ToUnderlying(lane);
+        }
+        return u32(mask);
+    }
+
+    // Note(3011):
+    // The ray packet versions test N rays against one shape, the lanes of the
+    // result match the lanes of the packet. They compute every lane, the
+    // callers mask out the lanes they do not care about. The results agree
+    // with the scalar tests on the same rays.
+    //
+    // Only Moller-Trumbore has a packet form, the watertight test picks its
+    // axes per ray, so it tests the lanes one by one.
+    template <Concept::StrongFloatType T, SizeType N>
+    [[nodiscard]] constexpr
+    IntersectionPacket<T, N> NearestIntersection(const RayPacket<T, N>& rays, const Interval<T>& interval, const Box<T>& box) noexcept
+    {
+        using Float = UnderlyingType<T>;
+
+        Array<T, N> near;
+        Array<T, N> far;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            near[lane] = -T::Infinity();
+            far[lane] = T::Infinity();
+        }
+        Implementation::ClipRaysToBox(box, rays, near, far);
+
+        Float min = ToUnderlying(interval.Min);
+        Float max = ToUnderlying(interval.Max);
+        Float nan = ToUnderlying(T::NaN());
+
+        IntersectionPacket<T, N> result;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            Float laneNear = ToUnderlying(near[lane]);
+            Float laneFar = ToUnderlying(far[lane]);
+            Float distance = (laneNear >= min) ? laneNear : laneFar;
+            bool valid = (laneNear <= laneFar) && (min <= distance) && (distance <= max);
+            result.Distance[lane] = T(valid ? distance : nan);
+            result.U[lane] = Cast<T>(0);
+            result.V[lane] = Cast<T>(0);
+        }
+        return result;
+    }
+
+    template <Concept::StrongFloatType T, SizeType N>
+        requires (N <= 32)
+    [[nodiscard]] constexpr
+    u32 HasIntersection(const RayPacket<T, N>& rays, const Interval<T>& interval, const Box<T>& box) noexcept
+    {
+        Array<T, N> near;
+        Array<T, N> far;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            near[lane] = interval.Min;
+            far[lane] = interval.Max;
+        }
+        Implementation::ClipRaysToBox(box, rays, near, far);
+
+        std::uint32_t mask = 0;
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            mask |= ((ToUnderlying(near[lane]) <= ToUnderlying(far[lane])) ? 1u : 0u) << ToUnderlying(lane);
+        }
+        return u32(mask);
+    }
+
+    template <Concept::StrongFloatType T, SizeType N>
+    [[nodiscard]] constexpr
+    IntersectionPacket<T, N> NearestIntersection(const RayPacket<T, N>& rays, const Interval<T>& interval, const Sphere<T>& sphere) noexcept
+    {
+        IntersectionPacket<T, N> result;
+        Implementation::IntersectRaysWithSphere(sphere, rays, interval, result.Distance);
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            result.U[lane] = Cast<T>(0);
+            result.V[lane] = Cast<T>(0);
+        }
+        return result;
+    }
+
+    template <TriangleTest Test = TriangleTest::MollerTrumbore, Concept::StrongFloatType T, SizeType N>
+    [[nodiscard]] constexpr
+    IntersectionPacket<T, N> NearestIntersection(const RayPacket<T, N>& rays, const Interval<T>& interval, const Triangle<T>& triangle) noexcept
+    {
+        IntersectionPacket<T, N> result;
+        if constexpr (Test == TriangleTest::MollerTrumbore)
+        {
+            Implementation::MollerTrumboreRays(rays, interval, triangle.A, triangle.B - triangle.A, triangle.C - triangle.A, result);
+        }
+        else
+        {
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                Intersection<T> hit = Implementation::Watertight(RayPrecomputed<T>(rays.Get(lane)), interval, triangle);
+                result.Distance[lane] = hit.Distance;
+                result.U[lane] = hit.U;
+                result.V[lane] = hit.V;
+            }
+        }
+        return result;
+    }
 }
 
 #endif //MATHLIB_IMPLEMENTATION_GEOMETRY_INTERSECTIONS_HPP
@@ -0,0 +1,298 @@
+#ifndef MATHLIB_IMPLEMENTATION_GEOMETRY_MESH_HPP
+#define MATHLIB_IMPLEMENTATION_GEOMETRY_MESH_HPP
+
+#include "Bounds.hpp"
+#include "Intersections.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Math::Geometry
+{
+    // Note(3011): What Moller-Trumbore needs of a triangle, the first vertex
+    // and the two edges from it, 36B per triangle for f32.
+    template <Concept::StrongFloatType T>
+    struct MeshTriangleData
+    {
+    public:
+        Point<T> A;
+        Vector3T<T> Edge1;
+        Vector3T<T> Edge2;
+    };
+
+    // Note(3011):
+    // An indexed triangle mesh, every vertex is stored once and the triangles
+    // refer to them by three u32 indices, with counter-clockwise winding
+    // around the geometric normal. The positions are kept as structure of
+    // arrays, the per vertex normals and texture coordinates are optional,
+    // pass empty spans to leave them out. Their sizes have to match the
+    // number of positions, and indices has to hold 3 valid indices per
+    // triangle, nothing checks that.
+    //
+    // The intersection tests do not go through the indices, the first vertex
+    // and the edges of every triangle are precomputed into a separate array,
+    // so the default (Moller-Trumbore) test reads one contiguous record per
+    // triangle. The watertight test has to use the shared vertices, the edges
+    // are not exact, so it reads the positions through the indices instead.
+
+    template <Concept::StrongFloatType T>
+    class TriangleMesh final
+    {
+    public:
+        using ScalarType = T;
+        using PointType = Point<T>;
+        using VectorType = Vector3T<T>;
+
+        [[nodiscard]]
+        TriangleMesh() noexcept = default;
+
+        [[nodiscard]]
+        TriangleMesh(std::span<const PointType> positions, std::span<const u32> indices,
+                     std::span<const VectorType> normals = {}, std::span<const Vector2T<T>> uvs = {})
+            : mIndices(indices.begin(), indices.end())
+            , mNormals(normals.begin(), normals.end())
+            , mUVs(uvs.begin(), uvs.end())
+        {
+            mX.reserve(positions.size());
+            mY.reserve(positions.size());
+            mZ.reserve(positions.size());
+            for (const PointType& position : positions)
+            {
+                mX.push_back(position.x);
+                mY.push_back(position.y);
+                mZ.push_back(position.z);
+            }
+
+            mTriangles.reserve(mIndices.size() / 3);
+            for (SizeType i = 0; i < TriangleCount(); ++i)
+            {
+                Triangle<T> triangle = GetTriangle(i);
+                mTriangles.push_back({ triangle.A, triangle.B - triangle.A, triangle.C - triangle.A });
+            }
+        }
+
+        [[nodiscard]]
+        SizeType VertexCount() const noexcept
+        {
+            return mX.size();
+        }
+
+        [[nodiscard]]
+        SizeType TriangleCount() const noexcept
+        {
+            return mIndices.size() / 3;
+        }
+
+        [[nodiscard]]
+        bool HasNormals() const noexcept
+        {
+            return !mNormals.empty();
+        }
+
+        [[nodiscard]]
+        bool HasUVs() const noexcept
+        {
+            return !mUVs.empty();
+        }
+
+        [[nodiscard]]
+        PointType Position(SizeType vertex) const noexcept
+        {
+            std::size_t i = ToUnderlying(vertex);
+            return PointType(mX[i], mY[i], mZ[i]);
+        }
+
+        [[nodiscard]]
+        Array<u32, 3> Indices(SizeType triangle) const noexcept
+        {
+            std::size_t i = ToUnderlying(triangle * 3);
+            return Array<u32, 3>(mIndices[i], mIndices[i + 1], mIndices[i + 2]);
+        }
+
+        [[nodiscard]]
+        Triangle<T> GetTriangle(SizeType triangle) const noexcept
+        {
+            Array<u32, 3> indices = Indices(triangle);
+            return Triangle<T>(Position(Cast<SizeType>(indices[0])),
+                               Position(Cast<SizeType>(indices[1])),
+                               Position(Cast<SizeType>(indices[2])));
+        }
+
+        [[nodiscard]]
+        const MeshTriangleData<T>& IntersectionData(SizeType triangle) const noexcept
+        {
+            return mTriangles[ToUnderlying(triangle)];
+        }
+
+        // Note(3011): The normal at barycentric coordinates (u, v) of the
+        // triangle, interpolated from the vertex normals if there are any,
+        // the geometric normal otherwise. Normalized either way.
+        [[nodiscard]]
+        VectorType Normal(SizeType triangle, T u, T v) const noexcept
+        {
+            if (!HasNormals())
+            {
+                const MeshTriangleData<T>& data = IntersectionData(triangle);
+                return Normalize(Cross(data.Edge1, data.Edge2));
+            }
+
+            Array<u32, 3> indices = Indices(triangle);
+            return Normalize(mNormals[ToUnderlying(indices[0])] * (Cast<T>(1) - u - v)
+                           + mNormals[ToUnderlying(indices[1])] * u
+                           + mNormals[ToUnderlying(indices[2])] * v);
+        }
+
+        // Note(3011): 0 if the mesh has no texture coordinates.
+        [[nodiscard]]
+        Vector2T<T> UV(SizeType triangle, T u, T v) const noexcept
+        {
+            if (!HasUVs())
+            {
+                return Vector2T<T>(Cast<T>(0));
+            }
+
+            Array<u32, 3> indices = Indices(triangle);
+            return mUVs[ToUnderlying(indices[0])] * (Cast<T>(1) - u - v)
+                 + mUVs[ToUnderlying(indices[1])] * u
+                 + mUVs[ToUnderlying(indices[2])] * v;
+        }
+
+        [[nodiscard]]
+        std::span<const T> PositionsX() const noexcept
+        {
+            return mX;
+        }
+
+        [[nodiscard]]
+        std::span<const T> PositionsY() const noexcept
+        {
+            return mY;
+        }
+
+        [[nodiscard]]
+        std::span<const T> PositionsZ() const noexcept
+        {
+            return mZ;
+        }
+
+        [[nodiscard]]
+        std::span<const u32> IndexBuffer() const noexcept
+        {
+            return mIndices;
+        }
+    private:
+        std::vector<T> mX;
+        std::vector<T> mY;
+        std::vector<T> mZ;
+        std::vector<u32> mIndices;
+        std::vector<VectorType> mNormals;
+        std::vector<Vector2T<T>> mUVs;
+        std::vector<MeshTriangleData<T>> mTriangles;
+    };
+
+    template <TriangleTest Test = TriangleTest::MollerTrumbore, Concept::StrongFloatType T>
+    [[nodiscard]]
+    Intersection<T> NearestIntersection(const RayPrecomputed<T>& ray, const Interval<T>& interval,
+                                        const TriangleMesh<T>& mesh, SizeType triangle) noexcept
+    {
+        if constexpr (Test == TriangleTest::MollerTrumbore)
+        {
+            const MeshTriangleData<T>& data = mesh.IntersectionData(triangle);
+            return Implementation::MollerTrumbore(ray.Origin, ray.Direction, interval, data.A, data.Edge1, data.Edge2);
+        }
+        else
+        {
+            return Implementation::Watertight(ray, interval, mesh.GetTriangle(triangle));
+        }
+    }
+
+    template <TriangleTest Test = TriangleTest::MollerTrumbore, Concept::StrongFloatType T>
+    [[nodiscard]]
+    Intersection<T> NearestIntersection(const Ray<T>& ray, const Interval<T>& interval,
+                                        const TriangleMesh<T>& mesh, SizeType triangle) noexcept
+    {
+        if constexpr (Test == TriangleTest::MollerTrumbore)
+        {
+            const MeshTriangleData<T>& data = mesh.IntersectionData(triangle);
+            return Implementation::MollerTrumbore(ray.Origin, ray.Direction, interval, data.A, data.Edge1, data.Edge2);
+        }
+        else
+        {
+            return Implementation::Watertight(RayPrecomputed<T>(ray), interval, mesh.GetTriangle(triangle));
+        }
+    }
+
+    template <TriangleTest Test = TriangleTest::MollerTrumbore, Concept::StrongFloatType T, SizeType N>
+    [[nodiscard]]
+    IntersectionPacket<T, N> NearestIntersection(const RayPacket<T, N>& rays, const Interval<T>& interval,
+                                                 const TriangleMesh<T>& mesh, SizeType triangle) noexcept
+    {
+        if constexpr (Test == TriangleTest::MollerTrumbore)
+        {
+            IntersectionPacket<T, N> result;
+            const MeshTriangleData<T>& data = mesh.IntersectionData(triangle);
+            Implementation::MollerTrumboreRays(rays, interval, data.A, data.Edge1, data.Edge2, result);
+            return result;
+        }
+        else
+        {
+            return NearestIntersection<Test>(rays, interval, mesh.GetTriangle(triangle));
+        }
+    }
+
+    // Note(3011): A triangle of a mesh as a primitive of its own, for building
+    // a BVH over the triangles of a mesh, see MeshTriangles. It refers to the
+    // mesh, which has to outlive it (and the hierarchy).
+    template <Concept::StrongFloatType T>
+    struct MeshTriangle
+    {
+    public:
+        using ScalarType = T;
+
+        const TriangleMesh<T>* Mesh;
+        u32 Index;
+    };
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]]
+    std::vector<MeshTriangle<T>> MeshTriangles(const TriangleMesh<T>& mesh)
+    {
+        std::vector<MeshTriangle<T>> triangles;
+        triangles.reserve(ToUnderlying(mesh.TriangleCount()));
+        for (SizeType i = 0; i < mesh.TriangleCount(); ++i)
+        {
+            triangles.push_back({ &mesh, Cast<u32>(i) });
+        }
+        return triangles;
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]]
+    Box<T> BoundingBox(const MeshTriangle<T>& triangle) noexcept
+    {
+        return BoundingBox(triangle.Mesh->GetTriangle(Cast<SizeType>(triangle.Index)));
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]]
+    Intersection<T> NearestIntersection(const Ray<T>& ray, const Interval<T>& interval, const MeshTriangle<T>& triangle) noexcept
+    {
+        return NearestIntersection(ray, interval, *triangle.Mesh, Cast<SizeType>(triangle.Index));
+    }
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]]
+    Intersection<T> NearestIntersection(const RayPrecomputed<T>& ray, const Interval<T>& interval, const MeshTriangle<T>& triangle) noexcept
+    {
+        return NearestIntersection(ray, interval, *triangle.Mesh, Cast<SizeType>(triangle.Index));
+    }
+
+    template <Concept::StrongFloatType T, SizeType N>
+    [[nodiscard]]
+    IntersectionPacket<T, N> NearestIntersection(const RayPacket<T, N>& rays, const Interval<T>& interval, const MeshTriangle<T>& triangle) noexcept
+    {
+        return NearestIntersection(rays, interval, *triangle.Mesh, Cast<SizeType>(triangle.Index));
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_GEOMETRY_MESH_HPP
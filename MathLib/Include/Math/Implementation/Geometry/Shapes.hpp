@@ -4,6 +4,7 @@
 #include "../../Vector.hpp"
 #include "../../Point.hpp"
 #include "../../Transform.hpp"
+#include "../Base/Array.hpp"
 
 namespace Math::Geometry
 {
@@ -37,6 +38,7 @@ namespace Math::Geometry
     struct Triangle
     {
     public:
+        using ScalarType = T;
         using PointType = Point<T>;
         using VectorType = Vector3T<T>;
 
@@ -82,6 +84,7 @@ namespace Math::Geometry
     struct Box
     {
     public:
+        using ScalarType = T;
         using PointType = Point<T>;
 
         [[nodiscard]] constexpr
@@ -147,8 +150,8 @@ namespace Math::Geometry
         using VectorType = Vector3T<T>;
 
         [[nodiscard]] constexpr
-        Intersection(ScalarType distance) noexcept
-            : Distance(distance)
+        Intersection(ScalarType distance, ScalarType u = Cast<T>(0), ScalarType v = Cast<T>(0)) noexcept
+            : Distance(distance), U(u), V(v)
         {}
 
         [[nodiscard]] constexpr
@@ -163,7 +166,11 @@ namespace Math::Geometry
             return IsValid();
         }
 
+        // Note(3011): Barycentric coordinates of the hit on triangles, the
+        // weights of B and C (A has 1 - U - V), 0 for the other shapes.
         ScalarType Distance;
+        ScalarType U;
+        ScalarType V;
     };
 
     template <Concept::StrongFloatType T>
@@ -188,6 +195,147 @@ namespace Math::Geometry
         PointType Origin;
         VectorType Direction;
     };
+
+    // Note(3011): A ray with the data the box and the watertight triangle
+    // tests derive from it, worth it when the same ray is tested against
+    // many shapes.
+    //
+    // Sign[axis] is 1 for negative direction components (-0 included), the
+    // ray enters the slab of a box along that axis through Min if it is 0,
+    // through Max otherwise. Axes and Shear set up the space of the ray for
+    // the watertight test: Axes[2] is the axis along which the direction is
+    // largest, and Shear maps the direction onto (0, 0, 1) in that space.
+    template <Concept::StrongFloatType T>
+    struct RayPrecomputed
+    {
+    public:
+        using ScalarType = T;
+        using VectorType = Vector3T<T>;
+        using PointType = Point<T>;
+
+        [[nodiscard]] constexpr
+        RayPrecomputed(const Ray<T>& ray) noexcept
+            : Origin(ray.Origin), Direction(ray.Direction), InverseDirection(VectorType(Cast<T>(1)) / ray.Direction)
+        {
+            for (SizeType axis = 0; axis < 3; ++axis)
+            {
+                Sign[axis] = (InverseDirection[axis] < Cast<T>(0)) ? 1 : 0;
+            }
+
+            // Note(3011): x and y are swapped for negative z to keep the
+            // winding of the triangles.
+            SizeType kz = 0;
+            if (Abs(Direction.y) > Abs(Direction[kz])) { kz = 1; }
+            if (Abs(Direction.z) > Abs(Direction[kz])) { kz = 2; }
+            SizeType kx = (kz == 2) ? SizeType(0) : kz + 1;
+            SizeType ky = (kx == 2) ? SizeType(0) : kx + 1;
+            if (Direction[kz] < Cast<T>(0))
+            {
+                Swap(kx, ky);
+            }
+
+            Axes = Array<SizeType, 3>(kx, ky, kz);
+            Shear = VectorType(Direction[kx] / Direction[kz], Direction[ky] / Direction[kz], Cast<T>(1) / Direction[kz]);
+        }
+
+        [[nodiscard]] constexpr
+        PointType Project(ScalarType scale) const noexcept
+        {
+            return Origin + (scale * Direction);
+        }
+
+        PointType Origin;
+        VectorType Direction;
+        VectorType InverseDirection;
+        Array<u32, 3> Sign;
+        Array<SizeType, 3> Axes;
+        VectorType Shear;
+    };
+
+    // Note(3011): N rays in structure of arrays layout, for tracing coherent
+    // rays (camera rays through neighbouring pixels) together. Set keeps the
+    // inverse direction up to date, computed the same way as in
+    // RayPrecomputed, so the packet tests agree with the scalar ones.
+    template <Concept::StrongFloatType T, SizeType N>
+    struct RayPacket
+    {
+    public:
+        using ScalarType = T;
+        static constexpr SizeType Width = N;
+        // Note(3011): A lane mask with every lane set, bit i is lane i. The
+        // masks only cover packets of up to 32 rays.
+        static constexpr u32 AllLanes = u32((N >= 32) ? ~std::uint32_t(0) : (std::uint32_t(1) << ToUnderlying(N)) - 1);
+
+        [[nodiscard]] constexpr
+        Ray<T> Get(SizeType lane) const noexcept
+        {
+            return Ray<T>(Point<T>(Origin.Get(lane)), Direction.Get(lane));
+        }
+
+        constexpr
+        void Set(SizeType lane, const Ray<T>& ray) noexcept
+        {
+            Origin.Set(lane, Vector3T<T>(ray.Origin));
+            Direction.Set(lane, ray.Direction);
+            InverseDirection.Set(lane, Vector3T<T>(Cast<T>(1)) / ray.Direction);
+        }
+
+        Vector3PacketT<T, N> Origin;
+        Vector3PacketT<T, N> Direction;
+        Vector3PacketT<T, N> InverseDirection;
+    };
+
+    // Note(3011): The intersections of a ray packet, lanes that miss have a
+    // NaN distance.
+    template <Concept::StrongFloatType T, SizeType N>
+    struct IntersectionPacket
+    {
+    public:
+        using ScalarType = T;
+        static constexpr SizeType Width = N;
+
+        [[nodiscard]] constexpr
+        bool IsValid(SizeType lane) const noexcept
+        {
+            return Distance[lane] == Distance[lane];
+        }
+
+        [[nodiscard]] constexpr
+        Intersection<T> Get(SizeType lane) const noexcept
+        {
+            return Intersection<T>(Distance[lane], U[lane], V[lane]);
+        }
+
+        Array<T, N> Distance;
+        Array<T, N> U;
+        Array<T, N> V;
+    };
+
+    // Note(3011): N boxes in structure of arrays layout, for testing a ray
+    // against all of them at once.
+    template <Concept::StrongFloatType T, SizeType N>
+    struct BoxPacket
+    {
+    public:
+        using ScalarType = T;
+        static constexpr SizeType Width = N;
+
+        [[nodiscard]] constexpr
+        Box<T> Get(SizeType lane) const noexcept
+        {
+            return Box<T>(Point<T>(Min.Get(lane)), Point<T>(Max.Get(lane)));
+        }
+
+        constexpr
+        void Set(SizeType lane, const Box<T>& box) noexcept
+        {
+            Min.Set(lane, Vector3T<T>(box.Min));
+            Max.Set(lane, Vector3T<T>(box.Max));
+        }
+
+        Vector3PacketT<T, N> Min;
+        Vector3PacketT<T, N> Max;
+    };
 }
 
 #endif //MATHLIB_IMPLEMENTATION_GEOMETRY_SHAPES_HPP
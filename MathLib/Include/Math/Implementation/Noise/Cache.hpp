@@ -0,0 +1,156 @@
+#ifndef MATHLIB_IMPLEMENTATION_NOISE_CACHE_HPP
+#define MATHLIB_IMPLEMENTATION_NOISE_CACHE_HPP
+
+#include "../Base/Concepts.hpp"
+#include "../Base/Parallel.hpp"
+#include "../../Functions.hpp"
+#include "../../Vector.hpp"
+#include "Grid.hpp"
+
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Math::Noise
+{
+    // Note(3011):
+    // A tileable 2D or 3D noise texture, sampled once from a noise function
+    // and then looked up with (bi/tri)linear filtering, which is a few memory
+    // fetches instead of a full evaluation. The texture covers [0, period)
+    // along every axis with resolution samples per unit, and the lookups wrap
+    // around, so it tiles everywhere. It only tiles without seams if the noise
+    // itself repeats with the same period, e.g. Perlin(seed, period).
+    //
+    // The memory is (period * resolution)^D values, 64^3 f32 values (period 8,
+    // resolution 8) are 1 MiB. The filtering smooths out the details finer
+    // than the sample spacing, use a resolution of at least 4 for Perlin.
+    // Sizes that are powers of two wrap with a mask instead of a division,
+    // which is most of the cost of a lookup otherwise.
+
+    template <Concept::FloatingPointType Float, SizeType D>
+        requires (D == 2 || D == 3)
+    class NoiseCache final
+    {
+    public:
+        using ValueType = Float;
+        using VectorType = std::conditional_t<D == 2, Vector2T<Float>, Vector3T<Float>>;
+
+        [[nodiscard]]
+        NoiseCache() noexcept = default;
+
+        template <typename Noise>
+        [[nodiscard]]
+        NoiseCache(const Noise& noise, u32 period, u32 resolution, SizeType threadCount = HardwareThreadCount())
+        {
+            Build(noise, period, resolution, threadCount);
+        }
+
+        template <typename Noise>
+        void Build(const Noise& noise, u32 period, u32 resolution, SizeType threadCount = HardwareThreadCount())
+        {
+            mSize = Cast<SizeType>(Max(period, u32(1)) * Max(resolution, u32(1)));
+            mPeriod = Cast<Float>(Max(period, u32(1)));
+            mResolution = Cast<Float>(Max(resolution, u32(1)));
+
+            Float step = Cast<Float>(1) / mResolution;
+            if constexpr (D == 2)
+            {
+                mSamples.resize(ToUnderlying(mSize * mSize));
+                FillGrid(noise, Vector2T<Float>(Cast<Float>(0)), Vector2T<Float>(step), Vector2sz(mSize),
+                         std::span<Float>(mSamples), threadCount);
+            }
+            else
+            {
+                mSamples.resize(ToUnderlying(mSize * mSize * mSize));
+                FillGrid(noise, Vector3T<Float>(Cast<Float>(0)), Vector3T<Float>(step), Vector3sz(mSize),
+                         std::span<Float>(mSamples), threadCount);
+            }
+        }
+
+        [[nodiscard]]
+        Float operator()(const VectorType& in) const noexcept
+        {
+            SizeType x0, x1, y0, y1;
+            Float u = Locate(in.x, x0, x1);
+            Float v = Locate(in.y, y0, y1);
+
+            if constexpr (D == 2)
+            {
+                return Lerp(v, Lerp(u, Sample(x0, y0), Sample(x1, y0)),
+                               Lerp(u, Sample(x0, y1), Sample(x1, y1)));
+            }
+            else
+            {
+                SizeType z0, z1;
+                Float w = Locate(in.z, z0, z1);
+
+                return Lerp(w, Lerp(v, Lerp(u, Sample(x0, y0, z0), Sample(x1, y0, z0)),
+                                       Lerp(u, Sample(x0, y1, z0), Sample(x1, y1, z0))),
+                               Lerp(v, Lerp(u, Sample(x0, y0, z1), Sample(x1, y0, z1)),
+                                       Lerp(u, Sample(x0, y1, z1), Sample(x1, y1, z1))));
+            }
+        }
+
+        [[nodiscard]]
+        Float Period() const noexcept
+        {
+            return mPeriod;
+        }
+
+        [[nodiscard]]
+        Float Resolution() const noexcept
+        {
+            return mResolution;
+        }
+
+        [[nodiscard]]
+        std::span<const Float> Samples() const noexcept
+        {
+            return mSamples;
+        }
+    private:
+        using Int = SignedIntegerSelector<sizeof(Float)>;
+
+        // Note(3011): The two samples around the coordinate along one axis,
+        // wrapped around the texture, and the weight of the second one.
+        [[nodiscard]]
+        Float Locate(Float coordinate, SizeType& first, SizeType& second) const noexcept
+        {
+            Float scaled = coordinate * mResolution;
+            Int cell = Floor<Int>(scaled);
+            Float fraction = scaled - Cast<Float>(cell);
+
+            Int size = Cast<Int>(mSize);
+            if ((mSize & (mSize - 1)) == 0)
+            {
+                first = Cast<SizeType>(cell & (size - 1));
+            }
+            else
+            {
+                Int wrapped = cell % size;
+                first = Cast<SizeType>((wrapped < 0) ? wrapped + size : wrapped);
+            }
+            second = (first + 1 == mSize) ? SizeType(0) : first + 1;
+            return fraction;
+        }
+
+        [[nodiscard]]
+        Float Sample(SizeType x, SizeType y) const noexcept
+        {
+            return mSamples[ToUnderlying(x + y * mSize)];
+        }
+
+        [[nodiscard]]
+        Float Sample(SizeType x, SizeType y, SizeType z) const noexcept
+        {
+            return mSamples[ToUnderlying(x + (y + z * mSize) * mSize)];
+        }
+
+        std::vector<Float> mSamples;
+        SizeType mSize = 0;
+        Float mPeriod = Cast<Float>(0);
+        Float mResolution = Cast<Float>(0);
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_NOISE_CACHE_HPP
@@ -0,0 +1,28 @@
+#ifndef MATHLIB_IMPLEMENTATION_NOISE_GRADIENT_HPP
+#define MATHLIB_IMPLEMENTATION_NOISE_GRADIENT_HPP
+
+#include "../Base/Array.hpp"
+#include "../Base/Concepts.hpp"
+
+namespace Math::Noise
+{
+    // Note(3011): A noise value together with its analytic gradient, the
+    // gradient is of the returned value (so of the [0, 1] range), with
+    // respect to the input point.
+    template <typename Vec>
+    struct GradientSample final
+    {
+        typename Vec::ScalarType Value;
+        Vec Gradient;
+    };
+
+    // Note(3011): The packet version, the values and gradients of N points.
+    template <typename Packet>
+    struct GradientPacket final
+    {
+        Array<typename Packet::ScalarType, Packet::Width> Value;
+        Packet Gradient;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_NOISE_GRADIENT_HPP
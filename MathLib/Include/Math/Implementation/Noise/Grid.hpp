@@ -0,0 +1,136 @@
+#ifndef MATHLIB_IMPLEMENTATION_NOISE_GRID_HPP
+#define MATHLIB_IMPLEMENTATION_NOISE_GRID_HPP
+
+#include "../Base/Array.hpp"
+#include "../Base/Parallel.hpp"
+#include "../../Vector.hpp"
+
+#include <span>
+
+namespace Math::Implementation
+{
+    template <typename Vec, SizeType N>
+    struct GridPacket;
+
+    template <typename T, SizeType N>
+    struct GridPacket<Vector2T<T>, N>
+    {
+        using Type = Vector2PacketT<T, N>;
+    };
+
+    template <typename T, SizeType N>
+    struct GridPacket<Vector3T<T>, N>
+    {
+        using Type = Vector3PacketT<T, N>;
+    };
+
+    inline constexpr SizeType GridPacketWidth = 8;
+
+    // Note(3011): Below this many samples the threads cost more than they save.
+    inline constexpr SizeType GridParallelThreshold = 1 << 15;
+
+    // Note(3011): Fills one row of a grid, with the row kernel of the noise if
+    // it has one, its packet overloads if it has those, and point by point
+    // otherwise.
+    template <typename Noise, typename Vec, Concept::FloatingPointType Float>
+    constexpr
+    void FillGridRow(const Noise& noise, const Vec& start, Float step, std::span<Float> out) noexcept
+    {
+        using Packet = typename GridPacket<Vec, GridPacketWidth>::Type;
+
+        if constexpr (requires { noise.FillRow(start, step, out); })
+        {
+            noise.FillRow(start, step, out);
+        }
+        else
+        {
+            SizeType i = 0;
+            if constexpr (requires (const Packet& packet) { { noise(packet) } -> Concept::IsSame<Array<Float, GridPacketWidth>>; })
+            {
+                Packet packet;
+                for (; i + GridPacketWidth <= out.size(); i += GridPacketWidth)
+                {
+                    for (SizeType lane = 0; lane < GridPacketWidth; ++lane)
+                    {
+                        Vec point = start;
+                        point.x += Cast<Float>(i + lane) * step;
+                        packet.Set(lane, point);
+                    }
+
+                    Array<Float, GridPacketWidth> values = noise(packet);
+                    for (SizeType lane = 0; lane < GridPacketWidth; ++lane)
+                    {
+                        out[ToUnderlying(i + lane)] = values[lane];
+                    }
+                }
+            }
+
+            for (; i < out.size(); ++i)
+            {
+                Vec point = start;
+                point.x += Cast<Float>(i) * step;
+                out[ToUnderlying(i)] = noise(point);
+            }
+        }
+    }
+
+    // Note(3011): Calls rowFunc(row) for all the rows, in blocks of rows spread
+    // over the threads, several blocks per thread so they balance out.
+    template <Concept::Invocable<SizeType> Func>
+    void ForEachGridRow(SizeType rowCount, SizeType rowLength, Func&& rowFunc, SizeType threadCount)
+    {
+        if (rowCount * rowLength < GridParallelThreshold)
+        {
+            threadCount = 1;
+        }
+
+        SizeType blockSize = Max(rowCount / (threadCount * 8), SizeType(1));
+        SizeType blockCount = (rowCount + blockSize - 1) / blockSize;
+        ParallelFor(blockCount, [&](SizeType block)
+        {
+            SizeType end = Min(rowCount, (block + 1) * blockSize);
+            for (SizeType row = block * blockSize; row < end; ++row)
+            {
+                rowFunc(row);
+            }
+        }, threadCount);
+    }
+}
+
+namespace Math::Noise
+{
+    // Note(3011):
+    // Evaluates a noise function on a regular grid, out[x + extents.x * y] is
+    // the noise at origin + (x, y) * step (with one more level of z for the 3D
+    // version). The grid is processed a row at a time, so noise functions that
+    // provide row kernels (Perlin) hash each lattice cell once per row instead
+    // of once per sample, and the others are evaluated in packets along the
+    // rows. Large grids are split over threadCount threads by blocks of rows.
+    // Results may differ from point by point evaluation in the last bits.
+
+    template <typename Noise, Concept::FloatingPointType Float>
+    void FillGrid(const Noise& noise, const Vector2T<Float>& origin, const Vector2T<Float>& step,
+                  const Vector2sz& extents, std::span<Float> out, SizeType threadCount = HardwareThreadCount())
+    {
+        Implementation::ForEachGridRow(extents.y, extents.x, [&](SizeType y)
+        {
+            Vector2T<Float> start(origin.x, origin.y + Cast<Float>(y) * step.y);
+            Implementation::FillGridRow(noise, start, step.x, out.subspan(ToUnderlying(y * extents.x), ToUnderlying(extents.x)));
+        }, threadCount);
+    }
+
+    template <typename Noise, Concept::FloatingPointType Float>
+    void FillGrid(const Noise& noise, const Vector3T<Float>& origin, const Vector3T<Float>& step,
+                  const Vector3sz& extents, std::span<Float> out, SizeType threadCount = HardwareThreadCount())
+    {
+        Implementation::ForEachGridRow(extents.y * extents.z, extents.x, [&](SizeType row)
+        {
+            SizeType y = row % extents.y;
+            SizeType z = row / extents.y;
+            Vector3T<Float> start(origin.x, origin.y + Cast<Float>(y) * step.y, origin.z + Cast<Float>(z) * step.z);
+            Implementation::FillGridRow(noise, start, step.x, out.subspan(ToUnderlying(row * extents.x), ToUnderlying(extents.x)));
+        }, threadCount);
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_NOISE_GRID_HPP
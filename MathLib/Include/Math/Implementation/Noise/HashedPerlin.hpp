@@ -0,0 +1,325 @@
+#ifndef MATHLIB_IMPLEMENTATION_NOISE_HASHED_PERLIN_HPP
+#define MATHLIB_IMPLEMENTATION_NOISE_HASHED_PERLIN_HPP
+
+#include "../Base/Array.hpp"
+#include "../../Functions.hpp"
+#include "../../Vector.hpp"
+#include "Lattice.hpp"
+
+namespace Math::Noise
+{
+    // Note(3011):
+    // Perlin noise with the lattice points hashed directly (see Lattice.hpp)
+    // instead of through a permutation table. The gradients come from the same
+    // sets in Lattice.hpp that Perlin picks from, and the fade curve and the
+    // output range are the same as in Perlin too, but there is no period of
+    // 256 (besides the wrap around of the 32-bit lattice coordinates), no
+    // per-instance table, and the hashing is plain integer arithmetic, so the
+    // packet overloads vectorize without gathers. The results differ from
+    // Perlin with the same seed.
+
+    template <Concept::FloatingPointType Float>
+    class HashedPerlin final
+    {
+    public:
+        using ValueType = Float;
+
+        static constexpr SizeType PacketWidth = 8;
+
+        [[nodiscard]] constexpr explicit
+        HashedPerlin(u64 seed = 0) noexcept
+            : mSeed(Cast<u32>(Hash64(seed)))
+        {}
+
+        [[nodiscard]] constexpr
+        Float operator()(const Vector2T<Float>& in) const noexcept
+        {
+            Int xc = Floor<Int>(in.x);
+            Int yc = Floor<Int>(in.y);
+
+            u32 xi = Cast<u32>(xc);
+            Float xf = in.x - Cast<Float>(xc);
+            u32 yi = Cast<u32>(yc);
+            Float yf = in.y - Cast<Float>(yc);
+
+            Float u = Smootherstep(xf, Float(0), Float(1));
+            Float v = Smootherstep(yf, Float(0), Float(1));
+
+            Float v1 = Gradient(xi,     yi,     xf,     yf    );
+            Float v2 = Gradient(xi + 1, yi,     xf - 1, yf    );
+            Float v3 = Gradient(xi,     yi + 1, xf,     yf - 1);
+            Float v4 = Gradient(xi + 1, yi + 1, xf - 1, yf - 1);
+
+            return (Lerp(v, Lerp(u, v1, v2),
+                            Lerp(u, v3, v4)) + 2) / 4;
+        }
+
+        [[nodiscard]] constexpr
+        Float operator()(const Vector3T<Float>& in) const noexcept
+        {
+            Int xc = Floor<Int>(in.x);
+            Int yc = Floor<Int>(in.y);
+            Int zc = Floor<Int>(in.z);
+
+            u32 xi = Cast<u32>(xc);
+            Float xf = in.x - Cast<Float>(xc);
+            u32 yi = Cast<u32>(yc);
+            Float yf = in.y - Cast<Float>(yc);
+            u32 zi = Cast<u32>(zc);
+            Float zf = in.z - Cast<Float>(zc);
+
+            Float u = Smootherstep(xf, Float(0), Float(1));
+            Float v = Smootherstep(yf, Float(0), Float(1));
+            Float w = Smootherstep(zf, Float(0), Float(1));
+
+            Float v1 = Gradient(xi,     yi,     zi,     xf,     yf,     zf    );
+            Float v2 = Gradient(xi + 1, yi,     zi,     xf - 1, yf,     zf    );
+            Float v3 = Gradient(xi,     yi + 1, zi,     xf,     yf - 1, zf    );
+            Float v4 = Gradient(xi + 1, yi + 1, zi,     xf - 1, yf - 1, zf    );
+            Float v5 = Gradient(xi,     yi,     zi + 1, xf,     yf,     zf - 1);
+            Float v6 = Gradient(xi + 1, yi,     zi + 1, xf - 1, yf,     zf - 1);
+            Float v7 = Gradient(xi,     yi + 1, zi + 1, xf,     yf - 1, zf - 1);
+            Float v8 = Gradient(xi + 1, yi + 1, zi + 1, xf - 1, yf - 1, zf - 1);
+
+            return (Lerp(w, Lerp(v, Lerp(u, v1, v2),
+                                    Lerp(u, v3, v4)),
+                            Lerp(v, Lerp(u, v5, v6),
+                                    Lerp(u, v7, v8))) + 1) / 2;
+        }
+
+        [[nodiscard]] constexpr
+        Float operator()(const Vector4T<Float>& in) const noexcept
+        {
+            Int xc = Floor<Int>(in.x);
+            Int yc = Floor<Int>(in.y);
+            Int zc = Floor<Int>(in.z);
+            Int wc = Floor<Int>(in.w);
+
+            u32 xi = Cast<u32>(xc);
+            Float xf = in.x - Cast<Float>(xc);
+            u32 yi = Cast<u32>(yc);
+            Float yf = in.y - Cast<Float>(yc);
+            u32 zi = Cast<u32>(zc);
+            Float zf = in.z - Cast<Float>(zc);
+            u32 wi = Cast<u32>(wc);
+            Float wf = in.w - Cast<Float>(wc);
+
+            Float u = Smootherstep(xf, Float(0), Float(1));
+            Float v = Smootherstep(yf, Float(0), Float(1));
+            Float s = Smootherstep(zf, Float(0), Float(1));
+            Float t = Smootherstep(wf, Float(0), Float(1));
+
+            Float v1  = Gradient(xi,     yi,     zi,     wi,     xf,     yf,     zf,     wf    );
+            Float v2  = Gradient(xi + 1, yi,     zi,     wi,     xf - 1, yf,     zf,     wf    );
+            Float v3  = Gradient(xi,     yi + 1, zi,     wi,     xf,     yf - 1, zf,     wf    );
+            Float v4  = Gradient(xi + 1, yi + 1, zi,     wi,     xf - 1, yf - 1, zf,     wf    );
+            Float v5  = Gradient(xi,     yi,     zi + 1, wi,     xf,     yf,     zf - 1, wf    );
+            Float v6  = Gradient(xi + 1, yi,     zi + 1, wi,     xf - 1, yf,     zf - 1, wf    );
+            Float v7  = Gradient(xi,     yi + 1, zi + 1, wi,     xf,     yf - 1, zf - 1, wf    );
+            Float v8  = Gradient(xi + 1, yi + 1, zi + 1, wi,     xf - 1, yf - 1, zf - 1, wf    );
+            Float v9  = Gradient(xi,     yi,     zi,     wi + 1, xf,     yf,     zf,     wf - 1);
+            Float v10 = Gradient(xi + 1, yi,     zi,     wi + 1, xf - 1, yf,     zf,     wf - 1);
+            Float v11 = Gradient(xi,     yi + 1, zi,     wi + 1, xf,     yf - 1, zf,     wf - 1);
+            Float v12 = Gradient(xi + 1, yi + 1, zi,     wi + 1, xf - 1, yf - 1, zf,     wf - 1);
+            Float v13 = Gradient(xi,     yi,     zi + 1, wi + 1, xf,     yf,     zf - 1, wf - 1);
+            Float v14 = Gradient(xi + 1, yi,     zi + 1, wi + 1, xf - 1, yf,     zf - 1, wf - 1);
+            Float v15 = Gradient(xi,     yi + 1, zi + 1, wi + 1, xf,     yf - 1, zf - 1, wf - 1);
+            Float v16 = Gradient(xi + 1, yi + 1, zi + 1, wi + 1, xf - 1, yf - 1, zf - 1, wf - 1);
+
+            return (Lerp(t, Lerp(s, Lerp(v, Lerp(u,  v1,  v2),
+                                            Lerp(u,  v3,  v4)),
+                                    Lerp(v, Lerp(u,  v5,  v6),
+                                            Lerp(u,  v7,  v8))),
+                            Lerp(s, Lerp(v, Lerp(u,  v9, v10),
+                                            Lerp(u, v11, v12)),
+                                    Lerp(v, Lerp(u, v13, v14),
+                                            Lerp(u, v15, v16)))) + 1) / 2;
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector2PacketT<Float, N>& in) const noexcept
+        {
+            if constexpr (!Implementation::VectorizedPackets)
+            {
+                return EvaluateLanes(in);
+            }
+            else
+            {
+                Array<Array<Float, N>, 2> points;
+                points[0] = in.x;
+                points[1] = in.y;
+                return EvaluatePacket(points);
+            }
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector3PacketT<Float, N>& in) const noexcept
+        {
+            if constexpr (!Implementation::VectorizedPackets)
+            {
+                return EvaluateLanes(in);
+            }
+            else
+            {
+                Array<Array<Float, N>, 3> points;
+                points[0] = in.x;
+                points[1] = in.y;
+                points[2] = in.z;
+                return EvaluatePacket(points);
+            }
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector4PacketT<Float, N>& in) const noexcept
+        {
+            if constexpr (!Implementation::VectorizedPackets)
+            {
+                return EvaluateLanes(in);
+            }
+            else
+            {
+                Array<Array<Float, N>, 4> points;
+                points[0] = in.x;
+                points[1] = in.y;
+                points[2] = in.z;
+                points[3] = in.w;
+                return EvaluatePacket(points);
+            }
+        }
+    private:
+        // Note(3011): The packet overloads without VectorizedPackets, the
+        // scalar kernels lane by lane.
+        template <typename Packet>
+        [[nodiscard]] constexpr
+        Array<Float, Packet::Width> EvaluateLanes(const Packet& in) const noexcept
+        {
+            Array<Float, Packet::Width> result;
+            for (SizeType lane = 0; lane < Packet::Width; ++lane)
+            {
+                result[lane] = (*this)(in.Get(lane));
+            }
+            return result;
+        }
+
+        using Int = SignedIntegerSelector<sizeof(Float)>;
+
+        // Note(3011):
+        // Every stage is a loop over the lanes with a branch-free body. The
+        // lattice setup works on the underlying values, GCC does not turn the
+        // comparisons of the strong types into selects, which would keep the
+        // loops from vectorizing. The corners are interpolated an axis at a
+        // time (bit d of the corner index is the offset along axis d), which is
+        // the order the scalar versions use, so the results match them exactly.
+        // The hashing needs 32-bit vector multiplies, with only SSE2 enabled
+        // the compilers emulate them and this is slower than the scalar
+        // versions, it pays off from AVX2 on and is only used with
+        // Implementation::VectorizedPackets (see Lattice.hpp).
+        template <SizeType D, SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> EvaluatePacket(const Array<Array<Float, N>, D>& points) const noexcept
+        {
+            constexpr SizeType cornerCount = SizeType(1) << ToUnderlying(D);
+
+            using RawFloat = UnderlyingType<Float>;
+            using RawInt = UnderlyingType<Int>;
+
+            Array<Array<u32, N>, D> cells;
+            Array<Array<Float, N>, D> fractions;
+            Array<Array<Float, N>, D> fades;
+            for (SizeType d = 0; d < D; ++d)
+            {
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    RawFloat point = ToUnderlying(points[d][lane]);
+                    RawInt cell = static_cast<RawInt>(point);
+                    cell -= (point < static_cast<RawFloat>(cell)) ? 1 : 0;
+                    RawFloat fraction = point - static_cast<RawFloat>(cell);
+                    cells[d][lane] = Cast<u32>(cell);
+                    fractions[d][lane] = Float(fraction);
+                    fades[d][lane] = Float(Smootherstep(fraction, RawFloat(0), RawFloat(1)));
+                }
+            }
+
+            Array<Array<Float, N>, cornerCount> values;
+            for (SizeType corner = 0; corner < cornerCount; ++corner)
+            {
+                Array<u32, D> offset;
+                for (SizeType d = 0; d < D; ++d)
+                {
+                    offset[d] = Cast<u32>((corner >> ToUnderlying(d)) & 1);
+                }
+
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    if constexpr (D == 2)
+                    {
+                        u32 hash = Implementation::LatticeHash(mSeed, cells[0][lane] + offset[0], cells[1][lane] + offset[1]);
+                        values[corner][lane] = Implementation::LatticeGradient(hash, fractions[0][lane] - Cast<Float>(offset[0]),
+                                                                                     fractions[1][lane] - Cast<Float>(offset[1]));
+                    }
+                    else if constexpr (D == 3)
+                    {
+                        u32 hash = Implementation::LatticeHash(mSeed, cells[0][lane] + offset[0], cells[1][lane] + offset[1],
+                                                                      cells[2][lane] + offset[2]);
+                        values[corner][lane] = Implementation::LatticeGradient(hash, fractions[0][lane] - Cast<Float>(offset[0]),
+                                                                                     fractions[1][lane] - Cast<Float>(offset[1]),
+                                                                                     fractions[2][lane] - Cast<Float>(offset[2]));
+                    }
+                    else
+                    {
+                        u32 hash = Implementation::LatticeHash(mSeed, cells[0][lane] + offset[0], cells[1][lane] + offset[1],
+                                                                      cells[2][lane] + offset[2], cells[3][lane] + offset[3]);
+                        values[corner][lane] = Implementation::LatticeGradient(hash, fractions[0][lane] - Cast<Float>(offset[0]),
+                                                                                     fractions[1][lane] - Cast<Float>(offset[1]),
+                                                                                     fractions[2][lane] - Cast<Float>(offset[2]),
+                                                                                     fractions[3][lane] - Cast<Float>(offset[3]));
+                    }
+                }
+            }
+
+            for (SizeType d = 0; d < D; ++d)
+            {
+                SizeType pairCount = cornerCount >> ToUnderlying(d + 1);
+                for (SizeType pair = 0; pair < pairCount; ++pair)
+                {
+                    for (SizeType lane = 0; lane < N; ++lane)
+                    {
+                        values[pair][lane] = Lerp(fades[d][lane], values[2 * pair][lane], values[2 * pair + 1][lane]);
+                    }
+                }
+            }
+
+            Array<Float, N> result;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                result[lane] = (D == 2) ? (values[0][lane] + 2) / 4 : (values[0][lane] + 1) / 2;
+            }
+            return result;
+        }
+
+        [[nodiscard]] constexpr
+        Float Gradient(u32 x, u32 y, Float xf, Float yf) const noexcept
+        {
+            return Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, x, y), xf, yf);
+        }
+
+        [[nodiscard]] constexpr
+        Float Gradient(u32 x, u32 y, u32 z, Float xf, Float yf, Float zf) const noexcept
+        {
+            return Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, x, y, z), xf, yf, zf);
+        }
+
+        [[nodiscard]] constexpr
+        Float Gradient(u32 x, u32 y, u32 z, u32 w, Float xf, Float yf, Float zf, Float wf) const noexcept
+        {
+            return Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, x, y, z, w), xf, yf, zf, wf);
+        }
+
+        u32 mSeed;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_NOISE_HASHED_PERLIN_HPP
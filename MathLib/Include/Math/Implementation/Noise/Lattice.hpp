@@ -0,0 +1,117 @@
+#ifndef MATHLIB_IMPLEMENTATION_NOISE_LATTICE_HPP
+#define MATHLIB_IMPLEMENTATION_NOISE_LATTICE_HPP
+
+#include "../Base/Array.hpp"
+#include "../Base/Concepts.hpp"
+#include "../Base/Inline.hpp"
+#include "../Functions/Hash.hpp"
+
+// Note(3011):
+// Whether the staged packet kernels of the lattice noises (Perlin and
+// HashedPerlin) are used. Their lane loops need 32-bit vector multiplies and
+// wide registers, with only SSE2 (the x86-64 default) they are slower than
+// the scalar kernels, so the packet overloads run the scalar kernels lane by
+// lane instead. AVX2 enables them (-mavx2, -march=native, /arch:AVX2 or the
+// MATHLIB_TARGET_ARCH CMake option), defining MATH_VECTORIZED_PACKETS to 0 or
+// 1 overrides the detection. It has to be the same in every translation unit.
+#ifndef MATH_VECTORIZED_PACKETS
+#   if defined(__AVX2__)
+#       define MATH_VECTORIZED_PACKETS 1
+#   else
+#       define MATH_VECTORIZED_PACKETS 0
+#   endif
+#endif
+
+namespace Math::Implementation
+{
+    inline constexpr bool VectorizedPackets = MATH_VECTORIZED_PACKETS != 0;
+
+    // Note(3011):
+    // Hashes of integer lattice points, shared by the noise functions that do
+    // not use a permutation table. The coordinates are multiplied by large odd
+    // constants and mixed with Hash32, so there is no period (besides the
+    // wrap around of the 32-bit coordinates) and no table lookups, which is
+    // what lets the packet paths vectorize without gathers. The helpers are
+    // forced inline, the packet paths call them in their lane loops.
+
+    inline constexpr u32 LatticePrimeX = 0x8DA6B343;
+    inline constexpr u32 LatticePrimeY = 0xD8163841;
+    inline constexpr u32 LatticePrimeZ = 0xCB1AB31F;
+    inline constexpr u32 LatticePrimeW = 0xB9D5A99B;
+
+    [[nodiscard]] MATH_FORCE_INLINE constexpr
+    u32 LatticeHash(u32 seed, u32 x, u32 y) noexcept
+    {
+        return Hash32(seed ^ (x * LatticePrimeX) ^ (y * LatticePrimeY));
+    }
+
+    [[nodiscard]] MATH_FORCE_INLINE constexpr
+    u32 LatticeHash(u32 seed, u32 x, u32 y, u32 z) noexcept
+    {
+        return Hash32(seed ^ (x * LatticePrimeX) ^ (y * LatticePrimeY) ^ (z * LatticePrimeZ));
+    }
+
+    [[nodiscard]] MATH_FORCE_INLINE constexpr
+    u32 LatticeHash(u32 seed, u32 x, u32 y, u32 z, u32 w) noexcept
+    {
+        return Hash32(seed ^ (x * LatticePrimeX) ^ (y * LatticePrimeY) ^ (z * LatticePrimeZ) ^ (w * LatticePrimeW));
+    }
+
+    template <SizeType D>
+        requires (D >= 2 && D <= 4)
+    [[nodiscard]] MATH_FORCE_INLINE constexpr
+    u32 LatticeHash(u32 seed, const Array<u32, D>& cell) noexcept
+    {
+        constexpr Array<u32, 4> primes(LatticePrimeX, LatticePrimeY, LatticePrimeZ, LatticePrimeW);
+
+        for (SizeType i = 0; i < D; ++i)
+        {
+            seed ^= cell[i] * primes[i];
+        }
+        return Hash32(seed);
+    }
+
+    // Note(3011):
+    // Dot products of the offset with a gradient picked by the low bits of the
+    // hash, the same gradient sets as the Perlin noise in this library (and
+    // S. Gustavson's noise1234): 8 directions of the form (1, 2) in 2D, the 12
+    // cube edge midpoints in 3D (4 of them twice) and the 32 cube edge
+    // midpoints of the 4D hypercube.
+
+    template <Concept::FloatingPointType Float>
+    [[nodiscard]] MATH_FORCE_INLINE constexpr
+    Float LatticeGradient(u32 hash, Float x, Float y) noexcept
+    {
+        hash &= 7;
+        Float u = (hash < 4) ? x : y;
+        Float v = (hash < 4) ? y : x;
+        return (ToUnderlying(hash & 1) ? -u : u)
+             + (ToUnderlying(hash & 2) ? Cast<Float>(-2) * v : Cast<Float>(2) * v);
+    }
+
+    template <Concept::FloatingPointType Float>
+    [[nodiscard]] MATH_FORCE_INLINE constexpr
+    Float LatticeGradient(u32 hash, Float x, Float y, Float z) noexcept
+    {
+        hash &= 15;
+        Float u = (hash < 8) ? x : y;
+        Float v = (hash < 4) ? y : (hash == 12 || hash == 14) ? x : z;
+        return (ToUnderlying(hash & 1) ? -u : u)
+             + (ToUnderlying(hash & 2) ? -v : v);
+    }
+
+    template <Concept::FloatingPointType Float>
+    [[nodiscard]] MATH_FORCE_INLINE constexpr
+    Float LatticeGradient(u32 hash, Float x, Float y, Float z, Float w) noexcept
+    {
+        hash &= 31;
+        Float t = (hash < 24) ? x : y;
+        Float u = (hash < 16) ? y : z;
+        Float v = (hash < 8) ? z : w;
+        return (ToUnderlying(hash & 1) ? -t : t)
+             + (ToUnderlying(hash & 2) ? -u : u)
+             + (ToUnderlying(hash & 4) ? -v : v);
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_NOISE_LATTICE_HPP
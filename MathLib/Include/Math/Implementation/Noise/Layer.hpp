@@ -2,10 +2,39 @@
 #define MATHLIB_IMPLEMENTATION_NOISE_LAYER_HPP
 
 #include "../Base/Array.hpp"
+#include "../../Functions.hpp"
 #include "../../Vector.hpp"
 
 namespace Math::Noise
 {
+    enum class FractalMode
+    {
+        FBm,
+        Ridged,
+        Turbulence
+    };
+
+    // Note(3011):
+    // Sums of octaves of a base noise, as described by F. K. Musgrave in
+    // "Texturing and Modeling: A Procedural Approach", chapter 16. Every octave
+    // scales the frequency by the lacunarity and the amplitude by the gain.
+    // The base noise is expected in [0, 1] (as all the noise functions here),
+    // and it is recentered to [-1, 1] before summing.
+    //
+    // - FBm sums the octaves directly.
+    // - Turbulence sums their absolute values, which creates creases where the
+    //   base noise crosses zero.
+    // - Ridged is Musgrave's ridged multifractal, it inverts and squares the
+    //   creases into ridges and weights every octave by the previous one, so
+    //   the valleys stay smooth while the ridges get detailed.
+    //
+    // All the results are normalized by the sum of the amplitudes to [0, 1].
+    //
+    // The packet overloads evaluate an octave for all the lanes before moving
+    // to the next one, so the state of the base noise (e.g. the permutation
+    // table of the Perlin noise) is reused by N points at a time, and they
+    // use the packet overloads of the base noise if there are any.
+
     template <Concept::FloatingPointType Float, template <typename> typename BaseNoise>
     class Layer final
     {
@@ -13,29 +42,173 @@ namespace Math::Noise
         using ValueType = Float;
 
         [[nodiscard]] constexpr explicit
-        Layer(u64 seed = 0) noexcept
+        Layer(u64 seed = 0, FractalMode mode = FractalMode::FBm, u32 octaves = 6,
+              Float lacunarity = Cast<Float>(2), Float gain = Cast<Float>(0.5)) noexcept
             : mBaseNoise(seed)
+            , mMode(mode)
+            , mOctaves(Max(octaves, u32(1)))
+            , mLacunarity(lacunarity)
+            , mGain(gain)
         {}
 
         [[nodiscard]] constexpr
         Float operator()(const Vector2T<Float>& in) const noexcept
         {
-            return Float(0);
+            return EvaluatePoint(in);
         }
 
         [[nodiscard]] constexpr
         Float operator()(const Vector3T<Float>& in) const noexcept
         {
-            return Float(0);
+            return EvaluatePoint(in);
         }
 
         [[nodiscard]] constexpr
         Float operator()(const Vector4T<Float>& in) const noexcept
         {
-            return Float(0);
+            return EvaluatePoint(in);
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector2PacketT<Float, N>& in) const noexcept
+        {
+            return EvaluatePacket(in);
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector3PacketT<Float, N>& in) const noexcept
+        {
+            return EvaluatePacket(in);
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector4PacketT<Float, N>& in) const noexcept
+        {
+            return EvaluatePacket(in);
+        }
+
+        [[nodiscard]] constexpr
+        const BaseNoise<Float>& Base() const noexcept
+        {
+            return mBaseNoise;
         }
     private:
+        // Note(3011): Adds one octave, the weight carries the previous octave
+        // of the ridged multifractal and stays one in the other modes.
+        [[nodiscard]] constexpr
+        Float Octave(Float noise, Float amplitude, Float& weight) const noexcept
+        {
+            Float signal = noise * Cast<Float>(2) - Cast<Float>(1);
+            switch (mMode)
+            {
+            case FractalMode::Ridged:
+                signal = Cast<Float>(1) - Abs(signal);
+                signal *= signal * weight;
+                weight = Clamp(signal * Cast<Float>(2));
+                return signal * amplitude;
+            case FractalMode::Turbulence:
+                return Abs(signal) * amplitude;
+            default:
+                return signal * amplitude;
+            }
+        }
+
+        [[nodiscard]] constexpr
+        Float Normalize(Float sum, Float amplitudeSum) const noexcept
+        {
+            sum /= amplitudeSum;
+            return (mMode == FractalMode::FBm) ? sum * Cast<Float>(0.5) + Cast<Float>(0.5) : sum;
+        }
+
+        template <typename Vec>
+        [[nodiscard]] constexpr
+        Float EvaluatePoint(const Vec& in) const noexcept
+        {
+            Float sum = Cast<Float>(0);
+            Float amplitude = Cast<Float>(1);
+            Float amplitudeSum = Cast<Float>(0);
+            Float frequency = Cast<Float>(1);
+            Float weight = Cast<Float>(1);
+            for (u32 octave = 0; octave < mOctaves; ++octave)
+            {
+                sum += Octave(mBaseNoise(in * frequency), amplitude, weight);
+                amplitudeSum += amplitude;
+                amplitude *= mGain;
+                frequency *= mLacunarity;
+            }
+            return Normalize(sum, amplitudeSum);
+        }
+
+        template <typename Packet>
+        [[nodiscard]] constexpr
+        Array<Float, Packet::Width> EvaluateBase(const Packet& in) const noexcept
+        {
+            if constexpr (requires { { mBaseNoise(in) } -> Concept::IsSame<Array<Float, Packet::Width>>; })
+            {
+                return mBaseNoise(in);
+            }
+            else
+            {
+                Array<Float, Packet::Width> result;
+                for (SizeType i = 0; i < Packet::Width; ++i)
+                {
+                    result[i] = mBaseNoise(in.Get(i));
+                }
+                return result;
+            }
+        }
+
+        template <typename Packet>
+        [[nodiscard]] constexpr
+        Array<Float, Packet::Width> EvaluatePacket(const Packet& in) const noexcept
+        {
+            constexpr SizeType width = Packet::Width;
+
+            Array<Float, width> sums;
+            Array<Float, width> weights;
+            for (SizeType i = 0; i < width; ++i)
+            {
+                sums[i] = Cast<Float>(0);
+                weights[i] = Cast<Float>(1);
+            }
+
+            Float amplitude = Cast<Float>(1);
+            Float amplitudeSum = Cast<Float>(0);
+            Float frequency = Cast<Float>(1);
+            Packet scaled;
+            for (u32 octave = 0; octave < mOctaves; ++octave)
+            {
+                for (SizeType i = 0; i < width; ++i)
+                {
+                    scaled.Set(i, in.Get(i) * frequency);
+                }
+
+                Array<Float, width> noise = EvaluateBase(scaled);
+                for (SizeType i = 0; i < width; ++i)
+                {
+                    sums[i] += Octave(noise[i], amplitude, weights[i]);
+                }
+
+                amplitudeSum += amplitude;
+                amplitude *= mGain;
+                frequency *= mLacunarity;
+            }
+
+            for (SizeType i = 0; i < width; ++i)
+            {
+                sums[i] = Normalize(sums[i], amplitudeSum);
+            }
+            return sums;
+        }
+
         BaseNoise<Float> mBaseNoise;
+        FractalMode mMode;
+        u32 mOctaves;
+        Float mLacunarity;
+        Float mGain;
     };
 }
 
@@ -2,39 +2,545 @@
 #define MATHLIB_IMPLEMENTATION_NOISE_SIMPLEX_HPP
 
 #include "../Base/Array.hpp"
-#include "../../Random.hpp"
+#include "../../Functions.hpp"
 #include "../../Vector.hpp"
+#include "Gradient.hpp"
+#include "Lattice.hpp"
 
 namespace Math::Noise
 {
+    // Note(3011):
+    // Simplex noise by K. Perlin, following S. Gustavson's "Simplex noise
+    // demystified" (2005). The domain is skewed so the unit cubes split into
+    // simplices, and only the d + 1 corners of the simplex containing the point
+    // contribute, instead of all 2^d corners of the cube, 5 instead of 16 in 4D.
+    // The simplex is found by ranking the offset coordinates and the corner
+    // kernels use a radius of 0.5 (instead of the 0.6 of the reference code),
+    // so the noise is continuous in every dimension. Lattice points are hashed
+    // directly rather than through a permutation table, there is no period.
+    //
+    // The results are in [0, 1], like the Perlin noise. The packet overloads
+    // evaluate N points at once with a staged kernel that vectorizes with AVX2,
+    // without it they run the scalar kernel lane by lane (see VectorizedPackets
+    // in Lattice.hpp).
+
     template <Concept::FloatingPointType Float>
     class Simplex final
     {
     public:
         using ValueType = Float;
 
+        static constexpr SizeType PacketWidth = 8;
+
         [[nodiscard]] constexpr explicit
         Simplex(u64 seed = 0) noexcept
+            : mSeed(Cast<u32>(Hash64(seed)))
         {}
 
         [[nodiscard]] constexpr
         Float operator()(const Vector2T<Float>& in) const noexcept
         {
-            return Float(0);
+            return Remap(Evaluate(in.x, in.y));
         }
 
         [[nodiscard]] constexpr
         Float operator()(const Vector3T<Float>& in) const noexcept
         {
-            return Float(0);
+            return Remap(Evaluate(in.x, in.y, in.z));
         }
 
         [[nodiscard]] constexpr
         Float operator()(const Vector4T<Float>& in) const noexcept
         {
-            return Float(0);
+            return Remap(Evaluate(in.x, in.y, in.z, in.w));
+        }
+
+        // Note(3011):
+        // The value and its analytic gradient in one pass. A corner contributes
+        // max(0.5 - |d|^2, 0)^4 * dot(g, d) for the offset d from the corner,
+        // its gradient is f^4 * g - 8 * f^3 * dot(g, d) * d, summed over the
+        // corners. The value is the same as from operator().
+
+        [[nodiscard]] constexpr
+        GradientSample<Vector2T<Float>> EvaluateWithGradient(const Vector2T<Float>& in) const noexcept
+        {
+            Vector2T<Float> gradient;
+            Float value = Evaluate<true>(in.x, in.y, gradient);
+            return { Remap(value), gradient * (Scale2 * Cast<Float>(0.5)) };
+        }
+
+        [[nodiscard]] constexpr
+        GradientSample<Vector3T<Float>> EvaluateWithGradient(const Vector3T<Float>& in) const noexcept
+        {
+            Vector3T<Float> gradient;
+            Float value = Evaluate<true>(in.x, in.y, in.z, gradient);
+            return { Remap(value), gradient * (Scale3 * Cast<Float>(0.5)) };
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector2PacketT<Float, N>& in) const noexcept
+        {
+            if constexpr (!Implementation::VectorizedPackets)
+            {
+                return EvaluateLanes(in);
+            }
+            else
+            {
+                Array<Array<Float, N>, 2> points;
+                points[0] = in.x;
+                points[1] = in.y;
+                return EvaluatePacket(points);
+            }
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector3PacketT<Float, N>& in) const noexcept
+        {
+            if constexpr (!Implementation::VectorizedPackets)
+            {
+                return EvaluateLanes(in);
+            }
+            else
+            {
+                Array<Array<Float, N>, 3> points;
+                points[0] = in.x;
+                points[1] = in.y;
+                points[2] = in.z;
+                return EvaluatePacket(points);
+            }
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector4PacketT<Float, N>& in) const noexcept
+        {
+            if constexpr (!Implementation::VectorizedPackets)
+            {
+                return EvaluateLanes(in);
+            }
+            else
+            {
+                Array<Array<Float, N>, 4> points;
+                points[0] = in.x;
+                points[1] = in.y;
+                points[2] = in.z;
+                points[3] = in.w;
+                return EvaluatePacket(points);
+            }
         }
     private:
+        using Int = SignedIntegerSelector<sizeof(Float)>;
+
+        // Note(3011):
+        // Scales that map the sums of the corner contributions to [-1, 1]. The
+        // gradient of a corner is the hash's choice, so the largest contribution
+        // it can make at the offset d is f^4 times the largest dot(g, d) of the
+        // set, 2 * |d|max + |d|min in 2D, the sum of the two (3D) or three (4D)
+        // largest |d| components otherwise. The scales are the reciprocals of
+        // the largest sum of those bounds over a simplex, which is reached when
+        // every corner picks its best gradient. The maxima were found by local
+        // searches over the cell (at e.g. (1.0529, 1.4785) in 2D), the scales
+        // are rounded down, and the clamp in Remap absorbs the rounding errors.
+        static constexpr Float Scale2 = Cast<Float>(45.2306);
+        static constexpr Float Scale3 = Cast<Float>(76.8807);
+        static constexpr Float Scale4 = Cast<Float>(62.7777);
+
+        [[nodiscard]] static constexpr
+        Float Remap(Float value) noexcept
+        {
+            return Clamp(value * Cast<Float>(0.5) + Cast<Float>(0.5));
+        }
+
+        [[nodiscard]] static constexpr
+        Float Kernel(Float falloff, Float gradient) noexcept
+        {
+            falloff = Max(falloff, Cast<Float>(0));
+            falloff *= falloff;
+            return falloff * falloff * gradient;
+        }
+
+        // Note(3011): Contribution of a corner at the offset d, its gradient is
+        // added to the sum of the corner gradients if it is needed.
+        template <bool WithGradient, typename Vec, typename... Offset>
+        [[nodiscard]] static constexpr
+        Float Corner(u32 hash, Vec& gradient, Offset... d) noexcept
+        {
+            Float falloff = Cast<Float>(0.5);
+            ((falloff -= d * d), ...);
+            falloff = Max(falloff, Cast<Float>(0));
+            Float falloff2 = falloff * falloff;
+            Float falloff4 = falloff2 * falloff2;
+
+            Float dot = Implementation::LatticeGradient(hash, d...);
+            if constexpr (WithGradient)
+            {
+                Vec direction = LatticeDirection<Vec>(hash);
+                gradient += direction * falloff4 - Vec(d...) * (Cast<Float>(8) * falloff2 * falloff * dot);
+            }
+            return falloff4 * dot;
+        }
+
+        template <typename Vec>
+        [[nodiscard]] static constexpr
+        Vec LatticeDirection(u32 hash) noexcept
+        {
+            if constexpr (Vec::Dimension == 2)
+            {
+                return Vec(Implementation::LatticeGradient(hash, Cast<Float>(1), Cast<Float>(0)),
+                           Implementation::LatticeGradient(hash, Cast<Float>(0), Cast<Float>(1)));
+            }
+            else
+            {
+                return Vec(Implementation::LatticeGradient(hash, Cast<Float>(1), Cast<Float>(0), Cast<Float>(0)),
+                           Implementation::LatticeGradient(hash, Cast<Float>(0), Cast<Float>(1), Cast<Float>(0)),
+                           Implementation::LatticeGradient(hash, Cast<Float>(0), Cast<Float>(0), Cast<Float>(1)));
+            }
+        }
+
+        [[nodiscard]] constexpr
+        Float Evaluate(Float x, Float y) const noexcept
+        {
+            Vector2T<Float> gradient;
+            return Evaluate<false>(x, y, gradient);
+        }
+
+        template <bool WithGradient>
+        [[nodiscard]] constexpr
+        Float Evaluate(Float x, Float y, Vector2T<Float>& gradient) const noexcept
+        {
+            constexpr Float skew = Cast<Float>(0.36602540378443864676);
+            constexpr Float unskew = Cast<Float>(0.21132486540518711775);
+
+            Float s = (x + y) * skew;
+            Int i = Floor<Int>(x + s);
+            Int j = Floor<Int>(y + s);
+            Float t = Cast<Float>(i + j) * unskew;
+            Float x0 = x - (Cast<Float>(i) - t);
+            Float y0 = y - (Cast<Float>(j) - t);
+
+            u32 i1 = (x0 > y0) ? 1 : 0;
+            u32 j1 = 1 - i1;
+
+            Float x1 = x0 - Cast<Float>(i1) + unskew;
+            Float y1 = y0 - Cast<Float>(j1) + unskew;
+            Float x2 = x0 - Cast<Float>(1) + Cast<Float>(2) * unskew;
+            Float y2 = y0 - Cast<Float>(1) + Cast<Float>(2) * unskew;
+
+            u32 ui = Cast<u32>(i);
+            u32 uj = Cast<u32>(j);
+            Float n0 = Corner<WithGradient>(Implementation::LatticeHash(mSeed, ui,      uj     ), gradient, x0, y0);
+            Float n1 = Corner<WithGradient>(Implementation::LatticeHash(mSeed, ui + i1, uj + j1), gradient, x1, y1);
+            Float n2 = Corner<WithGradient>(Implementation::LatticeHash(mSeed, ui + 1,  uj + 1 ), gradient, x2, y2);
+
+            return Scale2 * (n0 + n1 + n2);
+        }
+
+        [[nodiscard]] constexpr
+        Float Evaluate(Float x, Float y, Float z) const noexcept
+        {
+            Vector3T<Float> gradient;
+            return Evaluate<false>(x, y, z, gradient);
+        }
+
+        template <bool WithGradient>
+        [[nodiscard]] constexpr
+        Float Evaluate(Float x, Float y, Float z, Vector3T<Float>& gradient) const noexcept
+        {
+            constexpr Float skew = Cast<Float>(1.0 / 3.0);
+            constexpr Float unskew = Cast<Float>(1.0 / 6.0);
+
+            Float s = (x + y + z) * skew;
+            Int i = Floor<Int>(x + s);
+            Int j = Floor<Int>(y + s);
+            Int k = Floor<Int>(z + s);
+            Float t = Cast<Float>(i + j + k) * unskew;
+            Float x0 = x - (Cast<Float>(i) - t);
+            Float y0 = y - (Cast<Float>(j) - t);
+            Float z0 = z - (Cast<Float>(k) - t);
+
+            // Note(3011): The ranks of the coordinates are a permutation of
+            // 0, 1, 2 (ties are broken consistently), the simplex walks from the
+            // origin along the axes in the order of decreasing rank.
+            u32 rankX = ((x0 >  y0) ? 1 : 0) + ((x0 >  z0) ? 1 : 0);
+            u32 rankY = ((y0 >= x0) ? 1 : 0) + ((y0 >  z0) ? 1 : 0);
+            u32 rankZ = ((z0 >= x0) ? 1 : 0) + ((z0 >= y0) ? 1 : 0);
+
+            u32 i1 = (rankX >= 2) ? 1 : 0;
+            u32 j1 = (rankY >= 2) ? 1 : 0;
+            u32 k1 = (rankZ >= 2) ? 1 : 0;
+            u32 i2 = (rankX >= 1) ? 1 : 0;
+            u32 j2 = (rankY >= 1) ? 1 : 0;
+            u32 k2 = (rankZ >= 1) ? 1 : 0;
+
+            Float x1 = x0 - Cast<Float>(i1) + unskew;
+            Float y1 = y0 - Cast<Float>(j1) + unskew;
+            Float z1 = z0 - Cast<Float>(k1) + unskew;
+            Float x2 = x0 - Cast<Float>(i2) + Cast<Float>(2) * unskew;
+            Float y2 = y0 - Cast<Float>(j2) + Cast<Float>(2) * unskew;
+            Float z2 = z0 - Cast<Float>(k2) + Cast<Float>(2) * unskew;
+            Float x3 = x0 - Cast<Float>(1) + Cast<Float>(3) * unskew;
+            Float y3 = y0 - Cast<Float>(1) + Cast<Float>(3) * unskew;
+            Float z3 = z0 - Cast<Float>(1) + Cast<Float>(3) * unskew;
+
+            u32 ui = Cast<u32>(i);
+            u32 uj = Cast<u32>(j);
+            u32 uk = Cast<u32>(k);
+            Float n0 = Corner<WithGradient>(Implementation::LatticeHash(mSeed, ui,      uj,      uk     ), gradient, x0, y0, z0);
+            Float n1 = Corner<WithGradient>(Implementation::LatticeHash(mSeed, ui + i1, uj + j1, uk + k1), gradient, x1, y1, z1);
+            Float n2 = Corner<WithGradient>(Implementation::LatticeHash(mSeed, ui + i2, uj + j2, uk + k2), gradient, x2, y2, z2);
+            Float n3 = Corner<WithGradient>(Implementation::LatticeHash(mSeed, ui + 1,  uj + 1,  uk + 1 ), gradient, x3, y3, z3);
+
+            return Scale3 * (n0 + n1 + n2 + n3);
+        }
+
+        [[nodiscard]] constexpr
+        Float Evaluate(Float x, Float y, Float z, Float w) const noexcept
+        {
+            constexpr Float skew = Cast<Float>(0.30901699437494742410);
+            constexpr Float unskew = Cast<Float>(0.13819660112501051518);
+
+            Float s = (x + y + z + w) * skew;
+            Int i = Floor<Int>(x + s);
+            Int j = Floor<Int>(y + s);
+            Int k = Floor<Int>(z + s);
+            Int l = Floor<Int>(w + s);
+            Float t = Cast<Float>(i + j + k + l) * unskew;
+            Float x0 = x - (Cast<Float>(i) - t);
+            Float y0 = y - (Cast<Float>(j) - t);
+            Float z0 = z - (Cast<Float>(k) - t);
+            Float w0 = w - (Cast<Float>(l) - t);
+
+            u32 rankX = ((x0 >  y0) ? 1 : 0) + ((x0 >  z0) ? 1 : 0) + ((x0 >  w0) ? 1 : 0);
+            u32 rankY = ((y0 >= x0) ? 1 : 0) + ((y0 >  z0) ? 1 : 0) + ((y0 >  w0) ? 1 : 0);
+            u32 rankZ = ((z0 >= x0) ? 1 : 0) + ((z0 >= y0) ? 1 : 0) + ((z0 >  w0) ? 1 : 0);
+            u32 rankW = ((w0 >= x0) ? 1 : 0) + ((w0 >= y0) ? 1 : 0) + ((w0 >= z0) ? 1 : 0);
+
+            u32 i1 = (rankX >= 3) ? 1 : 0;
+            u32 j1 = (rankY >= 3) ? 1 : 0;
+            u32 k1 = (rankZ >= 3) ? 1 : 0;
+            u32 l1 = (rankW >= 3) ? 1 : 0;
+            u32 i2 = (rankX >= 2) ? 1 : 0;
+            u32 j2 = (rankY >= 2) ? 1 : 0;
+            u32 k2 = (rankZ >= 2) ? 1 : 0;
+            u32 l2 = (rankW >= 2) ? 1 : 0;
+            u32 i3 = (rankX >= 1) ? 1 : 0;
+            u32 j3 = (rankY >= 1) ? 1 : 0;
+            u32 k3 = (rankZ >= 1) ? 1 : 0;
+            u32 l3 = (rankW >= 1) ? 1 : 0;
+
+            Float x1 = x0 - Cast<Float>(i1) + unskew;
+            Float y1 = y0 - Cast<Float>(j1) + unskew;
+            Float z1 = z0 - Cast<Float>(k1) + unskew;
+            Float w1 = w0 - Cast<Float>(l1) + unskew;
+            Float x2 = x0 - Cast<Float>(i2) + Cast<Float>(2) * unskew;
+            Float y2 = y0 - Cast<Float>(j2) + Cast<Float>(2) * unskew;
+            Float z2 = z0 - Cast<Float>(k2) + Cast<Float>(2) * unskew;
+            Float w2 = w0 - Cast<Float>(l2) + Cast<Float>(2) * unskew;
+            Float x3 = x0 - Cast<Float>(i3) + Cast<Float>(3) * unskew;
+            Float y3 = y0 - Cast<Float>(j3) + Cast<Float>(3) * unskew;
+            Float z3 = z0 - Cast<Float>(k3) + Cast<Float>(3) * unskew;
+            Float w3 = w0 - Cast<Float>(l3) + Cast<Float>(3) * unskew;
+            Float x4 = x0 - Cast<Float>(1) + Cast<Float>(4) * unskew;
+            Float y4 = y0 - Cast<Float>(1) + Cast<Float>(4) * unskew;
+            Float z4 = z0 - Cast<Float>(1) + Cast<Float>(4) * unskew;
+            Float w4 = w0 - Cast<Float>(1) + Cast<Float>(4) * unskew;
+
+            u32 ui = Cast<u32>(i);
+            u32 uj = Cast<u32>(j);
+            u32 uk = Cast<u32>(k);
+            u32 ul = Cast<u32>(l);
+            Float half = Cast<Float>(0.5);
+            Float n0 = Kernel(half - x0 * x0 - y0 * y0 - z0 * z0 - w0 * w0,
+                              Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, ui,      uj,      uk,      ul     ), x0, y0, z0, w0));
+            Float n1 = Kernel(half - x1 * x1 - y1 * y1 - z1 * z1 - w1 * w1,
+                              Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, ui + i1, uj + j1, uk + k1, ul + l1), x1, y1, z1, w1));
+            Float n2 = Kernel(half - x2 * x2 - y2 * y2 - z2 * z2 - w2 * w2,
+                              Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, ui + i2, uj + j2, uk + k2, ul + l2), x2, y2, z2, w2));
+            Float n3 = Kernel(half - x3 * x3 - y3 * y3 - z3 * z3 - w3 * w3,
+                              Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, ui + i3, uj + j3, uk + k3, ul + l3), x3, y3, z3, w3));
+            Float n4 = Kernel(half - x4 * x4 - y4 * y4 - z4 * z4 - w4 * w4,
+                              Implementation::LatticeGradient(Implementation::LatticeHash(mSeed, ui + 1,  uj + 1,  uk + 1,  ul + 1 ), x4, y4, z4, w4));
+
+            return Scale4 * (n0 + n1 + n2 + n3 + n4);
+        }
+
+        // Note(3011): The packet overloads without VectorizedPackets, the
+        // scalar kernels lane by lane.
+        template <typename Packet>
+        [[nodiscard]] constexpr
+        Array<Float, Packet::Width> EvaluateLanes(const Packet& in) const noexcept
+        {
+            Array<Float, Packet::Width> result;
+            for (SizeType lane = 0; lane < Packet::Width; ++lane)
+            {
+                result[lane] = (*this)(in.Get(lane));
+            }
+            return result;
+        }
+
+        // Note(3011):
+        // Staged packet kernel, every stage is a loop over the lanes with a
+        // branch-free body, like in HashedPerlin. The setup (the skewed cell,
+        // the offset from it and the ranks of the offset coordinates) works on
+        // the underlying values, then the d + 1 corners of the simplex are
+        // hashed, then their kernels are summed. Corner c is offset by one
+        // along the axes with a rank of at least d - c, which is the walk of
+        // the scalar kernels, and every expression is evaluated in their
+        // order, so the results match them exactly.
+        template <SizeType D, SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> EvaluatePacket(const Array<Array<Float, N>, D>& points) const noexcept
+        {
+            using RawFloat = UnderlyingType<Float>;
+            using RawInt = UnderlyingType<Int>;
+
+            constexpr RawFloat skew = ToUnderlying((D == 2) ? Cast<Float>(0.36602540378443864676)
+                                                : (D == 3) ? Cast<Float>(1.0 / 3.0)
+                                                           : Cast<Float>(0.30901699437494742410));
+            constexpr RawFloat unskew = ToUnderlying((D == 2) ? Cast<Float>(0.21132486540518711775)
+                                                  : (D == 3) ? Cast<Float>(1.0 / 6.0)
+                                                             : Cast<Float>(0.13819660112501051518));
+            constexpr RawFloat scale = ToUnderlying((D == 2) ? Scale2 : (D == 3) ? Scale3 : Scale4);
+
+            Array<RawFloat, N> sums;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                sums[lane] = ToUnderlying(points[0][lane]);
+            }
+            for (SizeType d = 1; d < D; ++d)
+            {
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    sums[lane] += ToUnderlying(points[d][lane]);
+                }
+            }
+
+            Array<Array<RawInt, N>, D> cells;
+            for (SizeType d = 0; d < D; ++d)
+            {
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    RawFloat point = ToUnderlying(points[d][lane]) + sums[lane] * skew;
+                    RawInt cell = static_cast<RawInt>(point);
+                    cell -= (point < static_cast<RawFloat>(cell)) ? 1 : 0;
+                    cells[d][lane] = cell;
+                }
+            }
+
+            Array<RawInt, N> cellSums = cells[0];
+            for (SizeType d = 1; d < D; ++d)
+            {
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    cellSums[lane] += cells[d][lane];
+                }
+            }
+
+            Array<Array<RawFloat, N>, D> offsets;
+            for (SizeType d = 0; d < D; ++d)
+            {
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    RawFloat t = static_cast<RawFloat>(cellSums[lane]) * unskew;
+                    offsets[d][lane] = ToUnderlying(points[d][lane]) - (static_cast<RawFloat>(cells[d][lane]) - t);
+                }
+            }
+
+            // Note(3011): Ties go to the earlier axis, as in the scalar kernels.
+            Array<Array<u32, N>, D> ranks;
+            for (SizeType a = 0; a < D; ++a)
+            {
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    ranks[a][lane] = 0;
+                }
+                for (SizeType b = 0; b < D; ++b)
+                {
+                    if (b < a)
+                    {
+                        for (SizeType lane = 0; lane < N; ++lane)
+                        {
+                            ranks[a][lane] += (offsets[a][lane] >= offsets[b][lane]) ? 1 : 0;
+                        }
+                    }
+                    else if (b > a)
+                    {
+                        for (SizeType lane = 0; lane < N; ++lane)
+                        {
+                            ranks[a][lane] += (offsets[a][lane] > offsets[b][lane]) ? 1 : 0;
+                        }
+                    }
+                }
+            }
+
+            constexpr Array<u32, 4> primes(Implementation::LatticePrimeX, Implementation::LatticePrimeY,
+                                           Implementation::LatticePrimeZ, Implementation::LatticePrimeW);
+
+            Array<RawFloat, N> values;
+            for (SizeType corner = 0; corner <= D; ++corner)
+            {
+                u32 threshold = Cast<u32>(D - corner);
+                RawFloat shift = static_cast<RawFloat>(ToUnderlying(corner)) * unskew;
+
+                // Note(3011): The same hash as Implementation::LatticeHash,
+                // an axis at a time.
+                Array<u32, N> hashes;
+                Array<Array<RawFloat, N>, D> d;
+                Array<RawFloat, N> falloffs;
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    hashes[lane] = mSeed;
+                    falloffs[lane] = RawFloat(0.5);
+                }
+                for (SizeType a = 0; a < D; ++a)
+                {
+                    for (SizeType lane = 0; lane < N; ++lane)
+                    {
+                        u32 step = (ranks[a][lane] >= threshold) ? 1 : 0;
+                        hashes[lane] ^= (Cast<u32>(cells[a][lane]) + step) * primes[a];
+                        RawFloat offset = (corner == 0) ? offsets[a][lane]
+                                                        : offsets[a][lane] - static_cast<RawFloat>(ToUnderlying(step)) + shift;
+                        falloffs[lane] -= offset * offset;
+                        d[a][lane] = offset;
+                    }
+                }
+
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    u32 hash = Hash32(hashes[lane]);
+                    Float dot;
+                    if constexpr (D == 2)
+                    {
+                        dot = Implementation::LatticeGradient(hash, Float(d[0][lane]), Float(d[1][lane]));
+                    }
+                    else if constexpr (D == 3)
+                    {
+                        dot = Implementation::LatticeGradient(hash, Float(d[0][lane]), Float(d[1][lane]), Float(d[2][lane]));
+                    }
+                    else
+                    {
+                        dot = Implementation::LatticeGradient(hash, Float(d[0][lane]), Float(d[1][lane]), Float(d[2][lane]), Float(d[3][lane]));
+                    }
+
+                    RawFloat falloff = (falloffs[lane] > 0) ? falloffs[lane] : 0;
+                    RawFloat falloff2 = falloff * falloff;
+                    RawFloat value = falloff2 * falloff2 * ToUnderlying(dot);
+                    values[lane] = (corner == 0) ? value : values[lane] + value;
+                }
+            }
+
+            Array<Float, N> result;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                RawFloat value = scale * values[lane] * RawFloat(0.5) + RawFloat(0.5);
+                result[lane] = Float((value > 1) ? 1 : ((value < 0) ? 0 : value));
+            }
+            return result;
+        }
+
+        u32 mSeed;
     };
 }
 
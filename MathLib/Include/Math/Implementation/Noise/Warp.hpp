@@ -0,0 +1,303 @@
+#ifndef MATHLIB_IMPLEMENTATION_NOISE_WARP_HPP
+#define MATHLIB_IMPLEMENTATION_NOISE_WARP_HPP
+
+#include "../Base/Array.hpp"
+#include "../../Functions.hpp"
+#include "../../Vector.hpp"
+#include "Gradient.hpp"
+#include "Grid.hpp"
+
+#include <span>
+
+namespace Math::Implementation
+{
+    // Note(3011): Evaluates a packet with the packet overload of the noise if
+    // it has one, point by point otherwise.
+    template <typename Noise, typename Packet>
+    [[nodiscard]] constexpr
+    auto EvaluateNoisePacket(const Noise& noise, const Packet& in) noexcept
+    {
+        using Float = typename Noise::ValueType;
+
+        if constexpr (requires { { noise(in) } -> Concept::IsSame<Array<Float, Packet::Width>>; })
+        {
+            return noise(in);
+        }
+        else
+        {
+            Array<Float, Packet::Width> result;
+            for (SizeType i = 0; i < Packet::Width; ++i)
+            {
+                result[i] = noise(in.Get(i));
+            }
+            return result;
+        }
+    }
+
+    template <typename Noise, typename Vec>
+    concept NoiseWithGradient = requires (const Noise& noise, const Vec& point)
+    {
+        noise.EvaluateWithGradient(point);
+    };
+
+    // Note(3011): The same for the gradients, with the packet overload of
+    // EvaluateWithGradient if the noise has one.
+    template <typename Noise, typename Packet>
+    [[nodiscard]] constexpr
+    Math::Noise::GradientPacket<Packet> EvaluateGradientPacket(const Noise& noise, const Packet& in) noexcept
+    {
+        if constexpr (requires { { noise.EvaluateWithGradient(in) } -> Concept::IsSame<Math::Noise::GradientPacket<Packet>>; })
+        {
+            return noise.EvaluateWithGradient(in);
+        }
+        else
+        {
+            Math::Noise::GradientPacket<Packet> result;
+            for (SizeType i = 0; i < Packet::Width; ++i)
+            {
+                auto sample = noise.EvaluateWithGradient(in.Get(i));
+                result.Value[i] = sample.Value;
+                result.Gradient.Set(i, sample.Gradient);
+            }
+            return result;
+        }
+    }
+}
+
+namespace Math::Noise
+{
+    enum class WarpField
+    {
+        Offsets,
+        Gradient
+    };
+
+    // Note(3011):
+    // Domain warping, base(p + strength * w(p)), as described by I. Quilez
+    // ("Domain warping", 2002). The warp field w comes from the warper noise
+    // in one of two ways:
+    //
+    // - Gradient uses the analytic gradient of a single evaluation of the
+    //   warper (Perlin and Simplex have EvaluateWithGradient), so all the
+    //   components share the lattice lookups of one evaluation. The field is
+    //   smoother and divergence is tied to the noise. This is the default for
+    //   warpers with gradients.
+    // - Offsets evaluates the warper once per component, at p shifted by a
+    //   different constant offset for every component so they decorrelate,
+    //   and recenters the values to [-1, 1]. This is the classic version, the
+    //   default for warpers without gradients (e.g. Worley), and the fallback
+    //   for a dimension the warper has no EvaluateWithGradient overload for.
+    //
+    // The packet overloads and the span batches evaluate the warper and the
+    // base a packet at a time, the warp field of a packet goes through the
+    // packet overloads of the warper (of EvaluateWithGradient for Gradient,
+    // which Perlin has). Warp has the interface of the other noise functions,
+    // so it nests (a warp of a warp) and works with FillGrid.
+
+    template <typename Base, typename Warper>
+    class Warp final
+    {
+    public:
+        using ValueType = typename Base::ValueType;
+
+        static constexpr SizeType PacketWidth = 8;
+
+        [[nodiscard]] constexpr
+        Warp(const Base& base, const Warper& warper, ValueType strength = Cast<ValueType>(1)) noexcept
+            : mBase(base)
+            , mWarper(warper)
+            , mStrength(strength)
+            , mField(HasAnyGradient ? WarpField::Gradient : WarpField::Offsets)
+        {}
+
+        [[nodiscard]] constexpr
+        Warp(const Base& base, const Warper& warper, ValueType strength, WarpField field) noexcept
+            requires (Implementation::NoiseWithGradient<Warper, Vector2T<ValueType>>
+                   || Implementation::NoiseWithGradient<Warper, Vector3T<ValueType>>)
+            : mBase(base)
+            , mWarper(warper)
+            , mStrength(strength)
+            , mField(field)
+        {}
+
+        [[nodiscard]] constexpr
+        ValueType operator()(const Vector2T<ValueType>& in) const noexcept
+        {
+            return mBase(in + Displacement(in));
+        }
+
+        [[nodiscard]] constexpr
+        ValueType operator()(const Vector3T<ValueType>& in) const noexcept
+        {
+            return mBase(in + Displacement(in));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<ValueType, N> operator()(const Vector2PacketT<ValueType, N>& in) const noexcept
+        {
+            return Implementation::EvaluateNoisePacket(mBase, Displaced(in));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<ValueType, N> operator()(const Vector3PacketT<ValueType, N>& in) const noexcept
+        {
+            return Implementation::EvaluateNoisePacket(mBase, Displaced(in));
+        }
+
+        // Note(3011): out[i] is the noise at points[i], out must be at least
+        // as large as points.
+        constexpr
+        void Evaluate(std::span<const Vector2T<ValueType>> points, std::span<ValueType> out) const noexcept
+        {
+            EvaluateSpan(points, out);
+        }
+
+        constexpr
+        void Evaluate(std::span<const Vector3T<ValueType>> points, std::span<ValueType> out) const noexcept
+        {
+            EvaluateSpan(points, out);
+        }
+
+        [[nodiscard]] constexpr
+        const Base& BaseNoise() const noexcept
+        {
+            return mBase;
+        }
+
+        [[nodiscard]] constexpr
+        const Warper& WarpNoise() const noexcept
+        {
+            return mWarper;
+        }
+    private:
+        using Float = ValueType;
+
+        template <typename Vec>
+        static constexpr bool HasGradient = Implementation::NoiseWithGradient<Warper, Vec>;
+
+        static constexpr bool HasAnyGradient = HasGradient<Vector2T<Float>> || HasGradient<Vector3T<Float>>;
+
+        // Note(3011): Arbitrary offsets that decorrelate the components of the
+        // warp field, far enough apart that they do not share lattice cells.
+        template <typename Vec>
+        [[nodiscard]] static constexpr
+        Vec Offset(SizeType component) noexcept
+        {
+            constexpr Array<Vector3T<Float>, 3> offsets(Vector3T<Float>(Cast<Float>(1.7), Cast<Float>(9.2), Cast<Float>(4.1)),
+                                                        Vector3T<Float>(Cast<Float>(8.3), Cast<Float>(2.8), Cast<Float>(6.5)),
+                                                        Vector3T<Float>(Cast<Float>(5.2), Cast<Float>(1.3), Cast<Float>(7.9)));
+
+            if constexpr (Vec::Dimension == 2)
+            {
+                return Vec(offsets[component].x, offsets[component].y);
+            }
+            else
+            {
+                return offsets[component];
+            }
+        }
+
+        template <typename Vec>
+        [[nodiscard]] constexpr
+        Vec Displacement(const Vec& in) const noexcept
+        {
+            if constexpr (HasGradient<Vec>)
+            {
+                if (mField == WarpField::Gradient)
+                {
+                    return mWarper.EvaluateWithGradient(in).Gradient * mStrength;
+                }
+            }
+
+            Vec displacement;
+            for (SizeType c = 0; c < Vec::Dimension; ++c)
+            {
+                displacement[c] = (mWarper(in + Offset<Vec>(c)) * Cast<Float>(2) - Cast<Float>(1)) * mStrength;
+            }
+            return displacement;
+        }
+
+        template <typename Packet>
+        [[nodiscard]] constexpr
+        Packet Displaced(const Packet& in) const noexcept
+        {
+            using Vec = decltype(in.Get(0));
+
+            Packet result = in;
+            if constexpr (HasGradient<Vec>)
+            {
+                if (mField == WarpField::Gradient)
+                {
+                    Packet gradient = Implementation::EvaluateGradientPacket(mWarper, in).Gradient;
+                    for (SizeType lane = 0; lane < Packet::Width; ++lane)
+                    {
+                        result.x[lane] += gradient.x[lane] * mStrength;
+                        result.y[lane] += gradient.y[lane] * mStrength;
+                        if constexpr (Vec::Dimension == 3)
+                        {
+                            result.z[lane] += gradient.z[lane] * mStrength;
+                        }
+                    }
+                    return result;
+                }
+            }
+
+            Packet shifted;
+            for (SizeType c = 0; c < Vec::Dimension; ++c)
+            {
+                Vec offset = Offset<Vec>(c);
+                for (SizeType lane = 0; lane < Packet::Width; ++lane)
+                {
+                    shifted.Set(lane, in.Get(lane) + offset);
+                }
+
+                Array<Float, Packet::Width> values = Implementation::EvaluateNoisePacket(mWarper, shifted);
+                for (SizeType lane = 0; lane < Packet::Width; ++lane)
+                {
+                    Vec point = result.Get(lane);
+                    point[c] += (values[lane] * Cast<Float>(2) - Cast<Float>(1)) * mStrength;
+                    result.Set(lane, point);
+                }
+            }
+            return result;
+        }
+
+        template <typename Vec>
+        constexpr
+        void EvaluateSpan(std::span<const Vec> points, std::span<Float> out) const noexcept
+        {
+            using Packet = typename Implementation::GridPacket<Vec, PacketWidth>::Type;
+
+            SizeType count = points.size();
+            SizeType i = 0;
+            Packet packet;
+            for (; i + PacketWidth <= count; i += PacketWidth)
+            {
+                for (SizeType lane = 0; lane < PacketWidth; ++lane)
+                {
+                    packet.Set(lane, points[ToUnderlying(i + lane)]);
+                }
+
+                Array<Float, PacketWidth> values = (*this)(packet);
+                for (SizeType lane = 0; lane < PacketWidth; ++lane)
+                {
+                    out[ToUnderlying(i + lane)] = values[lane];
+                }
+            }
+
+            for (; i < count; ++i)
+            {
+                out[ToUnderlying(i)] = (*this)(points[ToUnderlying(i)]);
+            }
+        }
+
+        Base mBase;
+        Warper mWarper;
+        Float mStrength;
+        WarpField mField;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_NOISE_WARP_HPP
@@ -2,39 +2,513 @@
 #define MATHLIB_IMPLEMENTATION_NOISE_WORLEY_HPP
 
 #include "../Base/Array.hpp"
-#include "../../Random.hpp"
+#include "../Sequences/Scrambling.hpp"
+#include "../../Functions.hpp"
 #include "../../Vector.hpp"
+#include "Lattice.hpp"
 
 namespace Math::Noise
 {
+    enum class WorleyMetric
+    {
+        Euclidean,
+        Manhattan,
+        Chebyshev
+    };
+
+    enum class WorleyOutput
+    {
+        F1,
+        F2,
+        F2MinusF1
+    };
+
+    // Note(3011): Distances to the closest and second closest feature points
+    // and the hash of the cell of the closest one, which is a stable ID of the
+    // Voronoi cell (e.g. for coloring the cells).
+    template <Concept::FloatingPointType Float>
+    struct WorleySample final
+    {
+        Float F1;
+        Float F2;
+        u32 CellID;
+    };
+
+    // Note(3011):
+    // Cellular noise by S. Worley, "A Cellular Texture Basis Function" (1996),
+    // with one feature point per unit cell, placed by hashing the cell. Only
+    // the 3^d cells around the point are searched, which is the common
+    // approximation, with full jitter a closer point two cells away is
+    // possible but very rare. The scalar path visits the own cell first and
+    // skips the neighbours whose closest point is already farther than the
+    // current F2, in 3D that usually leaves fewer than half of the 27 cells.
+    //
+    // The packet overloads evaluate all the neighbours for every lane with
+    // branch-free updates instead, coherent pruning does not pay off across
+    // lanes. They keep F1, F2 and the cell IDs in separate per-lane arrays and
+    // scan the cells a stage at a time, which vectorizes. Unlike the gradient
+    // noises this is faster than the scalar search even with only SSE2, the
+    // pruning costs the scalar path more than the emulated multiplies cost
+    // the packets, so there is no lane by lane fallback.
+    //
+    // The distances are not normalized, F1 is mostly in [0, 1] for the
+    // Euclidean metric, but can reach sqrt(d) in theory.
+
     template <Concept::FloatingPointType Float>
     class Worley final
     {
     public:
         using ValueType = Float;
+        using SampleType = WorleySample<Float>;
+
+        static constexpr SizeType PacketWidth = 8;
 
         [[nodiscard]] constexpr explicit
-        Worley(u64 seed = 0) noexcept
+        Worley(u64 seed = 0, WorleyMetric metric = WorleyMetric::Euclidean, WorleyOutput output = WorleyOutput::F1) noexcept
+            : mSeed(Cast<u32>(Hash64(seed)))
+            , mMetric(metric)
+            , mOutput(output)
         {}
 
         [[nodiscard]] constexpr
         Float operator()(const Vector2T<Float>& in) const noexcept
         {
-            return Float(0);
+            return Select(Evaluate(in));
         }
 
         [[nodiscard]] constexpr
         Float operator()(const Vector3T<Float>& in) const noexcept
         {
-            return Float(0);
+            return Select(Evaluate(in));
         }
 
         [[nodiscard]] constexpr
         Float operator()(const Vector4T<Float>& in) const noexcept
         {
-            return Float(0);
+            return Select(Evaluate(in));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector2PacketT<Float, N>& in) const noexcept
+        {
+            Array<Array<Float, N>, 2> points;
+            points[0] = in.x;
+            points[1] = in.y;
+            return Select(EvaluatePacket(points));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector3PacketT<Float, N>& in) const noexcept
+        {
+            Array<Array<Float, N>, 3> points;
+            points[0] = in.x;
+            points[1] = in.y;
+            points[2] = in.z;
+            return Select(EvaluatePacket(points));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> operator()(const Vector4PacketT<Float, N>& in) const noexcept
+        {
+            Array<Array<Float, N>, 4> points;
+            points[0] = in.x;
+            points[1] = in.y;
+            points[2] = in.z;
+            points[3] = in.w;
+            return Select(EvaluatePacket(points));
+        }
+
+        [[nodiscard]] constexpr
+        SampleType Evaluate(const Vector2T<Float>& in) const noexcept
+        {
+            return EvaluatePoint(Array<Float, 2>(in.x, in.y));
+        }
+
+        [[nodiscard]] constexpr
+        SampleType Evaluate(const Vector3T<Float>& in) const noexcept
+        {
+            return EvaluatePoint(Array<Float, 3>(in.x, in.y, in.z));
+        }
+
+        [[nodiscard]] constexpr
+        SampleType Evaluate(const Vector4T<Float>& in) const noexcept
+        {
+            return EvaluatePoint(Array<Float, 4>(in.x, in.y, in.z, in.w));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<SampleType, N> Evaluate(const Vector2PacketT<Float, N>& in) const noexcept
+        {
+            Array<Array<Float, N>, 2> points;
+            points[0] = in.x;
+            points[1] = in.y;
+            return Samples(EvaluatePacket(points));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<SampleType, N> Evaluate(const Vector3PacketT<Float, N>& in) const noexcept
+        {
+            Array<Array<Float, N>, 3> points;
+            points[0] = in.x;
+            points[1] = in.y;
+            points[2] = in.z;
+            return Samples(EvaluatePacket(points));
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<SampleType, N> Evaluate(const Vector4PacketT<Float, N>& in) const noexcept
+        {
+            Array<Array<Float, N>, 4> points;
+            points[0] = in.x;
+            points[1] = in.y;
+            points[2] = in.z;
+            points[3] = in.w;
+            return Samples(EvaluatePacket(points));
         }
     private:
+        using Int = SignedIntegerSelector<sizeof(Float)>;
+
+        template <SizeType N>
+        struct PacketSamples final
+        {
+            Array<Float, N> F1;
+            Array<Float, N> F2;
+            Array<u32, N> CellID;
+        };
+
+        static constexpr Float sFar = Cast<Float>(1.0e30);
+
+        [[nodiscard]] static constexpr
+        u32 CubeOf3(SizeType dimension) noexcept
+        {
+            u32 result = 1;
+            for (SizeType i = 0; i < dimension; ++i)
+            {
+                result *= 3;
+            }
+            return result;
+        }
+
+        template <SizeType N>
+        [[nodiscard]] constexpr
+        Array<Float, N> Select(const PacketSamples<N>& samples) const noexcept
+        {
+            switch (mOutput)
+            {
+            case WorleyOutput::F2:
+                return samples.F2;
+            case WorleyOutput::F2MinusF1:
+            {
+                Array<Float, N> result;
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    result[lane] = samples.F2[lane] - samples.F1[lane];
+                }
+                return result;
+            }
+            default:
+                return samples.F1;
+            }
+        }
+
+        template <SizeType N>
+        [[nodiscard]] static constexpr
+        Array<SampleType, N> Samples(const PacketSamples<N>& samples) noexcept
+        {
+            Array<SampleType, N> result;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                result[lane] = SampleType{ samples.F1[lane], samples.F2[lane], samples.CellID[lane] };
+            }
+            return result;
+        }
+
+        [[nodiscard]] constexpr
+        Float Select(const SampleType& sample) const noexcept
+        {
+            switch (mOutput)
+            {
+            case WorleyOutput::F2:
+                return sample.F2;
+            case WorleyOutput::F2MinusF1:
+                return sample.F2 - sample.F1;
+            default:
+                return sample.F1;
+            }
+        }
+
+        // Note(3011): The searches compare the distances without the final
+        // square root of the Euclidean metric.
+        [[nodiscard]] constexpr
+        Float Accumulate(Float distance, Float delta) const noexcept
+        {
+            switch (mMetric)
+            {
+            case WorleyMetric::Manhattan:
+                return distance + Abs(delta);
+            case WorleyMetric::Chebyshev:
+                return Max(distance, Abs(delta));
+            default:
+                return distance + delta * delta;
+            }
+        }
+
+        // Note(3011): The same operations on the underlying values, for the
+        // packet kernel.
+        template <WorleyMetric Metric, typename T>
+        [[nodiscard]] static constexpr
+        T Accumulate(T distance, T delta) noexcept
+        {
+            T magnitude = (delta > 0) ? delta : -delta;
+            if constexpr (Metric == WorleyMetric::Manhattan)
+            {
+                return distance + magnitude;
+            }
+            else if constexpr (Metric == WorleyMetric::Chebyshev)
+            {
+                return (distance > magnitude) ? distance : magnitude;
+            }
+            else
+            {
+                return distance + delta * delta;
+            }
+        }
+
+        [[nodiscard]] constexpr
+        Float Finish(Float distance) const noexcept
+        {
+            return (mMetric == WorleyMetric::Euclidean) ? Sqrt(distance) : distance;
+        }
+
+        template <WorleyMetric Metric>
+        [[nodiscard]] static constexpr
+        Float Finish(Float distance) noexcept
+        {
+            if constexpr (Metric == WorleyMetric::Euclidean)
+            {
+                return Sqrt(distance);
+            }
+            else
+            {
+                return distance;
+            }
+        }
+
+        // Note(3011): The feature point coordinates are drawn from a chain of
+        // hashes of the cell hash.
+        template <SizeType D>
+        [[nodiscard]] static constexpr
+        Array<Float, D> FeaturePoint(u32 cellHash) noexcept
+        {
+            Array<Float, D> result;
+            for (SizeType i = 0; i < D; ++i)
+            {
+                cellHash = Hash32(cellHash + 0x9E3779B9);
+                result[i] = UnitFromBits<Float>(cellHash);
+            }
+            return result;
+        }
+
+        static constexpr
+        void Insert(SampleType& sample, Float distance, u32 cellHash) noexcept
+        {
+            sample.F2 = Min(sample.F2, Max(sample.F1, distance));
+            sample.CellID = (distance < sample.F1) ? cellHash : sample.CellID;
+            sample.F1 = Min(sample.F1, distance);
+        }
+
+        template <SizeType D>
+        [[nodiscard]] constexpr
+        SampleType EvaluatePoint(const Array<Float, D>& point) const noexcept
+        {
+            constexpr u32 cellCount = CubeOf3(D);
+            constexpr u32 ownCell = cellCount / 2;
+
+            Array<u32, D> base;
+            Array<Float, D> local;
+            for (SizeType i = 0; i < D; ++i)
+            {
+                Int cell = Floor<Int>(point[i]);
+                base[i] = Cast<u32>(cell);
+                local[i] = point[i] - Cast<Float>(cell);
+            }
+
+            SampleType sample{ sFar, sFar, 0 };
+            for (u32 c = 0; c < cellCount; ++c)
+            {
+                // Note(3011): Start with the own cell, it is likely to contain
+                // the closest point and makes the pruning effective early.
+                u32 index = (c == 0) ? ownCell : (c == ownCell) ? 0 : c;
+
+                Array<u32, D> cell;
+                Array<Float, D> offset;
+                Float bound = Cast<Float>(0);
+                for (SizeType i = 0; i < D; ++i)
+                {
+                    u32 digit = index % 3;
+                    index /= 3;
+                    cell[i] = base[i] + digit - 1;
+                    offset[i] = Cast<Float>(digit) - Cast<Float>(1) - local[i];
+                    Float gap = (digit == 0) ? local[i] : (digit == 2) ? Cast<Float>(1) - local[i] : Cast<Float>(0);
+                    bound = Accumulate(bound, gap);
+                }
+
+                if (bound >= sample.F2)
+                {
+                    continue;
+                }
+
+                u32 cellHash = Implementation::LatticeHash(mSeed, cell);
+                Array<Float, D> feature = FeaturePoint<D>(cellHash);
+                Float distance = Cast<Float>(0);
+                for (SizeType i = 0; i < D; ++i)
+                {
+                    distance = Accumulate(distance, offset[i] + feature[i]);
+                }
+                Insert(sample, distance, cellHash);
+            }
+
+            sample.F1 = Finish(sample.F1);
+            sample.F2 = Finish(sample.F2);
+            return sample;
+        }
+
+        // Note(3011): The metric is a template argument of the packet kernel,
+        // so its lane loops have no switch in them.
+        template <SizeType D, SizeType N>
+        [[nodiscard]] constexpr
+        PacketSamples<N> EvaluatePacket(const Array<Array<Float, N>, D>& points) const noexcept
+        {
+            switch (mMetric)
+            {
+            case WorleyMetric::Manhattan:
+                return EvaluatePacket<WorleyMetric::Manhattan>(points);
+            case WorleyMetric::Chebyshev:
+                return EvaluatePacket<WorleyMetric::Chebyshev>(points);
+            default:
+                return EvaluatePacket<WorleyMetric::Euclidean>(points);
+            }
+        }
+
+        // Note(3011):
+        // Every stage is a loop over the lanes with a branch-free body on the
+        // underlying values, as in HashedPerlin. That includes the hashes, GCC
+        // copies the strong integer types as aggregates and does not vectorize
+        // those copies. For each of the 3^d cells the
+        // lanes hash the cell an axis at a time, walk the hash chain of the
+        // feature point an axis at a time while accumulating the distance, and
+        // then update F1, F2 and the cell ID. The operations are the ones of
+        // the scalar search, so the results match it exactly.
+        template <WorleyMetric Metric, SizeType D, SizeType N>
+        [[nodiscard]] constexpr
+        PacketSamples<N> EvaluatePacket(const Array<Array<Float, N>, D>& points) const noexcept
+        {
+            constexpr u32 cellCount = CubeOf3(D);
+            constexpr Array<u32, 4> primes(Implementation::LatticePrimeX, Implementation::LatticePrimeY,
+                                           Implementation::LatticePrimeZ, Implementation::LatticePrimeW);
+
+            using RawFloat = UnderlyingType<Float>;
+            using RawInt = UnderlyingType<Int>;
+            using RawHash = UnderlyingType<u32>;
+
+            Array<Array<RawHash, N>, D> base;
+            Array<Array<RawFloat, N>, D> local;
+            for (SizeType d = 0; d < D; ++d)
+            {
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    RawFloat point = ToUnderlying(points[d][lane]);
+                    RawInt cell = static_cast<RawInt>(point);
+                    cell -= (point < static_cast<RawFloat>(cell)) ? 1 : 0;
+                    base[d][lane] = static_cast<RawHash>(cell);
+                    local[d][lane] = point - static_cast<RawFloat>(cell);
+                }
+            }
+
+            Array<RawFloat, N> f1;
+            Array<RawFloat, N> f2;
+            Array<RawHash, N> ids;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                f1[lane] = ToUnderlying(sFar);
+                f2[lane] = ToUnderlying(sFar);
+                ids[lane] = 0;
+            }
+
+            for (u32 c = 0; c < cellCount; ++c)
+            {
+                Array<RawHash, D> steps;
+                Array<RawFloat, D> shifts;
+                u32 index = c;
+                for (SizeType d = 0; d < D; ++d)
+                {
+                    RawHash digit = ToUnderlying(index % 3);
+                    steps[d] = digit - 1;
+                    shifts[d] = static_cast<RawFloat>(digit) - 1;
+                    index /= 3;
+                }
+
+                Array<RawHash, N> hashes;
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    hashes[lane] = ToUnderlying(mSeed);
+                }
+                for (SizeType d = 0; d < D; ++d)
+                {
+                    RawHash prime = ToUnderlying(primes[d]);
+                    for (SizeType lane = 0; lane < N; ++lane)
+                    {
+                        hashes[lane] ^= (base[d][lane] + steps[d]) * prime;
+                    }
+                }
+
+                Array<RawHash, N> chains;
+                Array<RawFloat, N> distances;
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    hashes[lane] = ToUnderlying(Hash32(u32(hashes[lane])));
+                    chains[lane] = hashes[lane];
+                    distances[lane] = 0;
+                }
+                for (SizeType d = 0; d < D; ++d)
+                {
+                    for (SizeType lane = 0; lane < N; ++lane)
+                    {
+                        chains[lane] = ToUnderlying(Hash32(u32(chains[lane] + 0x9E3779B9)));
+                        RawFloat delta = (shifts[d] - local[d][lane]) + ToUnderlying(UnitFromBits<Float>(u32(chains[lane])));
+                        distances[lane] = Accumulate<Metric>(distances[lane], delta);
+                    }
+                }
+
+                for (SizeType lane = 0; lane < N; ++lane)
+                {
+                    RawFloat distance = distances[lane];
+                    RawFloat farther = (f1[lane] > distance) ? f1[lane] : distance;
+                    f2[lane] = (f2[lane] < farther) ? f2[lane] : farther;
+                    ids[lane] = (distance < f1[lane]) ? hashes[lane] : ids[lane];
+                    f1[lane] = (f1[lane] < distance) ? f1[lane] : distance;
+                }
+            }
+
+            PacketSamples<N> samples;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                samples.F1[lane] = Finish<Metric>(Float(f1[lane]));
+                samples.F2[lane] = Finish<Metric>(Float(f2[lane]));
+                samples.CellID[lane] = u32(ids[lane]);
+            }
+            return samples;
+        }
+
+        u32 mSeed;
+        WorleyMetric mMetric;
+        WorleyOutput mOutput;
     };
 }
 
@@ -0,0 +1,316 @@
+#ifndef MATHLIB_IMPLEMENTATION_RANDOM_ALIAS_TABLE_HPP
+#define MATHLIB_IMPLEMENTATION_RANDOM_ALIAS_TABLE_HPP
+
+#include "../Base/Concepts.hpp"
+#include "../Base/Parallel.hpp"
+#include "../Functions/BasicFunctions.hpp"
+#include "Utils.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Math
+{
+    // Note(3011):
+    // Walker's alias method with Vose's O(n) construction. Every entry is 8 bytes,
+    // the acceptance threshold is stored as a 32-bit fixed point fraction, so that
+    // a single 64-bit random value picks both the bucket (upper half) and the
+    // threshold comparison (lower half). The bucket is picked by a multiply-shift
+    // instead of rejection, the resulting bias is at most n / 2^32, which is far
+    // below anything measurable for tables that fit in memory. The normalized
+    // probabilities are kept in a separate array, they are only needed for PDF
+    // queries and would just take space in the cache lines touched while sampling.
+    //
+    // The pairing is the sweep of L. Hübschle-Schneider, P. Sanders, "Parallel
+    // Weighted Random Sampling" (2019): the light entries (scaled weight below 1)
+    // and the heavy ones are kept in index order, and the current heavy entry
+    // fills the next light one until its own weight drops to 1 or below, then it
+    // is filled from the next heavy one. Whether a light entry or the current
+    // heavy one goes next only depends on the deficit of the lights before it
+    // and the surplus of the heavies up to the current one, so the sweep is a
+    // merge of those two prefix sums. The merge is split into parts at the
+    // points a binary search finds, and the parts run on threadCount threads.
+    // The prefix sums are taken over chunks of ParallelGrain weights, so the
+    // table is the same for any number of threads.
+
+    template <Concept::StrongFloatType T>
+    class AliasTable final
+    {
+    public:
+        using ValueType = u32;
+        using WeightType = T;
+
+        struct Entry
+        {
+            u32 Threshold;
+            u32 Alias;
+        };
+
+        static_assert(sizeof(Entry) == 8);
+
+        // Note(3011): The fewest weights a build task works on.
+        static constexpr SizeType ParallelGrain = 16384;
+
+        [[nodiscard]]
+        AliasTable() noexcept = default;
+
+        [[nodiscard]] explicit
+        AliasTable(std::span<const T> weights, SizeType threadCount = HardwareThreadCount())
+        {
+            Build(weights, threadCount);
+        }
+
+        void Build(std::span<const T> weights, SizeType threadCount = HardwareThreadCount())
+        {
+            SizeType count = weights.size();
+            mEntries.assign(ToUnderlying(count), Entry{ u32::Max(), 0 });
+            mProbabilities.assign(ToUnderlying(count), Cast<T>(0));
+            if (count == 0)
+            {
+                return;
+            }
+
+            SizeType chunks = (count + ParallelGrain - 1) / ParallelGrain;
+            auto forChunks = [&](auto&& func)
+            {
+                ParallelFor(chunks, [&](SizeType chunk)
+                {
+                    func(chunk, chunk * ParallelGrain, Min((chunk + 1) * ParallelGrain, count));
+                }, threadCount);
+            };
+
+            std::vector<f64> chunkTotals(ToUnderlying(chunks));
+            forChunks([&](SizeType chunk, SizeType begin, SizeType end)
+            {
+                f64 sum = 0.0;
+                for (SizeType i = begin; i < end; ++i)
+                {
+                    sum += Cast<f64>(Max(weights[ToUnderlying(i)], Cast<T>(0)));
+                }
+                chunkTotals[ToUnderlying(chunk)] = sum;
+            });
+
+            f64 total = 0.0;
+            for (f64 sum : chunkTotals)
+            {
+                total += sum;
+            }
+
+            // Note(3011): Degenerate weights fall back to a uniform distribution.
+            f64 invTotal = (total > 0.0) ? 1.0 / total : 0.0;
+            f64 uniform = 1.0 / Cast<f64>(count);
+
+            std::vector<f64> scaled(ToUnderlying(count));
+            std::vector<SizeType> lightOffsets(ToUnderlying(chunks));
+            forChunks([&](SizeType chunk, SizeType begin, SizeType end)
+            {
+                SizeType lightCount = 0;
+                for (SizeType i = begin; i < end; ++i)
+                {
+                    f64 probability = (total > 0.0) ? Cast<f64>(Max(weights[ToUnderlying(i)], Cast<T>(0))) * invTotal : uniform;
+                    mProbabilities[ToUnderlying(i)] = Cast<T>(probability);
+                    scaled[ToUnderlying(i)] = probability * Cast<f64>(count);
+                    if (scaled[ToUnderlying(i)] < 1.0)
+                    {
+                        ++lightCount;
+                    }
+                }
+                lightOffsets[ToUnderlying(chunk)] = lightCount;
+            });
+
+            SizeType lightCount = 0;
+            for (SizeType& offset : lightOffsets)
+            {
+                SizeType chunkLights = offset;
+                offset = lightCount;
+                lightCount += chunkLights;
+            }
+            SizeType heavyCount = count - lightCount;
+
+            // Note(3011): The lights go to the front of the worklist and the
+            // heavies after them, both in index order. Next to them the sums
+            // hold the deficit of the lights before every light and the surplus
+            // of the heavies up to every heavy, first within the chunk and then
+            // with the chunks before it added.
+            std::vector<u32> worklist(ToUnderlying(count));
+            std::vector<f64> sums(ToUnderlying(count));
+            std::vector<f64> deficits(ToUnderlying(chunks));
+            std::vector<f64> surpluses(ToUnderlying(chunks));
+            forChunks([&](SizeType chunk, SizeType begin, SizeType end)
+            {
+                SizeType light = lightOffsets[ToUnderlying(chunk)];
+                SizeType heavy = lightCount + begin - light;
+                f64 deficit = 0.0;
+                f64 surplus = 0.0;
+                for (SizeType i = begin; i < end; ++i)
+                {
+                    f64 weight = scaled[ToUnderlying(i)];
+                    if (weight < 1.0)
+                    {
+                        worklist[ToUnderlying(light)] = Cast<u32>(i);
+                        sums[ToUnderlying(light++)] = deficit;
+                        deficit += 1.0 - weight;
+                    }
+                    else
+                    {
+                        surplus += weight - 1.0;
+                        worklist[ToUnderlying(heavy)] = Cast<u32>(i);
+                        sums[ToUnderlying(heavy++)] = surplus;
+                    }
+                }
+                deficits[ToUnderlying(chunk)] = deficit;
+                surpluses[ToUnderlying(chunk)] = surplus;
+            });
+
+            f64 deficit = 0.0;
+            f64 surplus = 0.0;
+            for (SizeType chunk = 0; chunk < chunks; ++chunk)
+            {
+                f64 chunkDeficit = deficits[ToUnderlying(chunk)];
+                f64 chunkSurplus = surpluses[ToUnderlying(chunk)];
+                deficits[ToUnderlying(chunk)] = deficit;
+                surpluses[ToUnderlying(chunk)] = surplus;
+                deficit += chunkDeficit;
+                surplus += chunkSurplus;
+            }
+
+            forChunks([&](SizeType chunk, SizeType begin, SizeType end)
+            {
+                SizeType lightBegin = lightOffsets[ToUnderlying(chunk)];
+                SizeType lightEnd = (chunk + 1 < chunks) ? lightOffsets[ToUnderlying(chunk + 1)] : lightCount;
+                for (SizeType i = lightBegin; i < lightEnd; ++i)
+                {
+                    sums[ToUnderlying(i)] += deficits[ToUnderlying(chunk)];
+                }
+
+                SizeType heavyBegin = lightCount + begin - lightBegin;
+                SizeType heavyEnd = lightCount + end - lightEnd;
+                for (SizeType i = heavyBegin; i < heavyEnd; ++i)
+                {
+                    sums[ToUnderlying(i)] += surpluses[ToUnderlying(chunk)];
+                }
+            });
+
+            // Note(3011): Rounding can leave no heavy entry at all when the
+            // weights are (close to) uniform, every entry is full then.
+            if (heavyCount == 0)
+            {
+                for (SizeType i = 0; i < count; ++i)
+                {
+                    mEntries[ToUnderlying(i)] = Entry{ u32::Max(), Cast<u32>(i) };
+                }
+                return;
+            }
+
+            // Note(3011): The last heavy entry takes whatever the others leave
+            // over and is full up to rounding errors, every other entry is one
+            // step of the merge.
+            auto lightSum = [&](SizeType light) { return (light < lightCount) ? sums[ToUnderlying(light)] : deficit; };
+            auto heavySum = [&](SizeType heavy) { return sums[ToUnderlying(lightCount + heavy)]; };
+            auto lightFirst = [&](SizeType light, SizeType heavy)
+            {
+                return light < lightCount && (heavy + 1 >= heavyCount || lightSum(light) < heavySum(heavy));
+            };
+
+            SizeType steps = count - 1;
+            SizeType parts = Max((steps + ParallelGrain - 1) / ParallelGrain, SizeType(1));
+            ParallelFor(parts, [&](SizeType part)
+            {
+                SizeType begin = steps * part / parts;
+                SizeType end = steps * (part + 1) / parts;
+
+                // Note(3011): The number of lights among the first begin steps,
+                // the first light that comes after the heavy it would replace.
+                SizeType low = (begin + 1 > heavyCount) ? begin + 1 - heavyCount : SizeType(0);
+                SizeType high = Min(begin, lightCount);
+                while (low < high)
+                {
+                    SizeType middle = low + (high - low) / 2;
+                    if (lightFirst(middle, begin - middle - 1))
+                    {
+                        low = middle + 1;
+                    }
+                    else
+                    {
+                        high = middle;
+                    }
+                }
+
+                SizeType light = low;
+                SizeType heavy = begin - low;
+                for (SizeType step = begin; step < end; ++step)
+                {
+                    u32 heavyIndex = worklist[ToUnderlying(lightCount + heavy)];
+                    if (lightFirst(light, heavy))
+                    {
+                        u32 lightIndex = worklist[ToUnderlying(light++)];
+                        mEntries[ToUnderlying(lightIndex)] = Entry{ ToThreshold(scaled[ToUnderlying(lightIndex)]), heavyIndex };
+                    }
+                    else
+                    {
+                        f64 remaining = 1.0 + heavySum(heavy) - lightSum(light);
+                        u32 nextIndex = worklist[ToUnderlying(lightCount + ++heavy)];
+                        mEntries[ToUnderlying(heavyIndex)] = Entry{ ToThreshold(remaining), nextIndex };
+                    }
+                }
+            }, threadCount);
+
+            u32 lastIndex = worklist[ToUnderlying(count - 1)];
+            mEntries[ToUnderlying(lastIndex)] = Entry{ u32::Max(), lastIndex };
+        }
+
+        template <Concept::RandomNumberGenerator RNG>
+        [[nodiscard]]
+        ValueType operator()(RNG& rng) const noexcept
+        {
+            return Sample(GetRandomBits<u64>(rng));
+        }
+
+        [[nodiscard]]
+        ValueType Sample(u64 bits) const noexcept
+        {
+            u64 bucket = ((bits >> 32) * Cast<u64>(mEntries.size())) >> 32;
+            const Entry& entry = mEntries[ToUnderlying(bucket)];
+            return (Cast<u32>(bits) < entry.Threshold) ? Cast<u32>(bucket) : entry.Alias;
+        }
+
+        [[nodiscard]]
+        ValueType Sample(T u) const noexcept
+        {
+            // Note(3011): This keeps 53 bits of the sample at most, which is plenty,
+            // the threshold comparison only uses 32 bits anyway.
+            f64 scaled = Clamp(Cast<f64>(u), Cast<f64>(0), Cast<f64>(1)) * 0x1.0p64;
+            return Sample((scaled >= 0x1.0p64) ? u64::Max() : Cast<u64>(scaled));
+        }
+
+        [[nodiscard]]
+        T Pdf(ValueType index) const noexcept
+        {
+            return mProbabilities[ToUnderlying(index)];
+        }
+
+        [[nodiscard]]
+        SizeType Size() const noexcept
+        {
+            return mEntries.size();
+        }
+
+        [[nodiscard]]
+        std::span<const Entry> Entries() const noexcept
+        {
+            return mEntries;
+        }
+    private:
+        [[nodiscard]] static
+        u32 ToThreshold(f64 probability) noexcept
+        {
+            f64 scaled = Max(probability, Cast<f64>(0)) * 0x1.0p32;
+            return (scaled >= 0x1.0p32) ? u32::Max() : Cast<u32>(scaled);
+        }
+
+        std::vector<Entry> mEntries;
+        std::vector<T> mProbabilities;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_RANDOM_ALIAS_TABLE_HPP
@@ -0,0 +1,204 @@
+#ifndef MATHLIB_IMPLEMENTATION_RANDOM_PERMUTATION_HPP
+#define MATHLIB_IMPLEMENTATION_RANDOM_PERMUTATION_HPP
+
+#include "../Base/Array.hpp"
+#include "../Base/Concepts.hpp"
+#include "../Functions/Hash.hpp"
+#include "Utils.hpp"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Math
+{
+    namespace Implementation
+    {
+        // Note(3011): Performs Count consecutive steps of the forward Fisher-Yates
+        // shuffle, starting at position first, with all bounds drawn at once.
+        template <std::size_t Count, typename T, Concept::RandomNumberGenerator RNG>
+        constexpr
+        void ShuffleSteps(std::span<T> values, std::size_t first, RNG& rng) noexcept
+        {
+            u64 bounds[Count];
+            u64 offsets[Count];
+            for (std::size_t i = 0; i < Count; ++i)
+            {
+                bounds[i] = Cast<u64>(values.size() - first - i);
+            }
+
+            BoundedRandomBatch(rng, bounds, offsets);
+            for (std::size_t i = 0; i < Count; ++i)
+            {
+                std::swap(values[first + i], values[first + i + ToUnderlying(offsets[i])]);
+            }
+        }
+    }
+
+    // Note(3011):
+    // Moves a uniformly random selection of count elements, in uniformly random
+    // order, to the front of values. This is the forward Fisher-Yates shuffle
+    // stopped after count steps. The bounded draws are batched, several
+    // indices come out of one 64-bit random value while the product of their
+    // bounds fits into 64 bits, which covers all but the largest spans.
+
+    template <typename T, Concept::RandomNumberGenerator RNG>
+    constexpr
+    void PartialShuffle(std::span<T> values, SizeType count, RNG& rng) noexcept
+    {
+        std::size_t size = values.size();
+        std::size_t end = (ToUnderlying(count) < size) ? ToUnderlying(count) : size;
+
+        std::size_t i = 0;
+        while (i < end)
+        {
+            std::size_t remaining = size - i;
+            std::size_t steps = end - i;
+            if (steps >= 4 && remaining <= (std::size_t(1) << 15))
+            {
+                Implementation::ShuffleSteps<4>(values, i, rng);
+                i += 4;
+            }
+            else if (steps >= 3 && remaining <= (std::size_t(1) << 21))
+            {
+                Implementation::ShuffleSteps<3>(values, i, rng);
+                i += 3;
+            }
+            else if (steps >= 2 && Cast<u64>(remaining) <= (u64(1) << 32))
+            {
+                Implementation::ShuffleSteps<2>(values, i, rng);
+                i += 2;
+            }
+            else
+            {
+                Implementation::ShuffleSteps<1>(values, i, rng);
+                i += 1;
+            }
+        }
+    }
+
+    // Note(3011): Unbiased Fisher-Yates shuffle, every permutation is equally likely.
+    template <typename T, Concept::RandomNumberGenerator RNG>
+    constexpr
+    void Shuffle(std::span<T> values, RNG& rng) noexcept
+    {
+        // Note(3011): The last step would always swap the last element with itself.
+        PartialShuffle(values, (values.size() > 1) ? values.size() - 1 : 0, rng);
+    }
+
+    template <typename T, SizeType N, Concept::RandomNumberGenerator RNG>
+    constexpr
+    void Shuffle(Array<T, N>& array, RNG& rng) noexcept
+    {
+        if constexpr (N > 1)
+        {
+            Shuffle(std::span<T>(array.Data(), ToUnderlying(N)), rng);
+        }
+    }
+
+    template <Concept::RandomNumberGenerator RNG>
+    [[nodiscard]]
+    std::vector<u32> RandomPermutation(u32 size, RNG& rng)
+    {
+        std::vector<u32> result(ToUnderlying(size));
+        for (std::size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = Cast<u32>(i);
+        }
+
+        Shuffle(std::span<u32>(result), rng);
+        return result;
+    }
+
+    // Note(3011):
+    // Returns count distinct indices from [0, size), every subset is equally
+    // likely. Dense selections are the prefix of a partial shuffle, sparse ones
+    // use R. Floyd's algorithm, which needs exactly count bounded draws and
+    // memory proportional to count instead of size. The order of the indices
+    // is only random in the dense case, shuffle the result if that matters.
+
+    template <Concept::RandomNumberGenerator RNG>
+    [[nodiscard]]
+    std::vector<u32> SampleWithoutReplacement(u32 count, u32 size, RNG& rng)
+    {
+        count = (count < size) ? count : size;
+
+        if (Cast<u64>(count) * 4 >= Cast<u64>(size))
+        {
+            std::vector<u32> result(ToUnderlying(size));
+            for (std::size_t i = 0; i < result.size(); ++i)
+            {
+                result[i] = Cast<u32>(i);
+            }
+
+            PartialShuffle(std::span<u32>(result), Cast<SizeType>(count), rng);
+            result.resize(ToUnderlying(count));
+            return result;
+        }
+
+        // Note(3011): Open addressing set of the selected indices, the table
+        // is kept at most half full. All indices are below size, so u32::Max()
+        // is free to mark empty slots.
+        u32 capacity = 1;
+        while (capacity < count * 2)
+        {
+            capacity <<= 1;
+        }
+        std::vector<u32> table(ToUnderlying(capacity), u32::Max());
+        u32 mask = capacity - 1;
+
+        auto insert = [&](u32 value)
+        {
+            u32 slot = Hash32(value) & mask;
+            while (table[ToUnderlying(slot)] != u32::Max())
+            {
+                if (table[ToUnderlying(slot)] == value)
+                {
+                    return false;
+                }
+                slot = (slot + 1) & mask;
+            }
+            table[ToUnderlying(slot)] = value;
+            return true;
+        };
+
+        std::vector<u32> result;
+        result.reserve(ToUnderlying(count));
+
+        u32 j = size - count;
+        while (j < size)
+        {
+            // Note(3011): The draws do not depend on the set, so two of them
+            // can share one random value, the product of the bounds is at most
+            // 2^32 * (2^32 - 1).
+            u64 bounds[2] = { Cast<u64>(j) + 1, Cast<u64>(j) + 2 };
+            u64 draws[2] = {};
+            std::size_t drawCount = (size - j >= 2) ? 2 : 1;
+            if (drawCount == 2)
+            {
+                BoundedRandomBatch(rng, bounds, draws);
+            }
+            else
+            {
+                draws[0] = BoundedRandom(rng, bounds[0]);
+            }
+
+            for (std::size_t i = 0; i < drawCount; ++i, ++j)
+            {
+                u32 selected = Cast<u32>(draws[i]);
+                if (!insert(selected))
+                {
+                    // Note(3011): j itself cannot be in the set yet.
+                    selected = j;
+                    insert(selected);
+                }
+                result.push_back(selected);
+            }
+        }
+
+        return result;
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_RANDOM_PERMUTATION_HPP
@@ -1,13 +1,22 @@
 #ifndef MATHLIB_IMPLEMENTATION_RANDOM_POISSON_DISTRIBUTION_HPP
 #define MATHLIB_IMPLEMENTATION_RANDOM_POISSON_DISTRIBUTION_HPP
 
+#include "../Functions/FloatUtils.hpp"
+#include "../Functions/Log.hpp"
 #include "UniformDistribution.hpp"
 
 namespace Math
 {
     // Note(3011):
-    // Works fine for mean values up to ~700 (doubles/f64) or ~100 (floats/f32).
-    // This is not ideal, but it should work fine for most purposes.
+    // Small means are sampled by inverting the CDF, which is the fastest option
+    // while the expected number of iterations (~mean) stays small. Larger means
+    // switch to the PTRS transformed rejection method by W. Hörmann, "The
+    // transformed rejection method for generating Poisson random variables"
+    // (1993), which needs ~1.2 iterations on average regardless of the mean.
+    // The rejection step always runs in f64, since the log-probabilities involved
+    // cancel catastrophically in f32 for means in the tens of thousands. The
+    // inversion sums the CDF in f64 too, in f32 it stops growing just below the
+    // largest uniform draws.
 
     template <Concept::StrongIntegerType T>
     class PoissonDistribution
@@ -16,32 +25,116 @@ namespace Math
         using ValueType = T;
         using MeanType = FloatingPointSelector<sizeof(ValueType)>;
 
+        static constexpr f64 RejectionThreshold = 10.0;
+
         [[nodiscard]] constexpr
         PoissonDistribution(MeanType mean = Cast<MeanType>(0))
-            : mUniform(Cast<MeanType>(0), Cast<MeanType>(1)), mMean(mean)
-        {}
+            : mUniform(Cast<MeanType>(0), Cast<MeanType>(1)), mMean(mean),
+              mExpMean(), mLogMean(), mA(), mB(), mInvAlpha(), mVr()
+        {
+            f64 mean64 = Cast<f64>(mean);
+            if (mean64 < RejectionThreshold)
+            {
+                mExpMean = Exp(-mean64);
+                return;
+            }
+
+            f64 sqrtMean = Sqrt(mean64);
+            mLogMean = Log(mean64);
+            mB = 0.931 + 2.53 * sqrtMean;
+            mA = -0.059 + 0.02483 * mB;
+            mInvAlpha = 1.1239 + 1.1328 / (mB - 3.4);
+            mVr = 0.9277 - 3.6224 / (mB - 2.0);
+        }
 
         template <Concept::RandomNumberGenerator RNG>
         [[nodiscard]] constexpr
         ValueType operator()(RNG& rng) const noexcept
         {
-            MeanType uniformSample = mUniform(rng);
+            if (Cast<f64>(mMean) < RejectionThreshold)
+            {
+                return SampleInversion(rng);
+            }
 
+            return SampleRejection(rng);
+        }
+
+        [[nodiscard]] constexpr
+        MeanType Mean() const noexcept
+        {
+            return mMean;
+        }
+    private:
+        template <Concept::RandomNumberGenerator RNG>
+        [[nodiscard]] constexpr
+        ValueType SampleInversion(RNG& rng) const noexcept
+        {
+            f64 uniformSample = Cast<f64>(mUniform(rng));
+            f64 mean = Cast<f64>(mMean);
+
+            // Note(3011): Stops once the terms no longer change the sum, the
+            // f64 CDF can still end up below the largest f64 draws.
             ValueType i = 0;
-            MeanType p = Exp(-mMean);
-            MeanType cdf = p;
+            f64 p = mExpMean;
+            f64 cdf = p;
             while (uniformSample >= cdf)
             {
-                p = (mMean * p) / Cast<MeanType>(i + 1);
-                cdf += p;
+                p = (mean * p) / Cast<f64>(i + 1);
+                f64 next = cdf + p;
+                if (next == cdf)
+                {
+                    break;
+                }
+
+                cdf = next;
                 i++;
             }
 
             return i;
         }
-    private:
+
+        template <Concept::RandomNumberGenerator RNG>
+        [[nodiscard]] constexpr
+        ValueType SampleRejection(RNG& rng) const noexcept
+        {
+            UniformUnitDistribution<f64> unit;
+            f64 mean = Cast<f64>(mMean);
+
+            while (true)
+            {
+                f64 u = unit(rng) - 0.5;
+                f64 v = unit(rng);
+                f64 us = 0.5 - Abs(u);
+                f64 k = Floor((2.0 * mA / us + mB) * u + mean + 0.43);
+
+                if (us >= 0.07 && v <= mVr)
+                {
+                    return Cast<ValueType>(k);
+                }
+
+                if (k < 0.0 || (us < 0.013 && v > us))
+                {
+                    continue;
+                }
+
+                f64 lhs = Log(v) + Log(mInvAlpha) - Log(mA / Squared(us) + mB);
+                f64 rhs = -mean + k * mLogMean - LogGamma(k + 1.0);
+                if (lhs <= rhs)
+                {
+                    return Cast<ValueType>(k);
+                }
+            }
+        }
+
         UniformDistribution<MeanType> mUniform;
         MeanType mMean;
+
+        f64 mExpMean;
+        f64 mLogMean;
+        f64 mA;
+        f64 mB;
+        f64 mInvAlpha;
+        f64 mVr;
     };
 }
 
@@ -0,0 +1,109 @@
+#ifndef MATHLIB_IMPLEMENTATION_RANDOM_RESERVOIR_HPP
+#define MATHLIB_IMPLEMENTATION_RANDOM_RESERVOIR_HPP
+
+#include "../Base/Concepts.hpp"
+#include "../Functions/BasicFunctions.hpp"
+#include "../Functions/FloatUtils.hpp"
+#include "../Functions/Log.hpp"
+#include "UniformDistribution.hpp"
+#include "Utils.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Math
+{
+    // Note(3011):
+    // Uniform sample of a fixed number of values from a stream of unknown length.
+    // This is "Algorithm L" by K.-H. Li, "Reservoir-Sampling Algorithms of Time
+    // Complexity O(n(1 + log(N/n)))" (1994). Instead of drawing a random number
+    // for every value, it draws the (geometrically distributed) number of values
+    // to skip until the next replacement, so a long stream costs about
+    // capacity * log(length / capacity) draws in total.
+
+    template <typename T>
+    class ReservoirSampler final
+    {
+    public:
+        using ValueType = T;
+
+        [[nodiscard]] explicit
+        ReservoirSampler(SizeType capacity)
+            : mSamples(), mCapacity(capacity), mSeen(0), mNext(0), mLogW(0.0)
+        {
+            mSamples.reserve(ToUnderlying(capacity));
+        }
+
+        template <Concept::RandomNumberGenerator RNG>
+        void Add(const T& value, RNG& rng)
+        {
+            ++mSeen;
+            if (mSeen <= Cast<u64>(mCapacity))
+            {
+                mSamples.push_back(value);
+                if (mSeen == Cast<u64>(mCapacity))
+                {
+                    mLogW = LogUniform(rng) / Cast<f64>(mCapacity);
+                    Advance(rng);
+                }
+                return;
+            }
+
+            if (mSeen == mNext)
+            {
+                mSamples[ToUnderlying(BoundedRandom(rng, Cast<u64>(mCapacity)))] = value;
+                mLogW += LogUniform(rng) / Cast<f64>(mCapacity);
+                Advance(rng);
+            }
+        }
+
+        [[nodiscard]]
+        std::span<const T> Samples() const noexcept
+        {
+            return mSamples;
+        }
+
+        [[nodiscard]]
+        u64 Seen() const noexcept
+        {
+            return mSeen;
+        }
+
+        void Clear() noexcept
+        {
+            mSamples.clear();
+            mSeen = 0;
+            mNext = 0;
+            mLogW = 0.0;
+        }
+    private:
+        // Note(3011): Log of a uniform value in (0, 1].
+        template <Concept::RandomNumberGenerator RNG>
+        [[nodiscard]] static
+        f64 LogUniform(RNG& rng) noexcept
+        {
+            return Log(1.0 - UniformUnitDistribution<f64>()(rng));
+        }
+
+        template <Concept::RandomNumberGenerator RNG>
+        void Advance(RNG& rng) noexcept
+        {
+            // Note(3011): W only ever decreases, once it drops below the
+            // rounding error of 1 - W, plain Log would make the skips infinite.
+            f64 log1mW = Log1p(-Exp(mLogW));
+            f64 skip = LogUniform(rng) / log1mW;
+
+            // Note(3011): Keeps the skip representable, a stream this long
+            // would not be finished anyway.
+            mNext = mSeen + Cast<u64>(Floor(Min(skip, f64(0x1.0p62)))) + 1;
+        }
+
+        std::vector<T> mSamples;
+        SizeType mCapacity;
+        u64 mSeen;
+        u64 mNext;
+        f64 mLogW;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_RANDOM_RESERVOIR_HPP
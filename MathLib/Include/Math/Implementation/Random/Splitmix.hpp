@@ -8,6 +8,8 @@ namespace Math::Implementation
     class Splitmix32 final
     {
     public:
+        using ValueType = u32;
+
         [[nodiscard]] constexpr
         Splitmix32(u32 seed = 0) noexcept
             : mState(seed)
@@ -29,6 +31,8 @@ namespace Math::Implementation
     class Splitmix64 final
     {
     public:
+        using ValueType = u64;
+
         [[nodiscard]] constexpr
         Splitmix64(u64 seed = 0) noexcept
             : mState(seed)
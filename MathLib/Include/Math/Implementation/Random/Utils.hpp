@@ -2,8 +2,12 @@
 #define MATHLIB_IMPLEMENTATION_RANDOM_UTILS_HPP
 
 #include "../Base/Concepts.hpp"
+#include "../Functions/IntUtils.hpp"
 #include "../Functions/ValueShift.hpp"
 
+#include <cstddef>
+#include <span>
+
 namespace Math
 {
     template <Concept::StrongType T, Concept::RandomNumberGenerator RNG>
@@ -28,6 +32,70 @@ namespace Math
             return result;
         }
     }
+
+    // Note(3011):
+    // Draws Count independent integers, the k-th one from [0, bounds[k]), out of
+    // a single 64-bit random value, as described by N. Brackett-Rozinsky and
+    // D. Lemire in "Batched Ranged Random Integer Generation" (2024). This is
+    // Lemire's multiply-shift method applied repeatedly to the low half of the
+    // previous product, so the product of all bounds must fit into 64 bits.
+    // The results are exactly uniform, the rejection step (and the division in
+    // it) is only reached with probability product / 2^64.
+
+    template <std::size_t Count, Concept::RandomNumberGenerator RNG>
+    constexpr
+    void BoundedRandomBatch(RNG& rng, const u64 (&bounds)[Count], u64 (&results)[Count]) noexcept
+    {
+        u64 product = 1;
+        u64 leftover = GetRandomBits<u64>(rng);
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            WideProduct wide = MultiplyWide(leftover, bounds[i]);
+            results[i] = wide.High;
+            leftover = wide.Low;
+            product *= bounds[i];
+        }
+
+        if (leftover < product)
+        {
+            u64 threshold = (u64::Max() - product + 1) % product;
+            while (leftover < threshold)
+            {
+                leftover = GetRandomBits<u64>(rng);
+                for (std::size_t i = 0; i < Count; ++i)
+                {
+                    WideProduct wide = MultiplyWide(leftover, bounds[i]);
+                    results[i] = wide.High;
+                    leftover = wide.Low;
+                }
+            }
+        }
+    }
+
+    template <Concept::RandomNumberGenerator RNG>
+    [[nodiscard]] constexpr
+    u64 BoundedRandom(RNG& rng, u64 bound) noexcept
+    {
+        u64 bounds[1] = { bound };
+        u64 results[1] = {};
+        BoundedRandomBatch(rng, bounds, results);
+        return results[0];
+    }
+
+    // Note(3011): Batch form of drawing from a distribution, fills the whole
+    // span. Keeping the loop inside a single call lets the compiler hold the
+    // generator and distribution state in registers across draws.
+
+    template <typename Dist, Concept::RandomNumberGenerator RNG>
+        requires requires (const Dist& dist, RNG& rng) { { dist(rng) } -> Concept::IsSame<typename Dist::ValueType>; }
+    constexpr
+    void Generate(std::span<typename Dist::ValueType> out, const Dist& dist, RNG& rng)
+    {
+        for (typename Dist::ValueType& value : out)
+        {
+            value = dist(rng);
+        }
+    }
 }
 
 #endif //MATHLIB_IMPLEMENTATION_RANDOM_UTILS_HPP
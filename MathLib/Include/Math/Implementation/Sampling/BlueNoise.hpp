@@ -0,0 +1,255 @@
+#ifndef MATHLIB_IMPLEMENTATION_SAMPLING_BLUE_NOISE_HPP
+#define MATHLIB_IMPLEMENTATION_SAMPLING_BLUE_NOISE_HPP
+
+#include "../../Functions.hpp"
+#include "../../Random.hpp"
+
+#include <cassert>
+#include <vector>
+
+namespace Math
+{
+    namespace Implementation
+    {
+        // Note(3011): Tournament tree over a fixed set of keys, keeps the index
+        // of the best key (the smallest or the largest one) up to date in
+        // O(log n) per changed key.
+        template <bool Largest>
+        class TournamentTree final
+        {
+        public:
+            [[nodiscard]] explicit
+            TournamentTree(SizeType size)
+                : mLeafCount(1)
+            {
+                while (mLeafCount < size)
+                {
+                    mLeafCount <<= 1;
+                }
+
+                f64 worst = Largest ? -f64::Infinity() : f64::Infinity();
+                mKeys.assign(ToUnderlying(mLeafCount) * 2, worst);
+                mIndices.assign(ToUnderlying(mLeafCount) * 2, 0);
+                for (SizeType i = 0; i < mLeafCount; ++i)
+                {
+                    mIndices[ToUnderlying(mLeafCount + i)] = Cast<u32>(i);
+                }
+                for (SizeType node = mLeafCount - 1; node > 0; --node)
+                {
+                    Refresh(node);
+                }
+            }
+
+            void Update(u32 index, f64 key) noexcept
+            {
+                SizeType node = mLeafCount + Cast<SizeType>(index);
+                mKeys[ToUnderlying(node)] = key;
+                for (node >>= 1; node > 0; node >>= 1)
+                {
+                    Refresh(node);
+                }
+            }
+
+            [[nodiscard]]
+            u32 Best() const noexcept
+            {
+                return mIndices[1];
+            }
+        private:
+            void Refresh(SizeType node) noexcept
+            {
+                SizeType left = node * 2;
+                SizeType right = left + 1;
+                bool pickRight = Largest ? (mKeys[ToUnderlying(right)] > mKeys[ToUnderlying(left)])
+                                         : (mKeys[ToUnderlying(right)] < mKeys[ToUnderlying(left)]);
+                SizeType best = pickRight ? right : left;
+                mKeys[ToUnderlying(node)] = mKeys[ToUnderlying(best)];
+                mIndices[ToUnderlying(node)] = mIndices[ToUnderlying(best)];
+            }
+
+            SizeType mLeafCount;
+            std::vector<f64> mKeys;
+            std::vector<u32> mIndices;
+        };
+
+        // Note(3011): Binary pattern on a torus, together with the energy of every
+        // pixel, i.e. the sum of a Gaussian over the toroidal distances to all set
+        // pixels. The Gaussian is truncated to a window, so setting or clearing a
+        // pixel only updates the window around it. If the window is larger than the
+        // pattern, the offsets wrap around more than once, which sums the periodic
+        // copies of the Gaussian just like the full kernel on a torus would.
+        class BlueNoisePattern final
+        {
+        public:
+            [[nodiscard]]
+            BlueNoisePattern(u32 width, u32 height, f64 sigma)
+                : mWidth(width), mHeight(height), mRadius(Cast<i32>(Ceil<i64>(3.0 * sigma))),
+                  mKernel(), mSet(ToUnderlying(Cast<SizeType>(width) * Cast<SizeType>(height)), 0),
+                  mEnergy(ToUnderlying(Cast<SizeType>(width) * Cast<SizeType>(height)), 0.0),
+                  mVoids(Cast<SizeType>(width) * Cast<SizeType>(height)),
+                  mClusters(Cast<SizeType>(width) * Cast<SizeType>(height))
+            {
+                f64 scale = -1.0 / (2.0 * Squared(sigma));
+                for (i32 y = -mRadius; y <= mRadius; ++y)
+                {
+                    for (i32 x = -mRadius; x <= mRadius; ++x)
+                    {
+                        mKernel.push_back(Exp(Cast<f64>(x * x + y * y) * scale));
+                    }
+                }
+
+                for (std::size_t i = 0; i < mEnergy.size(); ++i)
+                {
+                    Refresh(Cast<u32>(i));
+                }
+            }
+
+            void Set(u32 index, bool value) noexcept
+            {
+                mSet[ToUnderlying(index)] = value ? 1 : 0;
+                f64 sign = value ? 1.0 : -1.0;
+
+                i64 x0 = Cast<i64>(index % mWidth);
+                i64 y0 = Cast<i64>(index / mWidth);
+                i64 width = Cast<i64>(mWidth);
+                i64 height = Cast<i64>(mHeight);
+                std::size_t kernelIndex = 0;
+                for (i32 dy = -mRadius; dy <= mRadius; ++dy)
+                {
+                    i64 y = ((y0 + Cast<i64>(dy)) % height + height) % height;
+                    for (i32 dx = -mRadius; dx <= mRadius; ++dx, ++kernelIndex)
+                    {
+                        i64 x = ((x0 + Cast<i64>(dx)) % width + width) % width;
+                        u32 pixel = Cast<u32>(y * width + x);
+                        mEnergy[ToUnderlying(pixel)] += sign * mKernel[kernelIndex];
+                        Refresh(pixel);
+                    }
+                }
+            }
+
+            [[nodiscard]]
+            bool IsSet(u32 index) const noexcept
+            {
+                return mSet[ToUnderlying(index)] != 0;
+            }
+
+            // Note(3011): The unset pixel with the lowest energy.
+            [[nodiscard]]
+            u32 LargestVoid() const noexcept
+            {
+                return mVoids.Best();
+            }
+
+            // Note(3011): The set pixel with the highest energy.
+            [[nodiscard]]
+            u32 TightestCluster() const noexcept
+            {
+                return mClusters.Best();
+            }
+        private:
+            void Refresh(u32 pixel) noexcept
+            {
+                f64 energy = mEnergy[ToUnderlying(pixel)];
+                bool set = IsSet(pixel);
+                mVoids.Update(pixel, set ? f64::Infinity() : energy);
+                mClusters.Update(pixel, set ? energy : -f64::Infinity());
+            }
+
+            u32 mWidth;
+            u32 mHeight;
+            i32 mRadius;
+            std::vector<f64> mKernel;
+            std::vector<u8> mSet;
+            std::vector<f64> mEnergy;
+            TournamentTree<false> mVoids;
+            TournamentTree<true> mClusters;
+        };
+    }
+
+    namespace Sampling
+    {
+        // Note(3011):
+        // Tileable blue noise threshold mask, generated with the void-and-cluster
+        // method by R. Ulichney (1993). Returns width * height thresholds in
+        // [0, 1), row by row, thresholding at t sets a fraction t of the pixels,
+        // and every such set is evenly spread, including across the edges.
+        // The energy is windowed and the extremes are kept in tournament trees,
+        // so every rank costs O(sigma^2 log n) instead of a full O(n) scan.
+        //
+        // Pixels are indexed with u32, extents with more than u32::Max() pixels
+        // assert, release builds get an empty mask.
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]]
+        std::vector<T> BlueNoiseMask(u32 width, u32 height, u64 seed, f64 sigma = 1.5)
+        {
+            SizeType pixels = Cast<SizeType>(width) * Cast<SizeType>(height);
+            if (pixels > Cast<SizeType>(u32::Max()))
+            {
+                assert(false && "Blue noise mask extents out of range");
+                return {};
+            }
+
+            u32 pixelCount = Cast<u32>(pixels);
+            if (pixelCount == 0)
+            {
+                return {};
+            }
+
+            // Note(3011): Initial pattern, random pixels that are relaxed until
+            // moving the tightest cluster does not change it anymore.
+            Random64 rng(seed);
+            Implementation::BlueNoisePattern initial(width, height, sigma);
+            u32 initialCount = Max(pixelCount / 10, u32(1));
+            for (u32 pixel : SampleWithoutReplacement(initialCount, pixelCount, rng))
+            {
+                initial.Set(pixel, true);
+            }
+
+            for (u32 iteration = 0; iteration < pixelCount; ++iteration)
+            {
+                u32 cluster = initial.TightestCluster();
+                initial.Set(cluster, false);
+                u32 gap = initial.LargestVoid();
+                initial.Set(gap, true);
+                if (gap == cluster)
+                {
+                    break;
+                }
+            }
+
+            std::vector<u32> ranks(ToUnderlying(pixelCount));
+
+            // Note(3011): Ranks below the initial count, remove the tightest clusters.
+            Implementation::BlueNoisePattern pattern = initial;
+            for (u32 rank = initialCount; rank > 0; --rank)
+            {
+                u32 cluster = pattern.TightestCluster();
+                pattern.Set(cluster, false);
+                ranks[ToUnderlying(cluster)] = rank - 1;
+            }
+
+            // Note(3011): The remaining ranks fill the largest voids. Ulichney
+            // looks for the tightest cluster of unset pixels past one half instead,
+            // but the energies of the set and unset pixels add up to the same
+            // constant everywhere, so that is the same pixel.
+            pattern = initial;
+            for (u32 rank = initialCount; rank < pixelCount; ++rank)
+            {
+                u32 gap = pattern.LargestVoid();
+                pattern.Set(gap, true);
+                ranks[ToUnderlying(gap)] = rank;
+            }
+
+            std::vector<T> result(ToUnderlying(pixelCount));
+            f64 scale = 1.0 / Cast<f64>(pixelCount);
+            for (std::size_t i = 0; i < result.size(); ++i)
+            {
+                result[i] = Cast<T>((Cast<f64>(ranks[i]) + 0.5) * scale);
+            }
+            return result;
+        }
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_SAMPLING_BLUE_NOISE_HPP
@@ -0,0 +1,395 @@
+#ifndef MATHLIB_IMPLEMENTATION_SAMPLING_POISSON_DISK_HPP
+#define MATHLIB_IMPLEMENTATION_SAMPLING_POISSON_DISK_HPP
+
+#include "../Base/Array.hpp"
+#include "../Base/Parallel.hpp"
+#include "../../Constants.hpp"
+#include "../../Functions.hpp"
+#include "../../Geometry.hpp"
+#include "../../Point.hpp"
+#include "../../Random.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+    namespace Implementation
+    {
+        // Note(3011):
+        // Bridson's algorithm, "Fast Poisson Disk Sampling in Arbitrary Dimensions"
+        // (2007), on a background grid with cells of size radius / sqrt(Dimension),
+        // so every cell holds at most one sample and conflicts are found by looking
+        // at the 5^Dimension surrounding cells.
+        //
+        // To run in parallel, the grid is split into tiles that are processed in
+        // 2^Dimension phases, a tile only takes part in the phase matching the
+        // parities of its coordinates. New samples never leave their tile and the
+        // conflict checks reach at most two cells outside of it, so tiles of the
+        // same phase (which are a whole tile apart) never touch the same cells.
+        // Every tile has its own generator seeded from its index, which makes the
+        // result independent of the number of threads.
+
+        template <Concept::StrongFloatType T, SizeType Dimension>
+        class PoissonDiskSampler final
+        {
+        public:
+            using PositionType = Array<T, Dimension>;
+            using CellType = Array<i64, Dimension>;
+
+            static_assert(Dimension == 2 || Dimension == 3);
+
+            static constexpr i64 TileCells = (Dimension == 2) ? 32 : 8;
+            static constexpr SizeType PhaseCount = SizeType(1) << ToUnderlying(Dimension);
+
+            [[nodiscard]]
+            PoissonDiskSampler(const PositionType& min, const PositionType& max, T radius, u32 attempts)
+                : mMin(min), mMax(max), mRadius(radius), mRadiusSqr(Squared(radius)),
+                  mCellSize(radius / Sqrt(Cast<T>(Dimension))), mInvCellSize(Cast<T>(1) / mCellSize),
+                  mAttempts(attempts), mCells(), mTiles(), mCellCount(1), mTileCount(1)
+            {
+                for (SizeType i = 0; i < Dimension; ++i)
+                {
+                    mCells[i] = Max(Ceil<i64>((mMax[i] - mMin[i]) * mInvCellSize), i64(1));
+                    mTiles[i] = (mCells[i] + TileCells - 1) / TileCells;
+                    mCellCount *= Cast<SizeType>(mCells[i]);
+                    mTileCount *= Cast<SizeType>(mTiles[i]);
+                }
+            }
+
+            template <Concept::Invocable<const PositionType&> Inside>
+            [[nodiscard]]
+            std::vector<PositionType> Generate(u64 seed, Inside&& inside, SizeType threadCount)
+            {
+                mOccupied.assign(ToUnderlying(mCellCount), 0);
+                mPositions.resize(ToUnderlying(mCellCount));
+
+                std::vector<std::vector<PositionType>> tileSamples(ToUnderlying(mTileCount));
+                std::vector<SizeType> phaseTiles;
+                for (SizeType phase = 0; phase < PhaseCount; ++phase)
+                {
+                    phaseTiles.clear();
+                    for (SizeType tile = 0; tile < mTileCount; ++tile)
+                    {
+                        if (TilePhase(TileCoordinates(tile)) == phase)
+                        {
+                            phaseTiles.push_back(tile);
+                        }
+                    }
+
+                    ParallelFor(phaseTiles.size(), [&](SizeType i)
+                    {
+                        SizeType tile = phaseTiles[ToUnderlying(i)];
+                        ProcessTile(tile, seed, inside, tileSamples[ToUnderlying(tile)]);
+                    }, threadCount);
+                }
+
+                std::vector<PositionType> result;
+                for (const std::vector<PositionType>& samples : tileSamples)
+                {
+                    result.insert(result.end(), samples.begin(), samples.end());
+                }
+                return result;
+            }
+        private:
+            [[nodiscard]]
+            CellType TileCoordinates(SizeType tile) const noexcept
+            {
+                CellType result;
+                i64 index = Cast<i64>(tile);
+                for (SizeType i = 0; i < Dimension; ++i)
+                {
+                    result[i] = index % mTiles[i];
+                    index /= mTiles[i];
+                }
+                return result;
+            }
+
+            [[nodiscard]] static
+            SizeType TilePhase(const CellType& tile) noexcept
+            {
+                SizeType result = 0;
+                for (SizeType i = 0; i < Dimension; ++i)
+                {
+                    result |= Cast<SizeType>(tile[i] & 1) << i;
+                }
+                return result;
+            }
+
+            [[nodiscard]]
+            SizeType CellIndex(const CellType& cell) const noexcept
+            {
+                i64 result = 0;
+                for (SizeType i = Dimension; i > 0; --i)
+                {
+                    result = result * mCells[i - 1] + cell[i - 1];
+                }
+                return Cast<SizeType>(result);
+            }
+
+            [[nodiscard]]
+            CellType CellOf(const PositionType& position) const noexcept
+            {
+                CellType result;
+                for (SizeType i = 0; i < Dimension; ++i)
+                {
+                    result[i] = Floor<i64>((position[i] - mMin[i]) * mInvCellSize);
+                }
+                return result;
+            }
+
+            [[nodiscard]]
+            bool HasConflict(const PositionType& position, const CellType& cell) const noexcept
+            {
+                // Note(3011): Cells are radius / sqrt(Dimension) wide, so anything
+                // closer than the radius is at most two cells away.
+                constexpr SizeType neighbourhoodSize = (Dimension == 2) ? 25 : 125;
+                for (SizeType offset = 0; offset < neighbourhoodSize; ++offset)
+                {
+                    CellType neighbour;
+                    SizeType digits = offset;
+                    bool valid = true;
+                    for (SizeType i = 0; i < Dimension; ++i)
+                    {
+                        neighbour[i] = cell[i] + Cast<i64>(digits % 5) - 2;
+                        digits /= 5;
+                        valid = valid && neighbour[i] >= 0 && neighbour[i] < mCells[i];
+                    }
+
+                    if (!valid)
+                    {
+                        continue;
+                    }
+
+                    SizeType index = CellIndex(neighbour);
+                    if (mOccupied[ToUnderlying(index)] == 0)
+                    {
+                        continue;
+                    }
+
+                    T distanceSqr = 0;
+                    const PositionType& other = mPositions[ToUnderlying(index)];
+                    for (SizeType i = 0; i < Dimension; ++i)
+                    {
+                        distanceSqr += Squared(position[i] - other[i]);
+                    }
+
+                    if (distanceSqr < mRadiusSqr)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            [[nodiscard]]
+            PositionType AnnulusOffset(Random64& rng) const noexcept
+            {
+                // Note(3011): Uniform in the volume of the shell between one and
+                // two radii.
+                UniformUnitDistribution<T> unit;
+                PositionType result;
+                if constexpr (Dimension == 2)
+                {
+                    T angle = Constant::Tau<T> * unit(rng);
+                    T distance = mRadius * Sqrt(Cast<T>(1) + Cast<T>(3) * unit(rng));
+                    result[0] = distance * Cos(angle);
+                    result[1] = distance * Sin(angle);
+                }
+                else
+                {
+                    T z = Cast<T>(1) - Cast<T>(2) * unit(rng);
+                    T ring = Sqrt(Max(Cast<T>(1) - Squared(z), Cast<T>(0)));
+                    T angle = Constant::Tau<T> * unit(rng);
+                    T distance = mRadius * Cbrt(Cast<T>(1) + Cast<T>(7) * unit(rng));
+                    result[0] = distance * ring * Cos(angle);
+                    result[1] = distance * ring * Sin(angle);
+                    result[2] = distance * z;
+                }
+                return result;
+            }
+
+            template <typename Inside>
+            void ProcessTile(SizeType tile, u64 seed, Inside& inside, std::vector<PositionType>& samples)
+            {
+                CellType tileCoordinates = TileCoordinates(tile);
+                CellType cellBegin;
+                CellType cellEnd;
+                PositionType tileMin;
+                PositionType tileExtent;
+                for (SizeType i = 0; i < Dimension; ++i)
+                {
+                    cellBegin[i] = tileCoordinates[i] * TileCells;
+                    cellEnd[i] = Min(cellBegin[i] + TileCells, mCells[i]);
+                    tileMin[i] = mMin[i] + Cast<T>(cellBegin[i]) * mCellSize;
+                    tileExtent[i] = Min(mMax[i], mMin[i] + Cast<T>(cellEnd[i]) * mCellSize) - tileMin[i];
+                }
+
+                Random64 rng(Hash64(seed ^ Hash64(Cast<u64>(tile))));
+                UniformUnitDistribution<T> unit;
+                std::vector<PositionType> active;
+
+                auto tryInsert = [&](const PositionType& position)
+                {
+                    CellType cell = CellOf(position);
+                    for (SizeType i = 0; i < Dimension; ++i)
+                    {
+                        if (cell[i] < cellBegin[i] || cell[i] >= cellEnd[i]
+                         || position[i] < mMin[i] || position[i] > mMax[i])
+                        {
+                            return false;
+                        }
+                    }
+
+                    if (!inside(position) || HasConflict(position, cell))
+                    {
+                        return false;
+                    }
+
+                    SizeType index = CellIndex(cell);
+                    mOccupied[ToUnderlying(index)] = 1;
+                    mPositions[ToUnderlying(index)] = position;
+                    samples.push_back(position);
+                    active.push_back(position);
+                    return true;
+                };
+
+                while (true)
+                {
+                    // Note(3011): Parts of the tile may be unreachable from the
+                    // first sample (or the domain may not be connected), so new
+                    // starting points are thrown until they all fail.
+                    bool seeded = false;
+                    for (u32 attempt = 0; attempt < mAttempts && !seeded; ++attempt)
+                    {
+                        PositionType position;
+                        for (SizeType i = 0; i < Dimension; ++i)
+                        {
+                            position[i] = tileMin[i] + unit(rng) * tileExtent[i];
+                        }
+                        seeded = tryInsert(position);
+                    }
+
+                    if (!seeded)
+                    {
+                        break;
+                    }
+
+                    while (!active.empty())
+                    {
+                        std::size_t pick = ToUnderlying(BoundedRandom(rng, Cast<u64>(active.size())));
+                        PositionType center = active[pick];
+
+                        bool found = false;
+                        for (u32 attempt = 0; attempt < mAttempts && !found; ++attempt)
+                        {
+                            PositionType offset = AnnulusOffset(rng);
+                            PositionType candidate;
+                            for (SizeType i = 0; i < Dimension; ++i)
+                            {
+                                candidate[i] = center[i] + offset[i];
+                            }
+                            found = tryInsert(candidate);
+                        }
+
+                        if (!found)
+                        {
+                            active[pick] = active.back();
+                            active.pop_back();
+                        }
+                    }
+                }
+            }
+
+            PositionType mMin;
+            PositionType mMax;
+            T mRadius;
+            T mRadiusSqr;
+            T mCellSize;
+            T mInvCellSize;
+            u32 mAttempts;
+            CellType mCells;
+            CellType mTiles;
+            SizeType mCellCount;
+            SizeType mTileCount;
+
+            // Note(3011): Not std::vector<bool>, tiles are filled concurrently.
+            std::vector<u8> mOccupied;
+            std::vector<PositionType> mPositions;
+        };
+    }
+
+    namespace Sampling
+    {
+        // Note(3011):
+        // Poisson disk sampling, i.e. random points that are at least radius apart,
+        // which cover the domain without the clumps of independent uniform points.
+        // The result depends only on the arguments other than threadCount, the
+        // points are ordered by the tile they were generated in.
+
+        template <Concept::StrongFloatType T, Concept::Invocable<const Point2T<T>&> Inside>
+        [[nodiscard]]
+        std::vector<Point2T<T>> PoissonDisk(const Geometry2D::Rectangle<T>& bounds, std::type_identity_t<T> radius, u64 seed, Inside&& inside,
+                                            u32 attempts = 30, SizeType threadCount = HardwareThreadCount())
+        {
+            using Sampler = Implementation::PoissonDiskSampler<T, 2>;
+            using PositionType = typename Sampler::PositionType;
+
+            Sampler sampler(PositionType(bounds.Min.x, bounds.Min.y), PositionType(bounds.Max.x, bounds.Max.y), radius, attempts);
+            std::vector<PositionType> positions = sampler.Generate(seed, [&](const PositionType& position)
+            {
+                return inside(Point2T<T>(position[0], position[1]));
+            }, threadCount);
+
+            std::vector<Point2T<T>> result;
+            result.reserve(positions.size());
+            for (const PositionType& position : positions)
+            {
+                result.emplace_back(position[0], position[1]);
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]]
+        std::vector<Point2T<T>> PoissonDisk(const Geometry2D::Rectangle<T>& domain, std::type_identity_t<T> radius, u64 seed,
+                                            u32 attempts = 30, SizeType threadCount = HardwareThreadCount())
+        {
+            return PoissonDisk(domain, radius, seed, [](const Point2T<T>&) { return true; }, attempts, threadCount);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]]
+        std::vector<Point2T<T>> PoissonDisk(const Geometry2D::Circle<T>& domain, std::type_identity_t<T> radius, u64 seed,
+                                            u32 attempts = 30, SizeType threadCount = HardwareThreadCount())
+        {
+            return PoissonDisk(Geometry2D::BoundingRectangle(domain), radius, seed, [&](const Point2T<T>& point)
+            {
+                return Geometry2D::Contains(domain, point);
+            }, attempts, threadCount);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]]
+        std::vector<Point3T<T>> PoissonDisk(const Geometry::Box<T>& domain, std::type_identity_t<T> radius, u64 seed,
+                                            u32 attempts = 30, SizeType threadCount = HardwareThreadCount())
+        {
+            using Sampler = Implementation::PoissonDiskSampler<T, 3>;
+            using PositionType = typename Sampler::PositionType;
+
+            Sampler sampler(PositionType(domain.Min.x, domain.Min.y, domain.Min.z),
+                            PositionType(domain.Max.x, domain.Max.y, domain.Max.z), radius, attempts);
+            std::vector<PositionType> positions = sampler.Generate(seed, [](const PositionType&) { return true; }, threadCount);
+
+            std::vector<Point3T<T>> result;
+            result.reserve(positions.size());
+            for (const PositionType& position : positions)
+            {
+                result.emplace_back(position[0], position[1], position[2]);
+            }
+            return result;
+        }
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_SAMPLING_POISSON_DISK_HPP
@@ -0,0 +1,403 @@
+#ifndef MATHLIB_IMPLEMENTATION_SAMPLING_WARPS_HPP
+#define MATHLIB_IMPLEMENTATION_SAMPLING_WARPS_HPP
+
+#include "../../Constants.hpp"
+#include "../../Functions.hpp"
+#include "../../Geometry.hpp"
+#include "../../Point.hpp"
+#include "../../Vector.hpp"
+
+#include <type_traits>
+
+namespace Math
+{
+    namespace Implementation
+    {
+        // Note(3011):
+        // Sine and cosine of 2 * Pi * turns. The argument is reduced to an eighth
+        // of a turn around the nearest quadrant and evaluated with Taylor
+        // polynomials, everything else is selects, so unlike Sin and Cos this
+        // has no branches and vectorizes inside the packet loops.
+
+        template <Concept::StrongFloatType T>
+        constexpr
+        void SinCosTurns(T turns, T& sinOut, T& cosOut) noexcept
+        {
+            using Int = Math::SignedIntegerSelector<sizeof(T)>;
+
+            Int quadrant = Round<Int>(turns * Cast<T>(4));
+            T angle = (turns - Cast<T>(quadrant) * Cast<T>(0.25)) * Constant::Tau<T>;
+            T angleSqr = angle * angle;
+
+            T sin;
+            T cos;
+            if constexpr (sizeof(T) == 4)
+            {
+                sin = angle * (T(1) + angleSqr * (T(-1.0 / 6.0) + angleSqr * (T(1.0 / 120.0)
+                    + angleSqr * (T(-1.0 / 5040.0) + angleSqr * T(1.0 / 362880.0)))));
+                cos = T(1) + angleSqr * (T(-0.5) + angleSqr * (T(1.0 / 24.0) + angleSqr * (T(-1.0 / 720.0)
+                    + angleSqr * T(1.0 / 40320.0))));
+            }
+            else
+            {
+                sin = angle * (T(1) + angleSqr * (T(-1.0 / 6.0) + angleSqr * (T(1.0 / 120.0)
+                    + angleSqr * (T(-1.0 / 5040.0) + angleSqr * (T(1.0 / 362880.0)
+                    + angleSqr * (T(-1.0 / 39916800.0) + angleSqr * (T(1.0 / 6227020800.0)
+                    + angleSqr * T(-1.0 / 1307674368000.0))))))));
+                cos = T(1) + angleSqr * (T(-0.5) + angleSqr * (T(1.0 / 24.0) + angleSqr * (T(-1.0 / 720.0)
+                    + angleSqr * (T(1.0 / 40320.0) + angleSqr * (T(-1.0 / 3628800.0)
+                    + angleSqr * (T(1.0 / 479001600.0) + angleSqr * T(-1.0 / 87178291200.0)))))));
+            }
+
+            bool swap = (quadrant & 1) != 0;
+            bool negateSin = (quadrant & 2) != 0;
+            bool negateCos = ((quadrant + 1) & 2) != 0;
+            T swappedSin = swap ? cos : sin;
+            T swappedCos = swap ? sin : cos;
+            sinOut = negateSin ? -swappedSin : swappedSin;
+            cosOut = negateCos ? -swappedCos : swappedCos;
+        }
+    }
+
+    namespace Sampling
+    {
+        // Note(3011):
+        // Warps of uniform samples in [0, 1)^2 to other domains, paired with the
+        // densities of the results. Taking the samples as arguments (instead of
+        // a generator) lets them be fed from stratified or low-discrepancy
+        // sequences, the warps are all continuous and keep that stratification.
+        // Directions are in a local frame with the pole along +z, densities of
+        // directions are with respect to solid angle, densities of points on
+        // shapes with respect to area.
+        //
+        // Every warp also has a packet overload, working on N samples at once.
+
+        //////////////////////////////////////////////////////////////////////////
+        // Disk
+        //////////////////////////////////////////////////////////////////////////
+
+        // Note(3011): Concentric mapping by P. Shirley and K. Chiu, "A Low
+        // Distortion Map Between Disk and Square" (1997).
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector2T<T> SampleUniformDisk(const Vector2T<T>& u) noexcept
+        {
+            T a = Cast<T>(2) * u.x - Cast<T>(1);
+            T b = Cast<T>(2) * u.y - Cast<T>(1);
+
+            bool horizontal = Abs(a) > Abs(b);
+            T radius = horizontal ? a : b;
+            T numerator = horizontal ? b : a;
+            T ratio = (radius != Cast<T>(0)) ? numerator / radius : Cast<T>(0);
+            T turns = horizontal ? ratio * Cast<T>(0.125) : Cast<T>(0.25) - ratio * Cast<T>(0.125);
+
+            T sin;
+            T cos;
+            Implementation::SinCosTurns(turns, sin, cos);
+            return Vector2T<T>(radius * cos, radius * sin);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfUniformDisk() noexcept
+        {
+            return Constant::InvPi<T>;
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // Triangle
+        //////////////////////////////////////////////////////////////////////////
+
+        // Note(3011): Returns the barycentric coordinates of the first two vertices.
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector2T<T> SampleUniformTriangle(const Vector2T<T>& u) noexcept
+        {
+            T sqrtU = Sqrt(u.x);
+            return Vector2T<T>(Cast<T>(1) - sqrtU, u.y * sqrtU);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Point3T<T> SampleTriangle(const Geometry::Triangle<T>& triangle, const Vector2T<T>& u) noexcept
+        {
+            Vector2T<T> barycentric = SampleUniformTriangle(u);
+            return triangle.A + barycentric.y * (triangle.B - triangle.A)
+                              + (Cast<T>(1) - barycentric.x - barycentric.y) * (triangle.C - triangle.A);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfTriangle(const Geometry::Triangle<T>& triangle) noexcept
+        {
+            return Cast<T>(2) / Cross(triangle.B - triangle.A, triangle.C - triangle.A).Length();
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // Sphere
+        //////////////////////////////////////////////////////////////////////////
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector3T<T> SampleUniformSphere(const Vector2T<T>& u) noexcept
+        {
+            T z = Cast<T>(1) - Cast<T>(2) * u.x;
+            T radius = Sqrt(Max(Cast<T>(1) - z * z, Cast<T>(0)));
+
+            T sin;
+            T cos;
+            Implementation::SinCosTurns(u.y, sin, cos);
+            return Vector3T<T>(radius * cos, radius * sin, z);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfUniformSphere() noexcept
+        {
+            return Constant::InvPi<T> / Cast<T>(4);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Point3T<T> SampleSphere(const Geometry::Sphere<T>& sphere, const Vector2T<T>& u) noexcept
+        {
+            return sphere.Center + sphere.Radius * SampleUniformSphere(u);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfSphere(const Geometry::Sphere<T>& sphere) noexcept
+        {
+            return PdfUniformSphere<T>() / Squared(sphere.Radius);
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // Hemisphere
+        //////////////////////////////////////////////////////////////////////////
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector3T<T> SampleUniformHemisphere(const Vector2T<T>& u) noexcept
+        {
+            T z = u.x;
+            T radius = Sqrt(Max(Cast<T>(1) - z * z, Cast<T>(0)));
+
+            T sin;
+            T cos;
+            Implementation::SinCosTurns(u.y, sin, cos);
+            return Vector3T<T>(radius * cos, radius * sin, z);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfUniformHemisphere() noexcept
+        {
+            return Constant::InvPi<T> / Cast<T>(2);
+        }
+
+        // Note(3011): Malley's method, the concentric disk mapping projected up
+        // to the hemisphere.
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector3T<T> SampleCosineHemisphere(const Vector2T<T>& u) noexcept
+        {
+            Vector2T<T> disk = SampleUniformDisk(u);
+            T z = Sqrt(Max(Cast<T>(1) - disk.LenSqr(), Cast<T>(0)));
+            return Vector3T<T>(disk.x, disk.y, z);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfCosineHemisphere(T cosTheta) noexcept
+        {
+            return Max(cosTheta, Cast<T>(0)) * Constant::InvPi<T>;
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // Cone and lobe
+        //////////////////////////////////////////////////////////////////////////
+
+        // Note(3011): Uniform directions within cosThetaMax of the pole, e.g. the
+        // directions towards a sphere seen from outside of it.
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector3T<T> SampleUniformCone(const Vector2T<T>& u, std::type_identity_t<T> cosThetaMax) noexcept
+        {
+            T z = Cast<T>(1) - u.x * (Cast<T>(1) - cosThetaMax);
+            T radius = Sqrt(Max(Cast<T>(1) - z * z, Cast<T>(0)));
+
+            T sin;
+            T cos;
+            Implementation::SinCosTurns(u.y, sin, cos);
+            return Vector3T<T>(radius * cos, radius * sin, z);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfUniformCone(std::type_identity_t<T> cosThetaMax) noexcept
+        {
+            return Constant::InvPi<T> / (Cast<T>(2) * (Cast<T>(1) - cosThetaMax));
+        }
+
+        // Note(3011): Directions distributed as cos(theta)^exponent, the lobe of
+        // the (normalized) Phong BRDF.
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector3T<T> SamplePhongLobe(const Vector2T<T>& u, std::type_identity_t<T> exponent) noexcept
+        {
+            T z = Pow(Cast<T>(1) - u.x, Cast<T>(1) / (exponent + Cast<T>(1)));
+            T radius = Sqrt(Max(Cast<T>(1) - z * z, Cast<T>(0)));
+
+            T sin;
+            T cos;
+            Implementation::SinCosTurns(u.y, sin, cos);
+            return Vector3T<T>(radius * cos, radius * sin, z);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T PdfPhongLobe(T cosTheta, std::type_identity_t<T> exponent) noexcept
+        {
+            return (exponent + Cast<T>(1)) * Constant::InvPi<T> / Cast<T>(2)
+                 * Pow(Max(cosTheta, Cast<T>(0)), exponent);
+        }
+
+        //////////////////////////////////////////////////////////////////////////
+        // Packet versions
+        //////////////////////////////////////////////////////////////////////////
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector2PacketT<T, N> SampleUniformDisk(const Vector2PacketT<T, N>& u) noexcept
+        {
+            Vector2PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, SampleUniformDisk(u.Get(i)));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector2PacketT<T, N> SampleUniformTriangle(const Vector2PacketT<T, N>& u) noexcept
+        {
+            Vector2PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, SampleUniformTriangle(u.Get(i)));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector3PacketT<T, N> SampleTriangle(const Geometry::Triangle<T>& triangle, const Vector2PacketT<T, N>& u) noexcept
+        {
+            Vector3PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, Vector3T<T>(SampleTriangle(triangle, u.Get(i))));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector3PacketT<T, N> SampleUniformSphere(const Vector2PacketT<T, N>& u) noexcept
+        {
+            Vector3PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, SampleUniformSphere(u.Get(i)));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector3PacketT<T, N> SampleSphere(const Geometry::Sphere<T>& sphere, const Vector2PacketT<T, N>& u) noexcept
+        {
+            Vector3PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, Vector3T<T>(SampleSphere(sphere, u.Get(i))));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector3PacketT<T, N> SampleUniformHemisphere(const Vector2PacketT<T, N>& u) noexcept
+        {
+            Vector3PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, SampleUniformHemisphere(u.Get(i)));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector3PacketT<T, N> SampleCosineHemisphere(const Vector2PacketT<T, N>& u) noexcept
+        {
+            Vector3PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, SampleCosineHemisphere(u.Get(i)));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Array<T, N> PdfCosineHemisphere(const Array<T, N>& cosTheta) noexcept
+        {
+            Array<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result[i] = PdfCosineHemisphere(cosTheta[i]);
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector3PacketT<T, N> SampleUniformCone(const Vector2PacketT<T, N>& u, std::type_identity_t<T> cosThetaMax) noexcept
+        {
+            Vector3PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, SampleUniformCone(u.Get(i), cosThetaMax));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Vector3PacketT<T, N> SamplePhongLobe(const Vector2PacketT<T, N>& u, std::type_identity_t<T> exponent) noexcept
+        {
+            Vector3PacketT<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result.Set(i, SamplePhongLobe(u.Get(i), exponent));
+            }
+            return result;
+        }
+
+        template <Concept::StrongFloatType T, SizeType N>
+        [[nodiscard]] constexpr
+        Array<T, N> PdfPhongLobe(const Array<T, N>& cosTheta, std::type_identity_t<T> exponent) noexcept
+        {
+            Array<T, N> result;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                result[i] = PdfPhongLobe(cosTheta[i], exponent);
+            }
+            return result;
+        }
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_SAMPLING_WARPS_HPP
@@ -0,0 +1,206 @@
+#ifndef MATHLIB_IMPLEMENTATION_SEQUENCES_HALTON_HPP
+#define MATHLIB_IMPLEMENTATION_SEQUENCES_HALTON_HPP
+
+#include "../Base/Array.hpp"
+#include "../../Vector.hpp"
+#include "Scrambling.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace Math
+{
+    namespace Implementation
+    {
+        template <SizeType Count>
+        [[nodiscard]] constexpr
+        Array<u32, Count> FirstPrimes() noexcept
+        {
+            Array<u32, Count> result;
+            SizeType found = 0;
+            for (u32 candidate = 2; found < Count; ++candidate)
+            {
+                bool isPrime = true;
+                for (SizeType i = 0; i < found && result[i] * result[i] <= candidate; ++i)
+                {
+                    if (candidate % result[i] == 0)
+                    {
+                        isPrime = false;
+                        break;
+                    }
+                }
+
+                if (isPrime)
+                {
+                    result[found++] = candidate;
+                }
+            }
+            return result;
+        }
+
+        // Note(3011):
+        // The base is a template parameter so the divisions by the base turn
+        // into multiplications. Base 2 skips the digit loop entirely.
+
+        template <u32 Base>
+        [[nodiscard]] constexpr
+        f64 RadicalInverse(u64 index) noexcept
+        {
+            if constexpr (Base == 2)
+            {
+                return Cast<f64>(ReverseBits(index) >> 11) * 0x1.0p-53;
+            }
+            else
+            {
+                constexpr u64 base = Cast<u64>(Base);
+                constexpr f64 invBase = 1.0 / Cast<f64>(Base);
+
+                u64 reversed = 0;
+                f64 invBaseN = 1.0;
+                while (index != 0)
+                {
+                    u64 next = index / base;
+                    u64 digit = index - next * base;
+                    reversed = reversed * base + digit;
+                    invBaseN *= invBase;
+                    index = next;
+                }
+
+                return Min(Cast<f64>(reversed) * invBaseN, Constant::OneMinusEpsilon<f64>);
+            }
+        }
+
+        [[nodiscard]] constexpr
+        u32 MaxDigitCount(u64 base) noexcept
+        {
+            u32 count = 0;
+            for (u64 power = 1; power <= u64::Max() / base; power *= base)
+            {
+                ++count;
+            }
+            return count;
+        }
+
+        template <u32 Base>
+        [[nodiscard]] constexpr
+        f64 ScrambledRadicalInverse(u64 index, u32 seed, Scrambling scrambling) noexcept
+        {
+            constexpr u64 base = Cast<u64>(Base);
+            constexpr f64 invBase = 1.0 / Cast<f64>(Base);
+
+            // Note(3011): The loop continues past the last non-zero digit of the
+            // index, since the permuted zero digits are not zero anymore. It stops
+            // at the most digits that still fit into 64 bits, which is always more
+            // than f64 can resolve, as Base^DigitCount > 2^64 / Base >= 2^54.
+            constexpr u32 DigitCount = MaxDigitCount(base);
+
+            u64 reversed = 0;
+            f64 invBaseN = 1.0;
+            for (u32 digitIndex = 0; digitIndex < DigitCount; ++digitIndex)
+            {
+                u64 next = index / base;
+                u32 digit = Cast<u32>(index - next * base);
+
+                // Note(3011): Owen scrambling uses a different permutation for
+                // every prefix of digits, random digit scrambling only one per
+                // digit position.
+                u32 digitSeed = (scrambling == Scrambling::Owen)
+                              ? HashCombine(seed, digitIndex, Cast<u32>(reversed), Cast<u32>(reversed >> 32))
+                              : HashCombine(seed, digitIndex);
+                digit = PermutationElement(digit, Base, digitSeed);
+
+                reversed = reversed * base + Cast<u64>(digit);
+                invBaseN *= invBase;
+                index = next;
+            }
+
+            return Min(Cast<f64>(reversed) * invBaseN, Constant::OneMinusEpsilon<f64>);
+        }
+
+        inline constexpr SizeType HaltonMaxDimension = 128;
+        inline constexpr Array<u32, HaltonMaxDimension> HaltonPrimes = FirstPrimes<HaltonMaxDimension>();
+
+        using RadicalInverseFunction = f64 (*)(u64);
+        using ScrambledRadicalInverseFunction = f64 (*)(u64, u32, Scrambling);
+
+        template <std::size_t... Indices>
+        [[nodiscard]] constexpr
+        Array<RadicalInverseFunction, sizeof...(Indices)> MakeRadicalInverseTable(std::index_sequence<Indices...>) noexcept
+        {
+            return Array<RadicalInverseFunction, sizeof...(Indices)>(&RadicalInverse<HaltonPrimes[Indices]>...);
+        }
+
+        template <std::size_t... Indices>
+        [[nodiscard]] constexpr
+        Array<ScrambledRadicalInverseFunction, sizeof...(Indices)> MakeScrambledRadicalInverseTable(std::index_sequence<Indices...>) noexcept
+        {
+            return Array<ScrambledRadicalInverseFunction, sizeof...(Indices)>(&ScrambledRadicalInverse<HaltonPrimes[Indices]>...);
+        }
+
+        inline constexpr Array<RadicalInverseFunction, HaltonMaxDimension> HaltonRadicalInverseTable
+            = MakeRadicalInverseTable(std::make_index_sequence<ToUnderlying(HaltonMaxDimension)>());
+        inline constexpr Array<ScrambledRadicalInverseFunction, HaltonMaxDimension> HaltonScrambledRadicalInverseTable
+            = MakeScrambledRadicalInverseTable(std::make_index_sequence<ToUnderlying(HaltonMaxDimension)>());
+    }
+
+    // Note(3011):
+    // Halton sequence with random access by index. Dimension i uses the i-th
+    // prime as its base. The radical inverses are dispatched through a table of
+    // functions specialized for each base.
+    //
+    // There are bases for MaxDimension dimensions. Asking for a dimension past
+    // them asserts, release builds get NaN samples (base 0) rather than a
+    // reused, correlated dimension.
+
+    class Halton final
+    {
+    public:
+        static constexpr SizeType MaxDimension = Implementation::HaltonMaxDimension;
+
+        [[nodiscard]] constexpr explicit
+        Halton(u32 seed = 0, Scrambling scrambling = Scrambling::Owen) noexcept
+            : mSeed(seed), mScrambling(scrambling)
+        {}
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T Sample(u64 index, u32 dimension) const noexcept
+        {
+            if (Cast<SizeType>(dimension) >= MaxDimension)
+            {
+                assert(false && "Halton dimension out of range");
+                return T::NaN();
+            }
+
+            std::size_t baseIndex = ToUnderlying(dimension);
+            f64 result = (mScrambling == Scrambling::None)
+                       ? Implementation::HaltonRadicalInverseTable[baseIndex](index)
+                       : Implementation::HaltonScrambledRadicalInverseTable[baseIndex](index, HashCombine(mSeed, dimension), mScrambling);
+            return Min(Cast<T>(result), Constant::OneMinusEpsilon<T>);
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector2T<T> Sample2D(u64 index, u32 dimension) const noexcept
+        {
+            return Vector2T<T>(Sample<T>(index, dimension), Sample<T>(index, dimension + 1));
+        }
+
+        [[nodiscard]] static constexpr
+        u32 Base(u32 dimension) noexcept
+        {
+            if (Cast<SizeType>(dimension) >= MaxDimension)
+            {
+                assert(false && "Halton dimension out of range");
+                return 0;
+            }
+
+            return Implementation::HaltonPrimes[ToUnderlying(dimension)];
+        }
+    private:
+        u32 mSeed;
+        Scrambling mScrambling;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_SEQUENCES_HALTON_HPP
@@ -0,0 +1,172 @@
+#ifndef MATHLIB_IMPLEMENTATION_SEQUENCES_MULTI_JITTERED_HPP
+#define MATHLIB_IMPLEMENTATION_SEQUENCES_MULTI_JITTERED_HPP
+
+#include "../Functions/BasicFunctions.hpp"
+#include "../Functions/FloatUtils.hpp"
+#include "../../Constants.hpp"
+#include "../../Vector.hpp"
+#include "Scrambling.hpp"
+#include "Sobol.hpp"
+
+namespace Math
+{
+    // Note(3011):
+    // Jittered 2D point sets. All of the samplers are stateless apart from their
+    // configuration, any point is computed directly from its index and a pattern
+    // (e.g. the pixel index), which decorrelates the point sets of different
+    // patterns. Threads can therefore evaluate arbitrary index ranges without
+    // sharing anything.
+
+    namespace Implementation
+    {
+        // Note(3011): Columns of the m x n grid used for count points, the grid
+        // is as square as possible and has at least count cells.
+        [[nodiscard]] constexpr
+        u32 JitterGridColumns(u32 count) noexcept
+        {
+            u32 columns = Max(Cast<u32>(Floor<i64>(Sqrt(Cast<f64>(count)))), u32(1));
+            while (columns * columns > count && columns > 1)
+            {
+                --columns;
+            }
+            while ((columns + 1) * (columns + 1) <= count)
+            {
+                ++columns;
+            }
+            return columns;
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        T JitterToUnit(f64 value) noexcept
+        {
+            return Min(Cast<T>(value), Constant::OneMinusEpsilon<T>);
+        }
+    }
+
+    // Note(3011):
+    // One jittered point in each of the cells of an m x n grid, visited in a
+    // random order. If the count is not a product of the grid sides, the last
+    // row is only partially filled.
+
+    class StratifiedSampler final
+    {
+    public:
+        [[nodiscard]] constexpr explicit
+        StratifiedSampler(u32 count, u32 seed = 0) noexcept
+            : mCount(Max(count, u32(1))), mColumns(Implementation::JitterGridColumns(mCount)),
+              mRows((mCount + mColumns - 1) / mColumns), mSeed(seed)
+        {}
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector2T<T> Sample2D(u32 index, u32 pattern = 0) const noexcept
+        {
+            u32 seed = HashCombine(mSeed, pattern);
+            u32 cell = PermutationElement(index % mCount, mCount, seed * 0x51633E2D);
+
+            f64 jitterX = UnitFromBits<f64>(HashCombine(seed * 0x68BC21EB, cell));
+            f64 jitterY = UnitFromBits<f64>(HashCombine(seed * 0x02E5BE93, cell));
+            return Vector2T<T>(
+                Implementation::JitterToUnit<T>((Cast<f64>(cell % mColumns) + jitterX) / Cast<f64>(mColumns)),
+                Implementation::JitterToUnit<T>((Cast<f64>(cell / mColumns) + jitterY) / Cast<f64>(mRows))
+            );
+        }
+
+        [[nodiscard]] constexpr
+        u32 Count() const noexcept
+        {
+            return mCount;
+        }
+    private:
+        u32 mCount;
+        u32 mColumns;
+        u32 mRows;
+        u32 mSeed;
+    };
+
+    // Note(3011):
+    // Correlated multi-jittered sampling by A. Kensler, "Correlated Multi-Jittered
+    // Sampling" (2013). On top of the m x n grid stratification, every one of the
+    // count columns and rows of the fine count x count grid holds exactly one
+    // point (the n-rooks property), when count is a product of the grid sides.
+    // The sub-cell offsets are shuffled per row and column instead of per cell,
+    // which is what keeps the points from clumping.
+
+    class CMJSampler final
+    {
+    public:
+        [[nodiscard]] constexpr explicit
+        CMJSampler(u32 count, u32 seed = 0) noexcept
+            : mCount(Max(count, u32(1))), mColumns(Implementation::JitterGridColumns(mCount)),
+              mRows((mCount + mColumns - 1) / mColumns), mSeed(seed)
+        {}
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector2T<T> Sample2D(u32 index, u32 pattern = 0) const noexcept
+        {
+            u32 seed = HashCombine(mSeed, pattern);
+            u32 cell = PermutationElement(index % mCount, mCount, seed * 0x51633E2D);
+            u32 column = cell % mColumns;
+            u32 row = cell / mColumns;
+
+            u32 subColumn = PermutationElement(column, mColumns, seed * 0x68BC21EB);
+            u32 subRow = PermutationElement(row, mRows, seed * 0x02E5BE93);
+            f64 jitterX = UnitFromBits<f64>(HashCombine(seed * 0x967A889B, cell));
+            f64 jitterY = UnitFromBits<f64>(HashCombine(seed * 0x368CC8B7, cell));
+
+            f64 columns = Cast<f64>(mColumns);
+            f64 rows = Cast<f64>(mRows);
+            return Vector2T<T>(
+                Implementation::JitterToUnit<T>((Cast<f64>(column) + (Cast<f64>(subRow) + jitterX) / rows) / columns),
+                Implementation::JitterToUnit<T>((Cast<f64>(row) + (Cast<f64>(subColumn) + jitterY) / columns) / rows)
+            );
+        }
+
+        [[nodiscard]] constexpr
+        u32 Count() const noexcept
+        {
+            return mCount;
+        }
+    private:
+        u32 mCount;
+        u32 mColumns;
+        u32 mRows;
+        u32 mSeed;
+    };
+
+    // Note(3011):
+    // Progressive multi-jittered (0, 2) sequence, as introduced by P. Christensen,
+    // A. Kensler and C. Kilpatrick in "Progressive Multi-Jittered Sample
+    // Sequences" (2018). Every prefix of 2^k points has one point in each of the
+    // elementary intervals of area 2^-k, so the samples can be taken one by one
+    // without knowing the final count. Instead of the original incremental
+    // construction, which needs the previous points, this uses the equivalent
+    // random access form from the follow-up work by Helmer et al. (2021): the
+    // first two Sobol dimensions form a (0, 2)-sequence, nested uniform
+    // scrambling picks a random sequence from the same family, and scrambling
+    // the index shuffles the order within each power of two block.
+
+    class PMJ02Sampler final
+    {
+    public:
+        [[nodiscard]] constexpr explicit
+        PMJ02Sampler(u32 seed = 0) noexcept
+            : mSeed(seed)
+        {}
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]] constexpr
+        Vector2T<T> Sample2D(u32 index, u32 pattern = 0) const noexcept
+        {
+            u32 seed = HashCombine(mSeed, pattern);
+            u32 shuffledIndex = NestedUniformScramble(index, seed);
+            return Sobol(Hash32(seed), Scrambling::Owen).Sample2D<T>(shuffledIndex, 0);
+        }
+    private:
+        u32 mSeed;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_SEQUENCES_MULTI_JITTERED_HPP
@@ -0,0 +1,101 @@
+#ifndef MATHLIB_IMPLEMENTATION_SEQUENCES_R_SEQUENCE_HPP
+#define MATHLIB_IMPLEMENTATION_SEQUENCES_R_SEQUENCE_HPP
+
+#include "../../Vector.hpp"
+#include "Scrambling.hpp"
+
+#include <cassert>
+#include <vector>
+
+namespace Math
+{
+    // Note(3011):
+    // Additive recurrence based on the generalized golden ratio, as described
+    // by M. Roberts in "The Unreasonable Effectiveness of Quasirandom Sequences"
+    // (2018). The fractional parts are kept in 0.64 fixed point, so the n-th
+    // point is a single wrapping multiply-add per dimension and stays exact for
+    // every index.
+    //
+    // The sequence is a lattice, so it is never Owen scrambled, that would
+    // destroy its structure. Scrambling::None gives the plain sequence, both
+    // RandomDigit (the default) and Owen only add a hashed toroidal shift
+    // (Cranley-Patterson rotation) per dimension, the two give the same points.
+    //
+    // The sequence has the dimension count it was constructed with, which must
+    // not be zero. Asking for a dimension past it asserts, release builds get
+    // NaN samples (0 bits) rather than a reused, correlated dimension.
+
+    class RSequence final
+    {
+    public:
+        [[nodiscard]] explicit
+        RSequence(u32 dimensions = 2, u32 seed = 0, Scrambling scrambling = Scrambling::RandomDigit)
+            : mAlphas(ToUnderlying(dimensions)), mSeed(seed), mScrambling(scrambling)
+        {
+            assert(dimensions > 0 && "R sequence needs at least one dimension");
+
+            // Note(3011): Newton's method for x^(d + 1) = x + 1, it converges in
+            // a handful of iterations from 2, the root is always in (1, 2).
+            f64 degree = Cast<f64>(dimensions) + 1.0;
+            f64 phi = 2.0;
+            for (SizeType i = 0; i < 32; ++i)
+            {
+                phi -= (Pow(phi, degree) - phi - 1.0) / (degree * Pow(phi, degree - 1.0) - 1.0);
+            }
+
+            f64 invPhi = 1.0 / phi;
+            f64 alpha = 1.0;
+            for (u64& fixedAlpha : mAlphas)
+            {
+                alpha *= invPhi;
+                fixedAlpha = Cast<u64>(alpha * 0x1.0p64);
+            }
+        }
+
+        [[nodiscard]]
+        u64 SampleBits(u64 index, u32 dimension) const noexcept
+        {
+            if (Cast<SizeType>(dimension) >= Dimensions())
+            {
+                assert(false && "R sequence dimension out of range");
+                return 0;
+            }
+
+            constexpr u64 half = u64(1) << 63;
+            u64 offset = (mScrambling == Scrambling::None) ? u64(0) : Hash64(Cast<u64>(HashCombine(mSeed, dimension)));
+            return half + offset + index * mAlphas[ToUnderlying(dimension)];
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]]
+        T Sample(u64 index, u32 dimension) const noexcept
+        {
+            if (Cast<SizeType>(dimension) >= Dimensions())
+            {
+                assert(false && "R sequence dimension out of range");
+                return T::NaN();
+            }
+
+            return UnitFromBits<T>(Cast<u32>(SampleBits(index, dimension) >> 32));
+        }
+
+        template <Concept::StrongFloatType T>
+        [[nodiscard]]
+        Vector2T<T> Sample2D(u64 index, u32 dimension) const noexcept
+        {
+            return Vector2T<T>(Sample<T>(index, dimension), Sample<T>(index, dimension + 1));
+        }
+
+        [[nodiscard]]
+        SizeType Dimensions() const noexcept
+        {
+            return mAlphas.size();
+        }
+    private:
+        std::vector<u64> mAlphas;
+        u32 mSeed;
+        Scrambling mScrambling;
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_SEQUENCES_R_SEQUENCE_HPP
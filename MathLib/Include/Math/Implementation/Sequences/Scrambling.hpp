@@ -0,0 +1,112 @@
+#ifndef MATHLIB_IMPLEMENTATION_SEQUENCES_SCRAMBLING_HPP
+#define MATHLIB_IMPLEMENTATION_SEQUENCES_SCRAMBLING_HPP
+
+#include "../Base/Concepts.hpp"
+#include "../Functions/Hash.hpp"
+#include "../Functions/IntUtils.hpp"
+
+namespace Math
+{
+    enum class Scrambling
+    {
+        None,
+        RandomDigit,
+        Owen
+    };
+
+    template <Concept::StrongFloatType T>
+    [[nodiscard]] constexpr
+    T UnitFromBits(u32 bits) noexcept
+    {
+        // Note(3011): Same conversion as in UniformUnitDistribution, so the
+        // results stay in [0, 1) even after rounding.
+        if constexpr (sizeof(T) == 4)
+        {
+            return Cast<T>(bits >> 8) * 0x1.0p-24f;
+        }
+        else
+        {
+            return Cast<T>(bits) * 0x1.0p-32;
+        }
+    }
+
+    // Note(3011):
+    // Hash based Owen scrambling, as described by B. Burley in "Practical
+    // Hash-based Owen Scrambling" (2020), with the improved hash constants
+    // found by N. Vegdahl. The permutation only propagates information from
+    // lower to higher bits, so reversing the bits first turns it into a
+    // nested uniform (Owen) scramble of the binary digits of a fraction.
+
+    [[nodiscard]] constexpr
+    u32 LaineKarrasPermutation(u32 val, u32 seed) noexcept
+    {
+        val ^= val * 0x3D20ADEA;
+        val += seed;
+        val *= (seed >> 16) | 1;
+        val ^= val * 0x05526C56;
+        val ^= val * 0x53A22864;
+        return val;
+    }
+
+    [[nodiscard]] constexpr
+    u32 NestedUniformScramble(u32 val, u32 seed) noexcept
+    {
+        return ReverseBits(LaineKarrasPermutation(ReverseBits(val), seed));
+    }
+
+    [[nodiscard]] constexpr
+    u32 Scramble(u32 val, u32 seed, Scrambling scrambling) noexcept
+    {
+        switch (scrambling)
+        {
+        case Scrambling::RandomDigit:
+            return val ^ seed;
+        case Scrambling::Owen:
+            return NestedUniformScramble(val, seed);
+        default:
+            return val;
+        }
+    }
+
+    // Note(3011):
+    // Random access permutation of [0, length) by A. Kensler, "Correlated
+    // Multi-Jittered Sampling" (2013). The cycle walking loop runs less than
+    // twice on average, since the hash works on the next power of two.
+
+    [[nodiscard]] constexpr
+    u32 PermutationElement(u32 index, u32 length, u32 seed) noexcept
+    {
+        u32 mask = length - 1;
+        mask |= mask >> 1;
+        mask |= mask >> 2;
+        mask |= mask >> 4;
+        mask |= mask >> 8;
+        mask |= mask >> 16;
+
+        do
+        {
+            index ^= seed;
+            index *= 0xE170893D;
+            index ^= seed >> 16;
+            index ^= (index & mask) >> 4;
+            index ^= seed >> 8;
+            index *= 0x0929EB3F;
+            index ^= seed >> 23;
+            index ^= (index & mask) >> 1;
+            index *= 1 | seed >> 27;
+            index *= 0x6935FA69;
+            index ^= (index & mask) >> 11;
+            index *= 0x74DCB303;
+            index ^= (index & mask) >> 2;
+            index *= 0x9E501CC3;
+            index ^= (index & mask) >> 2;
+            index *= 0xC860A3DF;
+            index &= mask;
+            index ^= index >> 5;
+        } while (index >= length);
+
+        return (index + seed) % length;
+    }
+}
+
+#endif //MATHLIB_IMPLEMENTATION_SEQUENCES_SCRAMBLING_HPP
@@ -0,0 +1,91 @@
+#ifndef MATHLIB_IMPLEMENTATION_VECTOR_PACKET_HPP
+#define MATHLIB_IMPLEMENTATION_VECTOR_PACKET_HPP
+
+#include "Base/Array.hpp"
+#include "Vector.hpp"
+
+namespace Math
+{
+    // Note(3011):
+    // Structure of arrays bundles of N vectors, used by the packet code paths.
+    // There are no intrinsics involved, the packet functions are plain loops
+    // over the lanes with branch-free bodies, which is the form compilers turn
+    // into SIMD code reliably, for whatever instruction set is targeted.
+
+    template <Concept::StrongType T, SizeType N>
+    struct Vector2PacketT final
+    {
+        using ScalarType = T;
+        static constexpr SizeType Width = N;
+
+        Array<T, N> x;
+        Array<T, N> y;
+
+        [[nodiscard]] constexpr
+        Vector2T<T> Get(SizeType lane) const noexcept
+        {
+            return Vector2T<T>(x[lane], y[lane]);
+        }
+
+        constexpr
+        void Set(SizeType lane, const Vector2T<T>& value) noexcept
+        {
+            x[lane] = value.x;
+            y[lane] = value.y;
+        }
+    };
+
+    template <Concept::StrongType T, SizeType N>
+    struct Vector3PacketT final
+    {
+        using ScalarType = T;
+        static constexpr SizeType Width = N;
+
+        Array<T, N> x;
+        Array<T, N> y;
+        Array<T, N> z;
+
+        [[nodiscard]] constexpr
+        Vector3T<T> Get(SizeType lane) const noexcept
+        {
+            return Vector3T<T>(x[lane], y[lane], z[lane]);
+        }
+
+        constexpr
+        void Set(SizeType lane, const Vector3T<T>& value) noexcept
+        {
+            x[lane] = value.x;
+            y[lane] = value.y;
+            z[lane] = value.z;
+        }
+    };
+
+    template <Concept::StrongType T, SizeType N>
+    struct Vector4PacketT final
+    {
+        using ScalarType = T;
+        static constexpr SizeType Width = N;
+
+        Array<T, N> x;
+        Array<T, N> y;
+        Array<T, N> z;
+        Array<T, N> w;
+
+        [[nodiscard]] constexpr
+        Vector4T<T> Get(SizeType lane) const noexcept
+        {
+            return Vector4T<T>(x[lane], y[lane], z[lane], w[lane]);
+        }
+
+        constexpr
+        void Set(SizeType lane, const Vector4T<T>& value) noexcept
+        {
+            x[lane] = value.x;
+            y[lane] = value.y;
+            z[lane] = value.z;
+            w[lane] = value.w;
+        }
+    };
+}
+
+#endif //MATHLIB_IMPLEMENTATION_VECTOR_PACKET_HPP
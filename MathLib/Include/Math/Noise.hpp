@@ -1,6 +1,14 @@
 #ifndef MATHLIB_NOISE_HPP
 #define MATHLIB_NOISE_HPP
 
+#include "Implementation/Noise/Cache.hpp"
+#include "Implementation/Noise/Gradient.hpp"
+#include "Implementation/Noise/Grid.hpp"
+#include "Implementation/Noise/HashedPerlin.hpp"
+#include "Implementation/Noise/Layer.hpp"
 #include "Implementation/Noise/Perlin.hpp"
+#include "Implementation/Noise/Simplex.hpp"
+#include "Implementation/Noise/Warp.hpp"
+#include "Implementation/Noise/Worley.hpp"
 
 #endif //MATHLIB_NOISE_HPP
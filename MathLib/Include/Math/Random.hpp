@@ -4,6 +4,9 @@
 #include "Implementation/Random/Xoshiro.hpp"
 #include "Implementation/Random/UniformDistribution.hpp"
 #include "Implementation/Random/PoissonDistribution.hpp"
+#include "Implementation/Random/AliasTable.hpp"
+#include "Implementation/Random/Permutation.hpp"
+#include "Implementation/Random/Reservoir.hpp"
 
 namespace Math
 {
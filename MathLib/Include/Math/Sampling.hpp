@@ -0,0 +1,8 @@
+#ifndef MATHLIB_SAMPLING_HPP
+#define MATHLIB_SAMPLING_HPP
+
+#include "Implementation/Sampling/Warps.hpp"
+#include "Implementation/Sampling/PoissonDisk.hpp"
+#include "Implementation/Sampling/BlueNoise.hpp"
+
+#endif //MATHLIB_SAMPLING_HPP
@@ -0,0 +1,10 @@
+#ifndef MATHLIB_SEQUENCES_HPP
+#define MATHLIB_SEQUENCES_HPP
+
+#include "Implementation/Sequences/Scrambling.hpp"
+#include "Implementation/Sequences/Sobol.hpp"
+#include "Implementation/Sequences/Halton.hpp"
+#include "Implementation/Sequences/RSequence.hpp"
+#include "Implementation/Sequences/MultiJittered.hpp"
+
+#endif //MATHLIB_SEQUENCES_HPP
@@ -5,6 +5,7 @@
 #include "Implementation/Vector.hpp"
 #include "Implementation/VectorOperators.hpp"
 #include "Implementation/VectorUtilities.hpp"
+#include "Implementation/VectorPacket.hpp"
 
 namespace Math
 {
@@ -56,6 +57,14 @@ namespace Math
     using Vector3sz = Vector3T<SizeType>;
     using Vector4sz = Vector4T<SizeType>;
 
+    template <SizeType N> using Vector2fPacket = Vector2PacketT<f32, N>;
+    template <SizeType N> using Vector3fPacket = Vector3PacketT<f32, N>;
+    template <SizeType N> using Vector4fPacket = Vector4PacketT<f32, N>;
+
+    template <SizeType N> using Vector2dPacket = Vector2PacketT<f64, N>;
+    template <SizeType N> using Vector3dPacket = Vector3PacketT<f64, N>;
+    template <SizeType N> using Vector4dPacket = Vector4PacketT<f64, N>;
+
     //////////////////////////////////////////////////////////////////////////
     // Enforce concepts on provided types
     //////////////////////////////////////////////////////////////////////////
@@ -67,11 +67,13 @@ TEST_CASE("Test Array basics", "[Math][Common]")
     {
         Math::Random64 random;
         Math::Array<f32, 4> array(1.0f, 2.0f, 3.0f, 4.0f);
-        array.Shuffle<Math::Random64, Math::UniformDistribution>(random);
-        REQUIRE(Equal(array[0], 4.0f));
-        REQUIRE(Equal(array[1], 3.0f));
-        REQUIRE(Equal(array[2], 1.0f));
-        REQUIRE(Equal(array[3], 2.0f));
+        Math::Shuffle(array, random);
+
+        f32 sum = 0.0f;
+        f32 product = 1.0f;
+        array.ForEach([&](const f32& value) { sum += value; product *= value; });
+        REQUIRE(Equal(sum, 10.0f));
+        REQUIRE(Equal(product, 24.0f));
     }
 
     SECTION("Min and Max")
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Base.hpp>
+#include <Math/Random.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+using namespace Math::Types;
+
+namespace
+{
+    // Note(3011): Splits the range in halves down to 64 items, every task
+    // waits for the half it spawned.
+    u64 RecursiveSum(Math::TaskPool& pool, u64 begin, u64 end)
+    {
+        if (end - begin <= 64)
+        {
+            u64 sum = 0;
+            for (u64 i = begin; i < end; ++i)
+            {
+                sum += i;
+            }
+            return sum;
+        }
+
+        u64 middle = begin + (end - begin) / 2;
+        u64 second = 0;
+        Math::TaskGroup group;
+        pool.Spawn(group, [&]() { second = RecursiveSum(pool, middle, end); });
+        u64 first = RecursiveSum(pool, begin, middle);
+        pool.Wait(group);
+        return first + second;
+    }
+}
+
+TEST_CASE("Parallel execution", "[Math][Base][Parallel]")
+{
+    SECTION("ParallelFor")
+    {
+        std::vector<u32> values(1000, 0);
+        Math::ParallelFor(values.size(), [&](SizeType i) { values[Math::ToUnderlying(i)] = Math::Cast<u32>(i); }, 4);
+        for (SizeType i = 0; i < values.size(); ++i)
+        {
+            REQUIRE(values[Math::ToUnderlying(i)] == Math::Cast<u32>(i));
+        }
+    }
+
+    SECTION("Task pools")
+    {
+        for (SizeType threads : { SizeType(1), SizeType(2), SizeType(4) })
+        {
+            Math::TaskPool pool(threads);
+            REQUIRE(pool.ThreadCount() == threads);
+
+            std::atomic<std::uint32_t> counter = 0;
+            Math::TaskGroup group;
+            REQUIRE(group.Done());
+            for (u32 i = 0; i < 1000; ++i)
+            {
+                pool.Spawn(group, [&]() { counter.fetch_add(1); });
+            }
+            pool.Wait(group);
+            REQUIRE(group.Done());
+            REQUIRE(counter.load() == 1000u);
+
+            u64 n = u64(1) << 16;
+            REQUIRE(RecursiveSum(pool, 0, n) == n * (n - 1) / 2);
+        }
+    }
+
+    SECTION("Radix sort")
+    {
+        // Note(3011): Few distinct keys below the high bits, to check that
+        // equal keys keep their order, and enough of them for several chunks.
+        Math::Random64 rng(4);
+        std::vector<u64> keys;
+        for (u32 i = 0; i < 100000; ++i)
+        {
+            keys.push_back((rng() & u64(0x3FF)) | (u64(0x155) << 30));
+        }
+
+        std::vector<u64> expectedKeys = keys;
+        std::vector<u32> expectedValues(keys.size());
+        for (u32 i = 0; i < expectedValues.size(); ++i)
+        {
+            expectedValues[Math::ToUnderlying(i)] = i;
+        }
+        std::stable_sort(expectedValues.begin(), expectedValues.end(), [&](u32 a, u32 b)
+        {
+            return keys[Math::ToUnderlying(a)] < keys[Math::ToUnderlying(b)];
+        });
+        std::sort(expectedKeys.begin(), expectedKeys.end());
+
+        for (SizeType threads : { SizeType(1), SizeType(4) })
+        {
+            Math::TaskPool pool(threads);
+            for (u32 keyBits : { u32(39), u32(64) })
+            {
+                std::vector<u64> sortedKeys = keys;
+                std::vector<u32> values = std::vector<u32>(expectedValues.size());
+                for (u32 i = 0; i < values.size(); ++i)
+                {
+                    values[Math::ToUnderlying(i)] = i;
+                }
+
+                Math::RadixSort(sortedKeys, values, keyBits, pool);
+                REQUIRE(sortedKeys == expectedKeys);
+                REQUIRE(values == expectedValues);
+            }
+        }
+
+        // Note(3011): Only the low keyBits bits count.
+        Math::TaskPool pool(1);
+        std::vector<u64> lowBits = { 0x105, 0x003, 0x204 };
+        std::vector<u32> values = { 0, 1, 2 };
+        Math::RadixSort(lowBits, values, 8, pool);
+        REQUIRE(values == std::vector<u32>{ 1, 2, 0 });
+    }
+}
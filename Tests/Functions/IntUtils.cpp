@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Functions.hpp>
+#include <Math/Random.hpp>
+
+using u32 = Math::u32;
+using u64 = Math::u64;
+
+namespace
+{
+    // Note(3011): Interleaves the bits one at a time, the reference for the
+    // magic numbers of MortonCode.
+    template <typename Int>
+    Int InterleaveBits(Int x, Int y, Int z, unsigned bits)
+    {
+        Int result = 0;
+        for (unsigned i = 0; i < bits; ++i)
+        {
+            result = result | (((x >> i) & Int(1)) << (3 * i + 2));
+            result = result | (((y >> i) & Int(1)) << (3 * i + 1));
+            result = result | (((z >> i) & Int(1)) << (3 * i));
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Test MortonCode function", "[Math][Functions]")
+{
+    using Math::MortonCode;
+
+    SECTION("Test MortonCode with u32")
+    {
+        REQUIRE(MortonCode(u32(0), u32(0), u32(0)) == 0u);
+        REQUIRE(MortonCode(u32(1), u32(0), u32(0)) == 4u);
+        REQUIRE(MortonCode(u32(0), u32(1), u32(0)) == 2u);
+        REQUIRE(MortonCode(u32(0), u32(0), u32(1)) == 1u);
+        REQUIRE(MortonCode(u32(3), u32(0), u32(1)) == 0b100101u);
+        REQUIRE(MortonCode(u32(0x3FF), u32(0x3FF), u32(0x3FF)) == 0x3FFFFFFFu);
+        REQUIRE(MortonCode(u32(0x400), u32(0xC00), u32(0xFFFFFC00)) == 0u);
+    }
+
+    SECTION("Test MortonCode with u64")
+    {
+        REQUIRE(MortonCode(u64(1), u64(0), u64(0)) == 4u);
+        REQUIRE(MortonCode(u64(0x1FFFFF), u64(0x1FFFFF), u64(0x1FFFFF)) == 0x7FFFFFFFFFFFFFFFu);
+        REQUIRE(MortonCode(u64(0x100000), u64(0), u64(0)) == u64(1) << 62);
+        REQUIRE(MortonCode(u64(0x200000), u64(0), u64(0)) == 0u);
+    }
+
+    SECTION("Test MortonCode against bitwise interleaving")
+    {
+        Math::Random64 rng(3);
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            u64 x = rng() & u64(0x1FFFFF);
+            u64 y = rng() & u64(0x1FFFFF);
+            u64 z = rng() & u64(0x1FFFFF);
+            REQUIRE(MortonCode(x, y, z) == InterleaveBits(x, y, z, 21));
+
+            u32 x32 = Math::Cast<u32>(x & u64(0x3FF));
+            u32 y32 = Math::Cast<u32>(y & u64(0x3FF));
+            u32 z32 = Math::Cast<u32>(z & u64(0x3FF));
+            REQUIRE(MortonCode(x32, y32, z32) == InterleaveBits(x32, y32, z32, 10));
+        }
+    }
+}
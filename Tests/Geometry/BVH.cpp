@@ -0,0 +1,270 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Random.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using namespace Math::Geometry;
+using Math::Cast;
+
+namespace
+{
+    template <typename Primitive>
+    Intersection<f32> BruteForce(const Ray<f32>& ray, const Interval<f32>& interval, const std::vector<Primitive>& primitives, SizeType& index)
+    {
+        Intersection<f32> nearest(f32::NaN());
+        for (SizeType i = 0; i < primitives.size(); ++i)
+        {
+            Intersection<f32> hit = NearestIntersection(ray, interval, primitives[Math::ToUnderlying(i)]);
+            if (hit.IsValid() && (!nearest.IsValid() || hit.Distance < nearest.Distance))
+            {
+                nearest = hit;
+                index = i;
+            }
+        }
+        return nearest;
+    }
+
+    template <typename Primitive, typename MakePrimitive>
+    void CompareWithBruteForce(SizeType count, MakePrimitive&& make)
+    {
+        Math::Random64 rng(7);
+        Math::UniformDistribution<f32> dist(-10.0f, 10.0f);
+
+        std::vector<Primitive> primitives;
+        for (SizeType i = 0; i < count; ++i)
+        {
+            primitives.push_back(make(rng, dist));
+        }
+
+        BVH<Primitive> bvh{std::span<const Primitive>(primitives)};
+        REQUIRE(bvh.Primitives().size() == primitives.size());
+        REQUIRE(bvh.Nodes()[0].Bounds.Min.x <= -9.0f);
+
+        for (u32 i = 0; i < 2000; ++i)
+        {
+            Ray<f32> ray(Point<f32>(dist(rng) * 2.0f, dist(rng) * 2.0f, dist(rng) * 2.0f),
+                         Normalize(Math::Vector3f(dist(rng), dist(rng), dist(rng))));
+            Interval<f32> interval(0.001f, (i % 4 == 0) ? 5.0f : f32::Max());
+
+            SizeType expectedIndex = 0;
+            Intersection<f32> expected = BruteForce(ray, interval, primitives, expectedIndex);
+            BVHIntersection<f32> actual = NearestIntersection(ray, interval, bvh);
+
+            REQUIRE(expected.IsValid() == actual.IsValid());
+            REQUIRE(HasIntersection(ray, interval, bvh) == expected.IsValid());
+            if (expected.IsValid())
+            {
+                REQUIRE(actual.Distance == expected.Distance);
+                REQUIRE(NearestIntersection(ray, interval, primitives[Math::ToUnderlying(actual.Primitive)]).Distance == actual.Distance);
+            }
+        }
+    }
+}
+
+TEST_CASE("Bounding volume hierarchies", "[Math][Geometry][BVH]")
+{
+    SECTION("Triangles")
+    {
+        CompareWithBruteForce<Triangle<f32>>(1000, [](auto& rng, auto& dist)
+        {
+            Point<f32> a(dist(rng), dist(rng), dist(rng));
+            Math::Vector3f b(dist(rng), dist(rng), dist(rng));
+            Math::Vector3f c(dist(rng), dist(rng), dist(rng));
+            return Triangle<f32>(a, a + b * 0.1f, a + c * 0.1f);
+        });
+    }
+
+    SECTION("Spheres")
+    {
+        CompareWithBruteForce<Sphere<f32>>(500, [](auto& rng, auto& dist)
+        {
+            return Sphere<f32>(Point<f32>(dist(rng), dist(rng), dist(rng)), Math::Abs(dist(rng)) * 0.05f + 0.01f);
+        });
+    }
+
+    SECTION("Boxes")
+    {
+        CompareWithBruteForce<Box<f32>>(500, [](auto& rng, auto& dist)
+        {
+            Point<f32> min(dist(rng), dist(rng), dist(rng));
+            return Box<f32>(min, min + Math::Vector3f(Math::Abs(dist(rng)), Math::Abs(dist(rng)), Math::Abs(dist(rng))) * 0.05f);
+        });
+    }
+
+    SECTION("Coincident primitives")
+    {
+        std::vector<Sphere<f32>> spheres(100, Sphere<f32>(Point<f32>(1.0f, 2.0f, 3.0f), 0.5f));
+        for (BVHPreset preset : { BVHPreset::Balanced, BVHPreset::Linear })
+        {
+            BVHBuildSettings settings(preset);
+            BVH<Sphere<f32>> bvh(std::span<const Sphere<f32>>(spheres), settings);
+
+            for (const BVHNode<f32>& node : bvh.Nodes())
+            {
+                REQUIRE((!node.IsLeaf() || Cast<SizeType>(node.Count) <= settings.MaxLeafSize));
+            }
+
+            Ray<f32> ray(Point<f32>(1.0f, 2.0f, -3.0f), Math::Vector3f(0.0f, 0.0f, 1.0f));
+            BVHIntersection<f32> hit = NearestIntersection(ray, Interval<f32>(), bvh);
+            REQUIRE(hit.IsValid());
+            REQUIRE(Math::Abs(hit.Distance - 5.5f) < 1.0e-5f);
+        }
+    }
+
+    SECTION("Presets")
+    {
+        Math::Random64 rng(9);
+        Math::UniformDistribution<f32> dist(-10.0f, 10.0f);
+
+        std::vector<Sphere<f32>> spheres;
+        for (u32 i = 0; i < 2000; ++i)
+        {
+            spheres.emplace_back(Point<f32>(dist(rng), dist(rng), dist(rng)), Math::Abs(dist(rng)) * 0.05f + 0.01f);
+        }
+
+        for (BVHPreset preset : { BVHPreset::Fast, BVHPreset::Balanced, BVHPreset::Quality, BVHPreset::Linear, BVHPreset::LinearOptimized })
+        {
+            BVHBuildSettings settings(preset);
+            BVH<Sphere<f32>> bvh(std::span<const Sphere<f32>>(spheres), settings);
+            for (const BVHNode<f32>& node : bvh.Nodes())
+            {
+                REQUIRE((!node.IsLeaf() || Cast<SizeType>(node.Count) <= settings.MaxLeafSize));
+            }
+
+            for (u32 i = 0; i < 500; ++i)
+            {
+                Ray<f32> ray(Point<f32>(dist(rng) * 2.0f, dist(rng) * 2.0f, dist(rng) * 2.0f),
+                             Normalize(Math::Vector3f(dist(rng), dist(rng), dist(rng))));
+                SizeType expectedIndex = 0;
+                Intersection<f32> expected = BruteForce(ray, Interval<f32>(), spheres, expectedIndex);
+                BVHIntersection<f32> actual = NearestIntersection(ray, Interval<f32>(), bvh);
+                REQUIRE(expected.IsValid() == actual.IsValid());
+                if (expected.IsValid())
+                {
+                    REQUIRE(actual.Distance == expected.Distance);
+                }
+            }
+        }
+
+        // Note(3011): Out of range settings are clamped.
+        BVHBuildSettings extreme;
+        extreme.BinCount = 1000;
+        extreme.MaxLeafSize = 0;
+        BVH<Sphere<f32>> bvh(std::span<const Sphere<f32>>(spheres), extreme);
+        REQUIRE(bvh.Primitives().size() == spheres.size());
+    }
+
+    SECTION("Parallel builds")
+    {
+        // Note(3011): Large enough for several build threads, the hierarchy
+        // has to come out the same regardless.
+        Math::Random64 rng(10);
+        Math::UniformDistribution<f32> dist(-10.0f, 10.0f);
+
+        std::vector<Triangle<f32>> triangles;
+        for (u32 i = 0; i < 60000; ++i)
+        {
+            Point<f32> a(dist(rng), dist(rng), dist(rng));
+            triangles.emplace_back(a, a + Math::Vector3f(dist(rng), dist(rng), dist(rng)) * 0.01f,
+                                   a + Math::Vector3f(dist(rng), dist(rng), dist(rng)) * 0.01f);
+        }
+
+        for (BVHPreset preset : { BVHPreset::Balanced, BVHPreset::LinearOptimized })
+        {
+            BVH<Triangle<f32>> serial(std::span<const Triangle<f32>>(triangles), BVHBuildSettings(preset), 1);
+            BVH<Triangle<f32>> parallel(std::span<const Triangle<f32>>(triangles), BVHBuildSettings(preset), 4);
+
+            REQUIRE(serial.Nodes().size() == parallel.Nodes().size());
+            for (SizeType i = 0; i < serial.Nodes().size(); ++i)
+            {
+                const BVHNode<f32>& a = serial.Nodes()[Math::ToUnderlying(i)];
+                const BVHNode<f32>& b = parallel.Nodes()[Math::ToUnderlying(i)];
+                REQUIRE(a.Offset == b.Offset);
+                REQUIRE(a.Count == b.Count);
+                REQUIRE(a.Bounds.Min.x == b.Bounds.Min.x);
+                REQUIRE(a.Bounds.Max.z == b.Bounds.Max.z);
+            }
+            for (SizeType i = 0; i < triangles.size(); ++i)
+            {
+                REQUIRE(serial.PrimitiveIndices()[Math::ToUnderlying(i)] == parallel.PrimitiveIndices()[Math::ToUnderlying(i)]);
+            }
+        }
+    }
+
+    SECTION("Morton codes")
+    {
+        Box<f32> bounds(Point<f32>(-1.0f, 0.0f, 0.0f), Point<f32>(1.0f, 4.0f, 0.0f));
+        REQUIRE(MortonCode<u32>(Point<f32>(-1.0f, 0.0f, 0.0f), bounds) == 0u);
+        REQUIRE(MortonCode<u32>(Point<f32>(1.0f, 4.0f, 0.0f), bounds) == Math::MortonCode(u32(1023), u32(1023), u32(0)));
+        REQUIRE(MortonCode<u32>(Point<f32>(0.0f, 1.0f, 5.0f), bounds) == Math::MortonCode(u32(512), u32(256), u32(0)));
+        REQUIRE(MortonCode<u64>(Point<f32>(0.0f, 1.0f, 0.0f), bounds) == Math::MortonCode(u64(1) << 20, u64(1) << 19, u64(0)));
+        REQUIRE(MortonCode<u32>(Point<f32>(-5.0f, 9.0f, 0.0f), bounds) == Math::MortonCode(u32(0), u32(1023), u32(0)));
+    }
+
+    SECTION("Linear builds")
+    {
+        // Note(3011): Small, dense clusters far apart, the 63-bit codes and
+        // the treelets should not make the hierarchy worse than without.
+        Math::Random64 rng(11);
+        Math::UniformDistribution<f32> dist(-10.0f, 10.0f);
+
+        std::vector<Sphere<f32>> spheres;
+        for (u32 cluster = 0; cluster < 20; ++cluster)
+        {
+            Point<f32> center(dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f);
+            for (u32 i = 0; i < 100; ++i)
+            {
+                spheres.emplace_back(center + Math::Vector3f(dist(rng), dist(rng), dist(rng)) * 0.01f, 0.02f);
+            }
+        }
+
+        auto cost = [](const BVH<Sphere<f32>>& bvh)
+        {
+            f32 total = 0.0f;
+            for (const BVHNode<f32>& node : bvh.Nodes())
+            {
+                total += SurfaceArea(node.Bounds) * (node.IsLeaf() ? Cast<f32>(node.Count) : 1.0f);
+            }
+            return total / SurfaceArea(bvh.Bounds());
+        };
+
+        BVH<Sphere<f32>> linear(std::span<const Sphere<f32>>(spheres), BVHBuildSettings(BVHPreset::Linear));
+        BVH<Sphere<f32>> optimized(std::span<const Sphere<f32>>(spheres), BVHBuildSettings(BVHPreset::LinearOptimized));
+        REQUIRE(cost(optimized) <= cost(linear));
+
+        for (u32 i = 0; i < 500; ++i)
+        {
+            const Sphere<f32>& target = spheres[Math::ToUnderlying(i * 4)];
+            Point<f32> origin = target.Center + Math::Vector3f(dist(rng), dist(rng), dist(rng)) * 0.1f;
+            Ray<f32> ray(origin, Normalize(target.Center - origin));
+            SizeType expectedIndex = 0;
+            Intersection<f32> expected = BruteForce(ray, Interval<f32>(), spheres, expectedIndex);
+            for (const BVH<Sphere<f32>>* bvh : { &linear, &optimized })
+            {
+                BVHIntersection<f32> actual = NearestIntersection(ray, Interval<f32>(), *bvh);
+                REQUIRE(expected.IsValid() == actual.IsValid());
+                REQUIRE(HasIntersection(ray, Interval<f32>(), *bvh) == expected.IsValid());
+                if (expected.IsValid())
+                {
+                    REQUIRE(actual.Distance == expected.Distance);
+                }
+            }
+        }
+
+        std::vector<Sphere<f32>> single = { spheres[0] };
+        BVH<Sphere<f32>> leaf(std::span<const Sphere<f32>>(single), BVHBuildSettings(BVHPreset::LinearOptimized));
+        REQUIRE(leaf.Nodes().size() == 1);
+        REQUIRE(leaf.Nodes()[0].Count == 1u);
+    }
+
+    SECTION("Empty hierarchy")
+    {
+        BVH<Triangle<f32>> bvh;
+        Ray<f32> ray(Point<f32>(0.0f), Math::Vector3f(0.0f, 0.0f, 1.0f));
+        REQUIRE(bvh.Empty());
+        REQUIRE_FALSE(NearestIntersection(ray, Interval<f32>(), bvh).IsValid());
+        REQUIRE_FALSE(HasIntersection(ray, Interval<f32>(), bvh));
+    }
+}
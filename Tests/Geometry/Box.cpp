@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Random.hpp>
+
+using namespace Math::Types;
+using namespace Math::Geometry;
+using Math::Cast;
+
+namespace
+{
+    template <SizeType N>
+    void ComparePacketWithScalar()
+    {
+        Math::Random64 rng(5);
+        Math::UniformDistribution<f32> dist(-4.0f, 4.0f);
+
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            BoxPacket<f32, N> boxes;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                Point<f32> min(dist(rng), dist(rng), dist(rng));
+                boxes.Set(lane, Box<f32>(min, min + Math::Vector3f(Math::Abs(dist(rng)), Math::Abs(dist(rng)), Math::Abs(dist(rng)))));
+            }
+
+            // Note(3011): Every other ray is parallel to an axis.
+            Math::Vector3f direction(dist(rng), dist(rng), dist(rng));
+            if (i % 2 == 0)
+            {
+                direction[Cast<SizeType>(i / 2 % 3)] = 0.0f;
+            }
+            RayPrecomputed<f32> ray(Ray<f32>(Point<f32>(dist(rng), dist(rng), dist(rng)), direction));
+            Interval<f32> interval(0.0f, (i % 3 == 0) ? 2.0f : f32::Max());
+
+            Math::Array<f32, N> distances = NearestIntersection(ray, interval, boxes);
+            u32 mask = HasIntersection(ray, interval, boxes);
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                Intersection<f32> expected = NearestIntersection(ray, interval, boxes.Get(lane));
+                REQUIRE(expected.IsValid() == (distances[lane] == distances[lane]));
+                if (expected.IsValid())
+                {
+                    REQUIRE(expected.Distance == distances[lane]);
+                }
+
+                bool hit = HasIntersection(ray, interval, boxes.Get(lane));
+                REQUIRE(hit == ((mask & (u32(1) << Cast<u32>(lane))) != 0));
+            }
+        }
+    }
+}
+
+TEST_CASE("Ray box intersections", "[Math][Geometry][Box]")
+{
+    Box<f32> box(Point<f32>(-1.0f, -1.0f, -1.0f), Point<f32>(1.0f, 1.0f, 1.0f));
+
+    SECTION("Precomputed rays")
+    {
+        RayPrecomputed<f32> ray(Ray<f32>(Point<f32>(0.0f), Math::Vector3f(2.0f, -0.0f, -4.0f)));
+        REQUIRE(ray.InverseDirection.x == 0.5f);
+        REQUIRE(ray.InverseDirection.z == -0.25f);
+        REQUIRE(ray.Sign[0] == 0);
+        REQUIRE(ray.Sign[1] == 1);
+        REQUIRE(ray.Sign[2] == 1);
+    }
+
+    SECTION("Hits and misses")
+    {
+        Ray<f32> hit(Point<f32>(-3.0f, 0.2f, 0.3f), Math::Vector3f(1.0f, 0.1f, 0.0f));
+        REQUIRE(NearestIntersection(hit, Interval<f32>(), box).Distance == 2.0f);
+        REQUIRE(HasIntersection(hit, Interval<f32>(), box));
+        REQUIRE_FALSE(HasIntersection(hit, Interval<f32>(0.0f, 1.5f), box));
+
+        // Note(3011): From the inside the exit is the first intersection.
+        Ray<f32> inside(Point<f32>(0.0f), Math::Vector3f(0.0f, 0.0f, -1.0f));
+        REQUIRE(Math::Abs(NearestIntersection(inside, Interval<f32>(), box).Distance - 1.0f) < 1.0e-6f);
+
+        Ray<f32> away(Point<f32>(-3.0f, 0.0f, 0.0f), Math::Vector3f(-1.0f, 0.0f, 0.0f));
+        REQUIRE_FALSE(NearestIntersection(away, Interval<f32>(), box).IsValid());
+        REQUIRE_FALSE(HasIntersection(away, Interval<f32>(), box));
+    }
+
+    SECTION("Zero direction components")
+    {
+        // Note(3011): Parallel to the slabs, inside and outside of them, with
+        // +0 and -0.
+        for (f32 zero : { 0.0f, -0.0f })
+        {
+            Ray<f32> parallelInside(Point<f32>(-3.0f, 0.5f, 0.5f), Math::Vector3f(1.0f, zero, zero));
+            REQUIRE(NearestIntersection(parallelInside, Interval<f32>(), box).Distance == 2.0f);
+
+            Ray<f32> parallelOutside(Point<f32>(-3.0f, 1.5f, 0.5f), Math::Vector3f(1.0f, zero, zero));
+            REQUIRE_FALSE(HasIntersection(parallelOutside, Interval<f32>(), box));
+        }
+
+        // Note(3011): On the planes of the slabs, 0 * inf is NaN there.
+        Ray<f32> onFace(Point<f32>(-3.0f, 1.0f, 0.5f), Math::Vector3f(1.0f, 0.0f, 0.0f));
+        REQUIRE(NearestIntersection(onFace, Interval<f32>(), box).Distance == 2.0f);
+
+        Ray<f32> onEdge(Point<f32>(-3.0f, -1.0f, 1.0f), Math::Vector3f(1.0f, 0.0f, 0.0f));
+        REQUIRE(HasIntersection(onEdge, Interval<f32>(), box));
+
+        Ray<f32> degenerate(Point<f32>(0.0f), Math::Vector3f(0.0f));
+        REQUIRE(HasIntersection(degenerate, Interval<f32>(0.0f, 1.0f), box));
+    }
+
+    SECTION("Grazing rays")
+    {
+        // Note(3011): Along the diagonal of a face, the entry and exit
+        // distances are equal before rounding.
+        Ray<f32> grazing(Point<f32>(-2.0f, -2.0f, 1.0f), Math::Vector3f(1.0f, 1.0f, 0.0f));
+        REQUIRE(HasIntersection(grazing, Interval<f32>(), box));
+
+        Ray<f32> corner(Point<f32>(-1.3f, -1.7f, -1.1f), Math::Vector3f(0.3f, 0.7f, 0.1f));
+        REQUIRE(HasIntersection(corner, Interval<f32>(), box));
+    }
+
+    SECTION("Packets")
+    {
+        ComparePacketWithScalar<4>();
+        ComparePacketWithScalar<8>();
+    }
+}
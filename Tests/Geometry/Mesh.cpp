@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Random.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using namespace Math::Geometry;
+using Math::Cast;
+
+namespace
+{
+    // Note(3011): The unit cube around the origin, with the triangles facing
+    // outwards.
+    TriangleMesh<f32> Cube()
+    {
+        std::vector<Point<f32>> positions;
+        for (u32 i = 0; i < 8; ++i)
+        {
+            positions.emplace_back((i & 1) != 0 ? 0.5f : -0.5f, (i & 2) != 0 ? 0.5f : -0.5f, (i & 4) != 0 ? 0.5f : -0.5f);
+        }
+
+        std::vector<u32> indices = {
+            0, 2, 1,  1, 2, 3,
+            4, 5, 6,  5, 7, 6,
+            0, 1, 4,  1, 5, 4,
+            2, 6, 3,  3, 6, 7,
+            0, 4, 2,  2, 4, 6,
+            1, 3, 5,  3, 7, 5,
+        };
+
+        return TriangleMesh<f32>(positions, indices);
+    }
+}
+
+TEST_CASE("Triangle meshes", "[Math][Geometry][Mesh]")
+{
+    SECTION("Layout")
+    {
+        TriangleMesh<f32> mesh = Cube();
+        REQUIRE(mesh.VertexCount() == 8);
+        REQUIRE(mesh.TriangleCount() == 12);
+        REQUIRE_FALSE(mesh.HasNormals());
+        REQUIRE_FALSE(mesh.HasUVs());
+        REQUIRE(mesh.PositionsX()[3] == 0.5f);
+        REQUIRE(mesh.PositionsZ()[3] == -0.5f);
+
+        Triangle<f32> triangle = mesh.GetTriangle(1);
+        REQUIRE(triangle.A.x == 0.5f);
+        REQUIRE(triangle.B.y == 0.5f);
+        REQUIRE(triangle.C.y == 0.5f);
+
+        const MeshTriangleData<f32>& data = mesh.IntersectionData(1);
+        REQUIRE(data.Edge1.x == -1.0f);
+        REQUIRE(data.Edge2.y == 1.0f);
+
+        // Note(3011): The geometric normals point out of the cube.
+        REQUIRE(mesh.Normal(0, 0.2f, 0.2f).z == -1.0f);
+        REQUIRE(mesh.Normal(4, 0.2f, 0.2f).y == -1.0f);
+    }
+
+    SECTION("Same hits as the triangles")
+    {
+        TriangleMesh<f32> mesh = Cube();
+        Math::Random64 rng(4);
+        Math::UniformDistribution<f32> dist(-2.0f, 2.0f);
+
+        for (u32 i = 0; i < 2000; ++i)
+        {
+            Ray<f32> ray(Point<f32>(dist(rng), dist(rng), dist(rng)), Math::Vector3f(dist(rng), dist(rng), dist(rng)));
+            for (SizeType t = 0; t < mesh.TriangleCount(); ++t)
+            {
+                Intersection<f32> expected = NearestIntersection(ray, Interval<f32>(), mesh.GetTriangle(t));
+                Intersection<f32> actual = NearestIntersection(ray, Interval<f32>(), mesh, t);
+                REQUIRE(expected.IsValid() == actual.IsValid());
+                if (expected.IsValid())
+                {
+                    REQUIRE(expected.Distance == actual.Distance);
+                    REQUIRE(expected.U == actual.U);
+                    REQUIRE(expected.V == actual.V);
+                }
+
+                Intersection<f32> watertight = NearestIntersection<TriangleTest::Watertight>(ray, Interval<f32>(), mesh, t);
+                Intersection<f32> reference = NearestIntersection<TriangleTest::Watertight>(ray, Interval<f32>(), mesh.GetTriangle(t));
+                REQUIRE(watertight.IsValid() == reference.IsValid());
+            }
+        }
+    }
+
+    SECTION("Closed meshes are watertight")
+    {
+        // Note(3011): Rays from inside the cube through its edges and corners
+        // must hit it.
+        TriangleMesh<f32> mesh = Cube();
+        Math::Random64 rng(8);
+        Math::UniformDistribution<f32> inside(-0.4f, 0.4f);
+        Math::UniformDistribution<f32> along(-0.5f, 0.5f);
+
+        for (u32 i = 0; i < 5000; ++i)
+        {
+            Point<f32> origin(inside(rng), inside(rng), inside(rng));
+            Point<f32> target(0.5f, (i % 2 == 0) ? 0.5f : -0.5f, along(rng));
+            if (i % 7 == 0)
+            {
+                target = Point<f32>(0.5f, -0.5f, 0.5f);
+            }
+            Ray<f32> ray(origin, target - origin);
+
+            bool hit = false;
+            for (SizeType t = 0; t < mesh.TriangleCount(); ++t)
+            {
+                hit = hit || NearestIntersection<TriangleTest::Watertight>(ray, Interval<f32>(0.0f, f32::Max()), mesh, t).IsValid();
+            }
+            REQUIRE(hit);
+        }
+    }
+
+    SECTION("Attributes")
+    {
+        std::vector<Point<f32>> positions = { Point<f32>(0.0f, 0.0f, 0.0f), Point<f32>(1.0f, 0.0f, 0.0f), Point<f32>(0.0f, 1.0f, 0.0f) };
+        std::vector<u32> indices = { 0, 1, 2 };
+        std::vector<Math::Vector3f> normals = { Math::Vector3f(0.0f, 0.0f, 1.0f), Math::Vector3f(1.0f, 0.0f, 0.0f), Math::Vector3f(0.0f, 1.0f, 0.0f) };
+        std::vector<Math::Vector2f> uvs = { Math::Vector2f(0.0f, 0.0f), Math::Vector2f(2.0f, 0.0f), Math::Vector2f(0.0f, 4.0f) };
+        TriangleMesh<f32> mesh(positions, indices, normals, uvs);
+        REQUIRE(mesh.HasNormals());
+        REQUIRE(mesh.HasUVs());
+
+        Ray<f32> ray(Point<f32>(0.25f, 0.5f, 1.0f), Math::Vector3f(0.0f, 0.0f, -1.0f));
+        Intersection<f32> hit = NearestIntersection(ray, Interval<f32>(), mesh, 0);
+        REQUIRE(hit.IsValid());
+
+        Math::Vector2f uv = mesh.UV(0, hit.U, hit.V);
+        REQUIRE(uv.x == 0.5f);
+        REQUIRE(uv.y == 2.0f);
+
+        Math::Vector3f normal = mesh.Normal(0, hit.U, hit.V);
+        Math::Vector3f expected = Math::Normalize(Math::Vector3f(0.25f, 0.5f, 0.25f));
+        REQUIRE(Math::Abs(normal.x - expected.x) < 1.0e-6f);
+        REQUIRE(Math::Abs(normal.y - expected.y) < 1.0e-6f);
+        REQUIRE(Math::Abs(normal.z - expected.z) < 1.0e-6f);
+    }
+
+    SECTION("Hierarchies over meshes")
+    {
+        TriangleMesh<f32> mesh = Cube();
+        std::vector<MeshTriangle<f32>> triangles = MeshTriangles(mesh);
+        BVH<MeshTriangle<f32>> bvh{std::span<const MeshTriangle<f32>>(triangles)};
+
+        Ray<f32> ray(Point<f32>(0.1f, 0.2f, -3.0f), Math::Vector3f(0.0f, 0.0f, 1.0f));
+        BVHIntersection<f32> hit = NearestIntersection(ray, Interval<f32>(), bvh);
+        REQUIRE(hit.IsValid());
+        REQUIRE(hit.Distance == 2.5f);
+        REQUIRE(mesh.Normal(hit.Primitive, hit.U, hit.V).z == -1.0f);
+    }
+}
@@ -0,0 +1,209 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Random.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using namespace Math::Geometry;
+using Math::Cast;
+
+namespace
+{
+    // Note(3011): Every third packet has a ray parallel to an axis, and the
+    // rays of every other packet start at the same point.
+    template <SizeType N, typename RNG, typename Distribution>
+    RayPacket<f32, N> MakePacket(RNG& rng, Distribution& dist, u32 index)
+    {
+        RayPacket<f32, N> rays;
+        Point<f32> common(dist(rng), dist(rng), dist(rng));
+        for (SizeType lane = 0; lane < N; ++lane)
+        {
+            Math::Vector3f direction(dist(rng), dist(rng), dist(rng));
+            if (index % 3 == 0 && lane == 1)
+            {
+                direction[Cast<SizeType>(index % 3)] = (index % 2 == 0) ? 0.0f : -0.0f;
+            }
+            Point<f32> origin = (index % 2 == 0) ? common : Point<f32>(dist(rng), dist(rng), dist(rng));
+            rays.Set(lane, Ray<f32>(origin, direction));
+        }
+        return rays;
+    }
+
+    template <SizeType N>
+    void CompareShapes()
+    {
+        Math::Random64 rng(11);
+        Math::UniformDistribution<f32> dist(-4.0f, 4.0f);
+
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            RayPacket<f32, N> rays = MakePacket<N>(rng, dist, i);
+            Interval<f32> interval(0.0f, (i % 4 == 0) ? 3.0f : f32::Max());
+
+            Point<f32> min(dist(rng), dist(rng), dist(rng));
+            Box<f32> box(min, min + Math::Vector3f(Math::Abs(dist(rng)), Math::Abs(dist(rng)), Math::Abs(dist(rng))));
+            Sphere<f32> sphere(Point<f32>(dist(rng), dist(rng), dist(rng)), Math::Abs(dist(rng)) * 0.5f + 0.1f);
+            Point<f32> a(dist(rng), dist(rng), dist(rng));
+            Triangle<f32> triangle(a, a + Math::Vector3f(dist(rng), dist(rng), dist(rng)), a + Math::Vector3f(dist(rng), dist(rng), dist(rng)));
+
+            IntersectionPacket<f32, N> boxHits = NearestIntersection(rays, interval, box);
+            u32 boxMask = HasIntersection(rays, interval, box);
+            IntersectionPacket<f32, N> sphereHits = NearestIntersection(rays, interval, sphere);
+            IntersectionPacket<f32, N> triangleHits = NearestIntersection(rays, interval, triangle);
+            IntersectionPacket<f32, N> watertightHits = NearestIntersection<TriangleTest::Watertight>(rays, interval, triangle);
+
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                Ray<f32> ray = rays.Get(lane);
+
+                Intersection<f32> expectedBox = NearestIntersection(ray, interval, box);
+                REQUIRE(expectedBox.IsValid() == boxHits.IsValid(lane));
+                if (expectedBox.IsValid())
+                {
+                    REQUIRE(expectedBox.Distance == boxHits.Distance[lane]);
+                }
+                REQUIRE(HasIntersection(ray, interval, box) == ((boxMask & (u32(1) << Cast<u32>(lane))) != 0));
+
+                Intersection<f32> expectedSphere = NearestIntersection(ray, interval, sphere);
+                REQUIRE(expectedSphere.IsValid() == sphereHits.IsValid(lane));
+                if (expectedSphere.IsValid())
+                {
+                    REQUIRE(expectedSphere.Distance == sphereHits.Distance[lane]);
+                }
+
+                Intersection<f32> expectedTriangle = NearestIntersection(ray, interval, triangle);
+                REQUIRE(expectedTriangle.IsValid() == triangleHits.IsValid(lane));
+                if (expectedTriangle.IsValid())
+                {
+                    REQUIRE(expectedTriangle.Distance == triangleHits.Distance[lane]);
+                    REQUIRE(expectedTriangle.U == triangleHits.U[lane]);
+                    REQUIRE(expectedTriangle.V == triangleHits.V[lane]);
+                }
+
+                Intersection<f32> expectedWatertight = NearestIntersection<TriangleTest::Watertight>(ray, interval, triangle);
+                REQUIRE(expectedWatertight.IsValid() == watertightHits.IsValid(lane));
+            }
+        }
+    }
+
+    template <SizeType N, typename Primitive>
+    void CompareHierarchy(const std::vector<Primitive>& primitives)
+    {
+        Math::Random64 rng(13);
+        Math::UniformDistribution<f32> dist(-10.0f, 10.0f);
+        Math::UniformDistribution<f32> jitter(-0.05f, 0.05f);
+
+        BVH<Primitive> bvh{std::span<const Primitive>(primitives)};
+
+        for (u32 i = 0; i < 500; ++i)
+        {
+            // Note(3011): Coherent packets, like camera rays through a tile,
+            // alternate with random ones.
+            RayPacket<f32, N> rays;
+            Point<f32> origin(dist(rng) * 2.0f, dist(rng) * 2.0f, dist(rng) * 2.0f);
+            Math::Vector3f direction = Point<f32>(dist(rng) * 0.5f, dist(rng) * 0.5f, dist(rng) * 0.5f) - origin;
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                Math::Vector3f laneDirection = (i % 2 == 0)
+                    ? Math::Vector3f(dist(rng), dist(rng), dist(rng))
+                    : direction + Math::Vector3f(jitter(rng), jitter(rng), jitter(rng)) * direction.Length();
+                rays.Set(lane, Ray<f32>(origin, Math::Normalize(laneDirection)));
+            }
+
+            Interval<f32> interval(0.001f, (i % 4 == 0) ? 10.0f : f32::Max());
+            u32 active = (i % 3 == 0) ? u32(0b1011) : RayPacket<f32, N>::AllLanes;
+
+            BVHIntersectionPacket<f32, N> hits = bvh.NearestIntersection(rays, interval, active);
+            u32 mask = bvh.HasIntersection(rays, interval, active);
+            for (SizeType lane = 0; lane < N; ++lane)
+            {
+                bool laneActive = (active & (u32(1) << Cast<u32>(lane))) != 0;
+                BVHIntersection<f32> expected = NearestIntersection(rays.Get(lane), interval, bvh);
+                bool expectedHit = laneActive && expected.IsValid();
+
+                REQUIRE(hits.IsValid(lane) == expectedHit);
+                REQUIRE(((mask & (u32(1) << Cast<u32>(lane))) != 0) == expectedHit);
+                if (expectedHit)
+                {
+                    REQUIRE(hits.Distance[lane] == expected.Distance);
+                    REQUIRE(hits.Get(lane).Primitive == expected.Primitive);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Ray packets", "[Math][Geometry][RayPacket]")
+{
+    SECTION("Layout")
+    {
+        RayPacket<f32, 4> rays;
+        rays.Set(2, Ray<f32>(Point<f32>(1.0f, 2.0f, 3.0f), Math::Vector3f(2.0f, -4.0f, -0.0f)));
+        REQUIRE(rays.Origin.y[2] == 2.0f);
+        REQUIRE(rays.InverseDirection.x[2] == 0.5f);
+        REQUIRE(rays.InverseDirection.y[2] == -0.25f);
+        REQUIRE(rays.InverseDirection.z[2] == -f32::Infinity());
+        REQUIRE(rays.Get(2).Direction.y == -4.0f);
+        REQUIRE(RayPacket<f32, 4>::AllLanes == 0b1111);
+        REQUIRE(RayPacket<f32, 32>::AllLanes == 0xFFFFFFFF);
+    }
+
+    SECTION("Same hits as single rays")
+    {
+        CompareShapes<4>();
+        CompareShapes<8>();
+    }
+
+    SECTION("Hierarchies")
+    {
+        Math::Random64 rng(3);
+        Math::UniformDistribution<f32> dist(-10.0f, 10.0f);
+
+        std::vector<Triangle<f32>> triangles;
+        std::vector<Sphere<f32>> spheres;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            Point<f32> a(dist(rng), dist(rng), dist(rng));
+            triangles.emplace_back(a, a + Math::Vector3f(dist(rng), dist(rng), dist(rng)) * 0.1f,
+                                   a + Math::Vector3f(dist(rng), dist(rng), dist(rng)) * 0.1f);
+            spheres.emplace_back(Point<f32>(dist(rng), dist(rng), dist(rng)), Math::Abs(dist(rng)) * 0.05f + 0.01f);
+        }
+
+        CompareHierarchy<4>(triangles);
+        CompareHierarchy<8>(triangles);
+        CompareHierarchy<8>(spheres);
+
+        std::vector<Point<f32>> positions;
+        std::vector<u32> indices;
+        for (const Triangle<f32>& triangle : triangles)
+        {
+            indices.push_back(Cast<u32>(positions.size()));
+            indices.push_back(Cast<u32>(positions.size() + 1));
+            indices.push_back(Cast<u32>(positions.size() + 2));
+            positions.push_back(triangle.A);
+            positions.push_back(triangle.B);
+            positions.push_back(triangle.C);
+        }
+        TriangleMesh<f32> mesh(positions, indices);
+        CompareHierarchy<8>(MeshTriangles(mesh));
+    }
+
+    SECTION("Inactive lanes")
+    {
+        std::vector<Sphere<f32>> spheres(1, Sphere<f32>(Point<f32>(0.0f, 0.0f, 5.0f), 1.0f));
+        BVH<Sphere<f32>> bvh{std::span<const Sphere<f32>>(spheres)};
+
+        RayPacket<f32, 4> rays;
+        for (SizeType lane = 0; lane < 4; ++lane)
+        {
+            rays.Set(lane, Ray<f32>(Point<f32>(0.0f), Math::Vector3f(0.0f, 0.0f, 1.0f)));
+        }
+
+        REQUIRE(bvh.HasIntersection(rays, Interval<f32>(), 0) == 0);
+        REQUIRE(bvh.HasIntersection(rays, Interval<f32>(), 0b0101) == 0b0101);
+        BVHIntersectionPacket<f32, 4> hits = bvh.NearestIntersection(rays, Interval<f32>(), 0b0010);
+        REQUIRE_FALSE(hits.IsValid(0));
+        REQUIRE(hits.Distance[1] == 4.0f);
+    }
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Random.hpp>
+
+using namespace Math::Types;
+using namespace Math::Geometry;
+using Math::Cast;
+
+TEST_CASE("Ray triangle intersections", "[Math][Geometry][Triangle]")
+{
+    Triangle<f32> triangle(Point<f32>(0.0f, 0.0f, 0.0f), Point<f32>(1.0f, 0.0f, 0.0f), Point<f32>(0.0f, 1.0f, 0.0f));
+
+    SECTION("Hits, misses and barycentrics")
+    {
+        Ray<f32> ray(Point<f32>(0.25f, 0.5f, 2.0f), Math::Vector3f(0.0f, 0.0f, -1.0f));
+        for (Intersection<f32> hit : { NearestIntersection<TriangleTest::MollerTrumbore>(ray, Interval<f32>(), triangle),
+                                       NearestIntersection<TriangleTest::Watertight>(ray, Interval<f32>(), triangle) })
+        {
+            REQUIRE(hit.IsValid());
+            REQUIRE(hit.Distance == 2.0f);
+            REQUIRE(hit.U == 0.25f);
+            REQUIRE(hit.V == 0.5f);
+        }
+
+        // Note(3011): From behind, outside, parallel and out of the interval.
+        Ray<f32> behind(Point<f32>(0.25f, 0.25f, -1.0f), Math::Vector3f(0.0f, 0.0f, 1.0f));
+        Ray<f32> outside(Point<f32>(0.75f, 0.75f, 2.0f), Math::Vector3f(0.0f, 0.0f, -1.0f));
+        Ray<f32> parallel(Point<f32>(-1.0f, 0.25f, 0.0f), Math::Vector3f(1.0f, 0.0f, 0.0f));
+        Ray<f32> parallelAbove(Point<f32>(-1.0f, 0.25f, 1.0e-7f), Math::Vector3f(1.0f, 0.0f, 0.0f));
+
+        REQUIRE(NearestIntersection<TriangleTest::MollerTrumbore>(behind, Interval<f32>(), triangle).Distance == 1.0f);
+        REQUIRE(NearestIntersection<TriangleTest::Watertight>(behind, Interval<f32>(), triangle).Distance == 1.0f);
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::MollerTrumbore>(outside, Interval<f32>(), triangle).IsValid());
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::Watertight>(outside, Interval<f32>(), triangle).IsValid());
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::MollerTrumbore>(parallel, Interval<f32>(), triangle).IsValid());
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::Watertight>(parallel, Interval<f32>(), triangle).IsValid());
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::MollerTrumbore>(parallelAbove, Interval<f32>(), triangle).IsValid());
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::Watertight>(parallelAbove, Interval<f32>(), triangle).IsValid());
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::MollerTrumbore>(ray, Interval<f32>(0.0f, 1.0f), triangle).IsValid());
+        REQUIRE_FALSE(NearestIntersection<TriangleTest::Watertight>(ray, Interval<f32>(0.0f, 1.0f), triangle).IsValid());
+    }
+
+    SECTION("Both tests agree")
+    {
+        Math::Random64 rng(9);
+        Math::UniformDistribution<f64> dist(-5.0, 5.0);
+
+        for (u32 i = 0; i < 10000; ++i)
+        {
+            Triangle<f64> random(Point<f64>(dist(rng), dist(rng), dist(rng)),
+                                 Point<f64>(dist(rng), dist(rng), dist(rng)),
+                                 Point<f64>(dist(rng), dist(rng), dist(rng)));
+            Ray<f64> ray(Point<f64>(dist(rng), dist(rng), dist(rng)), Math::Vector3d(dist(rng), dist(rng), dist(rng)));
+
+            Intersection<f64> first = NearestIntersection<TriangleTest::MollerTrumbore>(ray, Interval<f64>(), random);
+            Intersection<f64> second = NearestIntersection<TriangleTest::Watertight>(ray, Interval<f64>(), random);
+            REQUIRE(first.IsValid() == second.IsValid());
+            if (first.IsValid())
+            {
+                REQUIRE(Math::Abs(first.Distance - second.Distance) < 1.0e-9);
+                REQUIRE(Math::Abs(first.U - second.U) < 1.0e-9);
+                REQUIRE(Math::Abs(first.V - second.V) < 1.0e-9);
+
+                // Note(3011): The barycentrics give the same point as the distance.
+                Math::Vector3d a(random.A), b(random.B), c(random.C);
+                Math::Vector3d interpolated = a * (1.0 - first.U - first.V) + b * first.U + c * first.V;
+                Math::Vector3d projected(ray.Project(first.Distance));
+                REQUIRE(Math::Abs(interpolated.x - projected.x) < 1.0e-9);
+                REQUIRE(Math::Abs(interpolated.y - projected.y) < 1.0e-9);
+                REQUIRE(Math::Abs(interpolated.z - projected.z) < 1.0e-9);
+            }
+        }
+    }
+
+    SECTION("Watertight shared edges")
+    {
+        // Note(3011): Two triangles sharing a diagonal edge, rays aimed at
+        // points along the edge must hit at least one of them.
+        Point<f32> a(-1.3f, -0.7f, 0.1f);
+        Point<f32> b(2.1f, 1.9f, -0.3f);
+        Triangle<f32> first(a, b, Point<f32>(2.3f, -1.1f, 0.2f));
+        Triangle<f32> second(b, a, Point<f32>(-1.7f, 2.2f, -0.1f));
+
+        Math::Random64 rng(2);
+        Math::UniformDistribution<f32> dist(0.0f, 1.0f);
+        Math::UniformDistribution<f32> offset(-3.0f, 3.0f);
+        for (u32 i = 0; i < 20000; ++i)
+        {
+            Point<f32> target = a + (b - a) * dist(rng);
+            Point<f32> origin(offset(rng), offset(rng), 5.0f);
+            Ray<f32> ray(origin, target - origin);
+
+            bool hit = NearestIntersection<TriangleTest::Watertight>(ray, Interval<f32>(), first).IsValid()
+                    || NearestIntersection<TriangleTest::Watertight>(ray, Interval<f32>(), second).IsValid();
+            REQUIRE(hit);
+        }
+    }
+}
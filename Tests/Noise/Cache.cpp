@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Noise.hpp>
+#include <Math/Random.hpp>
+
+using namespace Math::Types;
+using Math::Cast;
+
+TEST_CASE("Periodic noise and noise caches", "[Math][Noise]")
+{
+    SECTION("Periodic Perlin noise")
+    {
+        Math::Random64 rng(3);
+        Math::UniformDistribution<f64> dist(-40.0, 40.0);
+        for (u32 period : { 1u, 5u, 16u, 97u })
+        {
+            Math::Noise::Perlin<f64> noise(11, period);
+            REQUIRE(noise.Period() == period);
+
+            f64 shift = Cast<f64>(period);
+            for (u32 i = 0; i < 500; ++i)
+            {
+                Math::Vector2d point2(dist(rng), dist(rng));
+                REQUIRE(Math::Abs(noise(point2) - noise(point2 + Math::Vector2d(shift, -2.0 * shift))) < 1.0e-9);
+
+                Math::Vector3d point3(dist(rng), dist(rng), dist(rng));
+                REQUIRE(Math::Abs(noise(point3) - noise(point3 + Math::Vector3d(-shift, shift, 3.0 * shift))) < 1.0e-9);
+
+                Math::Vector4d point4(dist(rng), dist(rng), dist(rng), dist(rng));
+                REQUIRE(Math::Abs(noise(point4) - noise(point4 + Math::Vector4d(shift, 0.0, -shift, shift))) < 1.0e-9);
+            }
+        }
+
+        // Note(3011): The default period is the one of the permutation table.
+        Math::Noise::Perlin<f64> noise(11);
+        Math::Noise::Perlin<f64> wrapped(11, 256);
+        Math::Noise::Perlin<f64> clamped(11, 1000);
+        Math::Vector3d point(-3.7, 12.1, 100.9);
+        REQUIRE(noise(point) == wrapped(point));
+        REQUIRE(noise(point) == clamped(point));
+        REQUIRE(Math::Abs(noise(point) - noise(point + Math::Vector3d(256.0, 0.0, 0.0))) < 1.0e-9);
+    }
+
+    SECTION("Caches reproduce the noise")
+    {
+        Math::Noise::Perlin<f32> noise(2, 4);
+        Math::Noise::NoiseCache<f32, 2> cache2(noise, 4, 16);
+        Math::Noise::NoiseCache<f32, 3> cache3(noise, 4, 8, 1);
+        REQUIRE(cache2.Samples().size() == 64 * 64);
+        REQUIRE(cache3.Samples().size() == 32 * 32 * 32);
+
+        // Note(3011): Exact at the samples, close between them.
+        for (u32 i = 0; i < 32; ++i)
+        {
+            f32 t = Cast<f32>(i) / 8.0f;
+            Math::Vector3f point(t, 4.0f - t, Cast<f32>(i % 5) / 8.0f);
+            REQUIRE(Math::Abs(cache3(point) - noise(point)) < 1.0e-5f);
+        }
+
+        Math::Random64 rng(4);
+        Math::UniformDistribution<f32> dist(-20.0f, 20.0f);
+        for (u32 i = 0; i < 2000; ++i)
+        {
+            Math::Vector2f point2(dist(rng), dist(rng));
+            REQUIRE(Math::Abs(cache2(point2) - noise(point2)) < 0.02f);
+
+            Math::Vector3f point3(dist(rng), dist(rng), dist(rng));
+            REQUIRE(Math::Abs(cache3(point3) - noise(point3)) < 0.05f);
+        }
+    }
+
+    SECTION("Caches tile")
+    {
+        Math::Noise::NoiseCache<f64, 3> cache(Math::Noise::Perlin<f64>(5, 3), 3, 4);
+        Math::Random64 rng(6);
+        Math::UniformDistribution<f64> dist(0.0, 3.0);
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            Math::Vector3d point(dist(rng), dist(rng), dist(rng));
+            REQUIRE(Math::Abs(cache(point) - cache(point + Math::Vector3d(3.0, -6.0, 30.0))) < 1.0e-9);
+        }
+
+        // Note(3011): No seam, the values across the edge are as close as
+        // the ones inside of the texture.
+        f64 step = 1.0e-4;
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Math::Vector3d point(3.0 - step / 2.0, dist(rng), dist(rng));
+            REQUIRE(Math::Abs(cache(point) - cache(point + Math::Vector3d(step, 0.0, 0.0))) < 1.0e-3);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Noise.hpp>
+#include <Math/Random.hpp>
+
+using namespace Math::Types;
+
+namespace
+{
+    constexpr f64 Step = 1.0e-5;
+    constexpr f64 Tolerance = 1.0e-6;
+
+    template <typename Noise>
+    void RequireGradients(const Noise& noise)
+    {
+        Math::Random64 rng(9);
+        Math::UniformDistribution<f64> dist(-50.0, 50.0);
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            Math::Vector2d point2(dist(rng), dist(rng));
+            Math::Noise::GradientSample<Math::Vector2d> sample2 = noise.EvaluateWithGradient(point2);
+            REQUIRE(sample2.Value == noise(point2));
+            for (SizeType axis = 0; axis < 2; ++axis)
+            {
+                Math::Vector2d offset;
+                offset[axis] = Step;
+                f64 difference = (noise(point2 + offset) - noise(point2 - offset)) / (2.0 * Step);
+                REQUIRE(Math::Abs(sample2.Gradient[axis] - difference) < Tolerance);
+            }
+
+            Math::Vector3d point3(dist(rng), dist(rng), dist(rng));
+            Math::Noise::GradientSample<Math::Vector3d> sample3 = noise.EvaluateWithGradient(point3);
+            REQUIRE(sample3.Value == noise(point3));
+            for (SizeType axis = 0; axis < 3; ++axis)
+            {
+                Math::Vector3d offset;
+                offset[axis] = Step;
+                f64 difference = (noise(point3 + offset) - noise(point3 - offset)) / (2.0 * Step);
+                REQUIRE(Math::Abs(sample3.Gradient[axis] - difference) < Tolerance);
+            }
+        }
+    }
+
+    // Note(3011): The packet gradients match the scalar ones up to rounding,
+    // they only differ where the compiler contracts to FMAs differently.
+    template <SizeType N, typename Float>
+    void RequirePacketGradients(const Math::Noise::Perlin<Float>& noise, Float tolerance)
+    {
+        Math::Random64 rng(12);
+        Math::UniformDistribution<Float> dist(Float(-300.0), Float(300.0));
+        for (u32 j = 0; j < 200; ++j)
+        {
+            Math::Vector2PacketT<Float, N> points2;
+            Math::Vector3PacketT<Float, N> points3;
+            for (SizeType i = 0; i < N; ++i)
+            {
+                Float x = dist(rng);
+                Float y = dist(rng);
+                Float z = dist(rng);
+                points2.Set(i, Math::Vector2T<Float>(x, y));
+                points3.Set(i, Math::Vector3T<Float>(x, y, z));
+            }
+
+            Math::Noise::GradientPacket<Math::Vector2PacketT<Float, N>> samples2 = noise.EvaluateWithGradient(points2);
+            Math::Noise::GradientPacket<Math::Vector3PacketT<Float, N>> samples3 = noise.EvaluateWithGradient(points3);
+            for (SizeType i = 0; i < N; ++i)
+            {
+                Math::Noise::GradientSample<Math::Vector2T<Float>> sample2 = noise.EvaluateWithGradient(points2.Get(i));
+                REQUIRE(Math::Abs(samples2.Value[i] - sample2.Value) <= tolerance);
+                REQUIRE(Math::Abs(samples2.Gradient.x[i] - sample2.Gradient.x) <= tolerance);
+                REQUIRE(Math::Abs(samples2.Gradient.y[i] - sample2.Gradient.y) <= tolerance);
+
+                Math::Noise::GradientSample<Math::Vector3T<Float>> sample3 = noise.EvaluateWithGradient(points3.Get(i));
+                REQUIRE(Math::Abs(samples3.Value[i] - sample3.Value) <= tolerance);
+                REQUIRE(Math::Abs(samples3.Gradient.x[i] - sample3.Gradient.x) <= tolerance);
+                REQUIRE(Math::Abs(samples3.Gradient.y[i] - sample3.Gradient.y) <= tolerance);
+                REQUIRE(Math::Abs(samples3.Gradient.z[i] - sample3.Gradient.z) <= tolerance);
+            }
+        }
+    }
+}
+
+TEST_CASE("Noise gradients", "[Math][Noise]")
+{
+    SECTION("Perlin")
+    {
+        RequireGradients(Math::Noise::Perlin<f64>(4));
+    }
+
+    SECTION("Perlin packets")
+    {
+        RequirePacketGradients<8>(Math::Noise::Perlin<f32>(4), f32(1.0e-6f));
+        RequirePacketGradients<4>(Math::Noise::Perlin<f64>(5), f64(1.0e-12));
+        RequirePacketGradients<8>(Math::Noise::Perlin<f64>(6, 10), f64(1.0e-12));
+    }
+
+    SECTION("Simplex")
+    {
+        RequireGradients(Math::Noise::Simplex<f64>(4));
+    }
+}
@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Noise.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    template <typename Noise, typename Float>
+    void RequireGrid2D(const Noise& noise, Math::Vector2T<Float> origin, Math::Vector2T<Float> step,
+                       Math::Vector2sz extents, Float tolerance, SizeType threadCount = 1)
+    {
+        std::vector<Float> values(Math::ToUnderlying(extents.x * extents.y));
+        Math::Noise::FillGrid(noise, origin, step, extents, std::span<Float>(values), threadCount);
+        for (SizeType y = 0; y < extents.y; ++y)
+        {
+            for (SizeType x = 0; x < extents.x; ++x)
+            {
+                Math::Vector2T<Float> point(origin.x + Cast<Float>(x) * step.x, origin.y + Cast<Float>(y) * step.y);
+                REQUIRE(Math::Abs(values[Math::ToUnderlying(x + y * extents.x)] - noise(point)) <= tolerance);
+            }
+        }
+    }
+
+    template <typename Noise, typename Float>
+    void RequireGrid3D(const Noise& noise, Math::Vector3T<Float> origin, Math::Vector3T<Float> step,
+                       Math::Vector3sz extents, Float tolerance, SizeType threadCount = 1)
+    {
+        std::vector<Float> values(Math::ToUnderlying(extents.x * extents.y * extents.z));
+        Math::Noise::FillGrid(noise, origin, step, extents, std::span<Float>(values), threadCount);
+        for (SizeType z = 0; z < extents.z; ++z)
+        {
+            for (SizeType y = 0; y < extents.y; ++y)
+            {
+                for (SizeType x = 0; x < extents.x; ++x)
+                {
+                    Math::Vector3T<Float> point(origin.x + Cast<Float>(x) * step.x,
+                                                origin.y + Cast<Float>(y) * step.y,
+                                                origin.z + Cast<Float>(z) * step.z);
+                    REQUIRE(Math::Abs(values[Math::ToUnderlying(x + (y + z * extents.y) * extents.x)] - noise(point)) <= tolerance);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Noise grid evaluation", "[Math][Noise]")
+{
+    SECTION("Perlin row kernels")
+    {
+        Math::Noise::Perlin<f64> perlin(3);
+        RequireGrid2D(perlin, Math::Vector2d(-3.3, -1.7), Math::Vector2d(0.07, 0.11), Math::Vector2sz(97, 41), f64(1.0e-12));
+        RequireGrid3D(perlin, Math::Vector3d(-2.05, 0.3, -0.9), Math::Vector3d(0.13, 0.05, 0.25), Math::Vector3sz(61, 17, 9), f64(1.0e-12));
+        // Note(3011): Steps larger than a cell and exactly on the lattice.
+        RequireGrid2D(perlin, Math::Vector2d(-5.0, 2.0), Math::Vector2d(1.75, 0.5), Math::Vector2sz(13, 7), f64(1.0e-12));
+
+        Math::Noise::Perlin<f32> perlinf(3);
+        RequireGrid3D(perlinf, Math::Vector3f(1.1f, -4.2f, 0.0f), Math::Vector3f(0.01f, 0.2f, 0.3f), Math::Vector3sz(300, 5, 4), f32(1.0e-5f));
+    }
+
+    SECTION("Packet and point fallbacks")
+    {
+        RequireGrid2D(Math::Noise::Simplex<f32>(1), Math::Vector2f(-1.0f, 4.0f), Math::Vector2f(0.1f, 0.2f), Math::Vector2sz(21, 11), f32(0.0f));
+        RequireGrid3D(Math::Noise::Worley<f32>(2), Math::Vector3f(0.5f, 0.5f, -0.5f), Math::Vector3f(0.3f, 0.2f, 0.1f), Math::Vector3sz(19, 6, 3), f32(0.0f));
+        RequireGrid3D(Math::Noise::Layer<f64, Math::Noise::Perlin>(5), Math::Vector3d(0.0, 0.0, 0.0), Math::Vector3d(0.1, 0.1, 0.1), Math::Vector3sz(9, 8, 7), f64(0.0));
+    }
+
+    SECTION("Threads")
+    {
+        Math::Noise::Perlin<f32> perlin(7);
+        Math::Vector3sz extents(64, 64, 16);
+        std::vector<f32> single(Math::ToUnderlying(extents.x * extents.y * extents.z));
+        std::vector<f32> threaded(single.size());
+        Math::Noise::FillGrid(perlin, Math::Vector3f(0.0f), Math::Vector3f(0.05f), extents, std::span<f32>(single), 1);
+        Math::Noise::FillGrid(perlin, Math::Vector3f(0.0f), Math::Vector3f(0.05f), extents, std::span<f32>(threaded), 4);
+        REQUIRE(single == threaded);
+
+        RequireGrid2D(Math::Noise::Simplex<f32>(3), Math::Vector2f(0.0f), Math::Vector2f(0.01f), Math::Vector2sz(256, 256), f32(0.0f), 4);
+    }
+}
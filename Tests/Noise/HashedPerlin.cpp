@@ -0,0 +1,126 @@
+#include "NoiseTestsCommon.hpp"
+
+#include <array>
+#include <set>
+
+using namespace Math::Types;
+
+namespace
+{
+    // Note(3011): The corner gradients, recovered with central differences at
+    // the lattice points. The fade curves are flat there, so only the corner
+    // itself contributes, and the slopes are its gradient times the scale of
+    // the remap to [0, 1] (1/4 in 2D, 1/2 in 3D).
+    constexpr f64 GradientStep = 1.0e-4;
+
+    template <typename Noise>
+    std::set<std::array<i64, 2>> LatticeGradients2D(const Noise& noise)
+    {
+        std::set<std::array<i64, 2>> gradients;
+        for (i32 i = 0; i < 64; ++i)
+        {
+            for (i32 j = 0; j < 64; ++j)
+            {
+                Math::Vector2d point(Math::Cast<f64>(i), Math::Cast<f64>(j));
+                Math::Vector2d dx(GradientStep, 0.0);
+                Math::Vector2d dy(0.0, GradientStep);
+                f64 gx = (noise(point + dx) - noise(point - dx)) * 4.0 / (2.0 * GradientStep);
+                f64 gy = (noise(point + dy) - noise(point - dy)) * 4.0 / (2.0 * GradientStep);
+                gradients.insert({ Math::Round<i64>(gx), Math::Round<i64>(gy) });
+            }
+        }
+        return gradients;
+    }
+
+    template <typename Noise>
+    std::set<std::array<i64, 3>> LatticeGradients3D(const Noise& noise)
+    {
+        std::set<std::array<i64, 3>> gradients;
+        for (i32 i = 0; i < 16; ++i)
+        {
+            for (i32 j = 0; j < 16; ++j)
+            {
+                for (i32 k = 0; k < 16; ++k)
+                {
+                    Math::Vector3d point(Math::Cast<f64>(i), Math::Cast<f64>(j), Math::Cast<f64>(k));
+                    Math::Vector3d dx(GradientStep, 0.0, 0.0);
+                    Math::Vector3d dy(0.0, GradientStep, 0.0);
+                    Math::Vector3d dz(0.0, 0.0, GradientStep);
+                    f64 gx = (noise(point + dx) - noise(point - dx)) * 2.0 / (2.0 * GradientStep);
+                    f64 gy = (noise(point + dy) - noise(point - dy)) * 2.0 / (2.0 * GradientStep);
+                    f64 gz = (noise(point + dz) - noise(point - dz)) * 2.0 / (2.0 * GradientStep);
+                    gradients.insert({ Math::Round<i64>(gx), Math::Round<i64>(gy), Math::Round<i64>(gz) });
+                }
+            }
+        }
+        return gradients;
+    }
+}
+
+TEST_CASE("Hashed Perlin noise", "[Math][Noise]")
+{
+    Math::Noise::HashedPerlin<f32> noise(2);
+
+    SECTION("Range")
+    {
+        Math::Random64 rng(1);
+        Math::UniformDistribution<f32> dist(-100.0f, 100.0f);
+        for (u32 i = 0; i < 10'000; ++i)
+        {
+            Math::Vector4f point(dist(rng), dist(rng), dist(rng), dist(rng));
+            f32 value2 = noise(Math::Vector2f(point.x, point.y));
+            f32 value3 = noise(Math::Vector3f(point.x, point.y, point.z));
+            f32 value4 = noise(point);
+            REQUIRE((value2 >= 0.0f && value2 <= 1.0f));
+            REQUIRE((value3 >= 0.0f && value3 <= 1.0f));
+            REQUIRE((value4 >= 0.0f && value4 <= 1.0f));
+        }
+    }
+
+    SECTION("No period and no mirroring")
+    {
+        // Note(3011): The table based noise repeats every 256 units, this one
+        // must not, and it must not be symmetric around zero either.
+        u32 repeats = 0;
+        u32 mirrored = 0;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            Math::Vector3f point(Math::Cast<f32>(i) * 0.173f + 0.31f, 0.37f, 0.59f);
+            f32 value = noise(point);
+            repeats += (value == noise(point + Math::Vector3f(256.0f, 0.0f, 0.0f))) ? 1 : 0;
+            mirrored += (value == noise(Math::Vector3f(-point.x, point.y, point.z))) ? 1 : 0;
+        }
+        REQUIRE(repeats < 10);
+        REQUIRE(mirrored < 10);
+    }
+
+    SECTION("Seeds")
+    {
+        Math::Noise::HashedPerlin<f32> same(2);
+        Math::Noise::HashedPerlin<f32> other(3);
+        Math::Vector3f point(1.3f, -7.7f, 0.4f);
+        REQUIRE(noise(point) == same(point));
+        REQUIRE(noise(point) != other(point));
+    }
+
+    SECTION("Same gradients as Perlin")
+    {
+        std::set<std::array<i64, 2>> gradients2 = LatticeGradients2D(Math::Noise::HashedPerlin<f64>(4));
+        REQUIRE(gradients2.size() == 8);
+        REQUIRE(gradients2 == LatticeGradients2D(Math::Noise::Perlin<f64>(4)));
+        REQUIRE(gradients2.count({ 1, 2 }) == 1);
+        REQUIRE(gradients2.count({ -2, 1 }) == 1);
+
+        std::set<std::array<i64, 3>> gradients3 = LatticeGradients3D(Math::Noise::HashedPerlin<f64>(4));
+        REQUIRE(gradients3.size() == 12);
+        REQUIRE(gradients3 == LatticeGradients3D(Math::Noise::Perlin<f64>(4)));
+        REQUIRE(gradients3.count({ 1, 0, -1 }) == 1);
+    }
+
+    SECTION("Packets match scalar evaluation")
+    {
+        RequirePacketsMatch<8>(Math::Noise::HashedPerlin<f32>(5), 1000.0f);
+        RequirePacketsMatch<16>(Math::Noise::HashedPerlin<f32>(6), 1000.0f);
+        RequirePacketsMatch<4>(Math::Noise::HashedPerlin<f64>(7), 1000.0);
+    }
+}
@@ -0,0 +1,74 @@
+#include "NoiseTestsCommon.hpp"
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    constexpr u32 SampleCount = 5'000;
+
+    template <typename Noise>
+    void RequireUnitRange(const Noise& noise)
+    {
+        Math::Random64 rng(2);
+        Math::UniformDistribution<f32> dist(-30.0f, 30.0f);
+        for (u32 i = 0; i < SampleCount; ++i)
+        {
+            f32 value = noise(Math::Vector3f(dist(rng), dist(rng), dist(rng)));
+            REQUIRE(value >= 0.0f);
+            REQUIRE(value <= 1.0f);
+        }
+    }
+}
+
+TEST_CASE("Fractal noise layers", "[Math][Noise]")
+{
+    SECTION("Range")
+    {
+        for (Math::Noise::FractalMode mode : { Math::Noise::FractalMode::FBm,
+                                               Math::Noise::FractalMode::Ridged,
+                                               Math::Noise::FractalMode::Turbulence })
+        {
+            RequireUnitRange(Math::Noise::Layer<f32, Math::Noise::Simplex>(3, mode));
+            RequireUnitRange(Math::Noise::Layer<f32, Math::Noise::Perlin>(3, mode, 4, 1.9f, 0.6f));
+        }
+    }
+
+    SECTION("A single octave is the base noise")
+    {
+        Math::Noise::Layer<f64, Math::Noise::Simplex> layer(8, Math::Noise::FractalMode::FBm, 1);
+        Math::Noise::Layer<f64, Math::Noise::Simplex> turbulence(8, Math::Noise::FractalMode::Turbulence, 1);
+        Math::Random64 rng(4);
+        Math::UniformDistribution<f64> dist(-10.0, 10.0);
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Math::Vector2d point(dist(rng), dist(rng));
+            f64 base = layer.Base()(point);
+            REQUIRE(Math::Abs(layer(point) - base) < 1.0e-12);
+            REQUIRE(Math::Abs(turbulence(point) - Math::Abs(base * 2.0 - 1.0)) < 1.0e-12);
+        }
+    }
+
+    SECTION("Octaves add detail")
+    {
+        // Note(3011): Higher octaves change the value between nearby points more.
+        Math::Noise::Layer<f64, Math::Noise::Simplex> smooth(1, Math::Noise::FractalMode::FBm, 1);
+        Math::Noise::Layer<f64, Math::Noise::Simplex> detailed(1, Math::Noise::FractalMode::FBm, 8);
+        f64 smoothVariation = 0.0;
+        f64 detailedVariation = 0.0;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            Math::Vector2d point(Cast<f64>(i) * 0.01, 0.5);
+            Math::Vector2d next(Cast<f64>(i + 1) * 0.01, 0.5);
+            smoothVariation += Math::Abs(smooth(point) - smooth(next));
+            detailedVariation += Math::Abs(detailed(point) - detailed(next));
+        }
+        REQUIRE(detailedVariation > smoothVariation * 1.1);
+    }
+
+    SECTION("Packets match scalar evaluation")
+    {
+        RequirePacketsMatch<8>(Math::Noise::Layer<f32, Math::Noise::Simplex>(5, Math::Noise::FractalMode::Ridged), 20.0f);
+        RequirePacketsMatch<8>(Math::Noise::Layer<f32, Math::Noise::Perlin>(5, Math::Noise::FractalMode::Turbulence), 20.0f);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef MATHLIB_TESTS_NOISE_TESTS_COMMON_HPP
+#define MATHLIB_TESTS_NOISE_TESTS_COMMON_HPP
+
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Noise.hpp>
+#include <Math/Random.hpp>
+
+// Note(3011): Evaluates the same random points as 2D, 3D and 4D packets of
+// width N, every lane has to match the scalar evaluation exactly.
+template <Math::Types::SizeType N, typename Noise>
+void RequirePacketsMatch(const Noise& noise, typename Noise::ValueType range, Math::Types::u64 seed = 17)
+{
+    using Float = typename Noise::ValueType;
+    using Math::Types::SizeType;
+
+    Math::Random64 rng(seed);
+    Math::UniformDistribution<Float> dist(-range, range);
+    for (Math::Types::u32 j = 0; j < 200; ++j)
+    {
+        Math::Vector2PacketT<Float, N> points2;
+        Math::Vector3PacketT<Float, N> points3;
+        Math::Vector4PacketT<Float, N> points4;
+        for (SizeType i = 0; i < N; ++i)
+        {
+            Float x = dist(rng);
+            Float y = dist(rng);
+            Float z = dist(rng);
+            Float w = dist(rng);
+            points4.Set(i, Math::Vector4T<Float>(x, y, z, w));
+            points3.Set(i, Math::Vector3T<Float>(x, y, z));
+            points2.Set(i, Math::Vector2T<Float>(x, y));
+        }
+
+        Math::Array<Float, N> values2 = noise(points2);
+        Math::Array<Float, N> values3 = noise(points3);
+        Math::Array<Float, N> values4 = noise(points4);
+        for (SizeType i = 0; i < N; ++i)
+        {
+            REQUIRE(values2[i] == noise(points2.Get(i)));
+            REQUIRE(values3[i] == noise(points3.Get(i)));
+            REQUIRE(values4[i] == noise(points4.Get(i)));
+        }
+    }
+}
+
+#endif //MATHLIB_TESTS_NOISE_TESTS_COMMON_HPP
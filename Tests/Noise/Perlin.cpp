@@ -0,0 +1,34 @@
+#include "NoiseTestsCommon.hpp"
+
+using namespace Math::Types;
+using Math::Cast;
+
+TEST_CASE("Perlin noise", "[Math][Noise]")
+{
+    SECTION("Range")
+    {
+        Math::Noise::Perlin<f32> noise(2);
+        Math::Random64 rng(1);
+        Math::UniformDistribution<f32> dist(-100.0f, 100.0f);
+        for (u32 i = 0; i < 10'000; ++i)
+        {
+            Math::Vector4f point(dist(rng), dist(rng), dist(rng), dist(rng));
+            f32 value2 = noise(Math::Vector2f(point.x, point.y));
+            f32 value3 = noise(Math::Vector3f(point.x, point.y, point.z));
+            f32 value4 = noise(point);
+            REQUIRE((value2 >= 0.0f && value2 <= 1.0f));
+            REQUIRE((value3 >= 0.0f && value3 <= 1.0f));
+            REQUIRE((value4 >= 0.0f && value4 <= 1.0f));
+        }
+    }
+
+    SECTION("Packets match scalar evaluation")
+    {
+        RequirePacketsMatch<8>(Math::Noise::Perlin<f32>(5), 300.0f);
+        RequirePacketsMatch<16>(Math::Noise::Perlin<f32>(6), 300.0f);
+        RequirePacketsMatch<4>(Math::Noise::Perlin<f64>(7), 300.0);
+        RequirePacketsMatch<8>(Math::Noise::Perlin<f32>(8, 10), 300.0f);
+        RequirePacketsMatch<8>(Math::Noise::Perlin<f64>(9, 64), 300.0);
+        RequirePacketsMatch<8>(Math::Noise::Perlin<f32>(10, 1), 300.0f);
+    }
+}
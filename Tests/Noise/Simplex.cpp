@@ -0,0 +1,156 @@
+#include "NoiseTestsCommon.hpp"
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    constexpr u32 SampleCount = 20'000;
+
+    template <typename Noise, typename Point>
+    void RequireRange(const Noise& noise, Point&& point)
+    {
+        Math::Random64 rng(5);
+        Math::UniformDistribution<f32> dist(-100.0f, 100.0f);
+        f32 min = 1.0f;
+        f32 max = 0.0f;
+        for (u32 i = 0; i < SampleCount; ++i)
+        {
+            f32 value = noise(point(dist, rng));
+            min = Math::Min(min, value);
+            max = Math::Max(max, value);
+        }
+        REQUIRE(min >= 0.0f);
+        REQUIRE(max <= 1.0f);
+        // Note(3011): The scales should use most of the range.
+        REQUIRE(min < 0.15f);
+        REQUIRE(max > 0.85f);
+    }
+}
+
+TEST_CASE("Simplex noise", "[Math][Noise]")
+{
+    Math::Noise::Simplex<f32> noise(7);
+
+    SECTION("Determinism")
+    {
+        Math::Noise::Simplex<f32> other(7);
+        Math::Noise::Simplex<f32> reseeded(8);
+        u32 differences = 0;
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Math::Vector4f point(Cast<f32>(i) * 0.37f, Cast<f32>(i) * -0.21f, Cast<f32>(i) * 0.11f, 1.5f);
+            REQUIRE(noise(point) == other(point));
+            REQUIRE(noise(Math::Vector3f(point.x, point.y, point.z)) == other(Math::Vector3f(point.x, point.y, point.z)));
+            REQUIRE(noise(Math::Vector2f(point.x, point.y)) == other(Math::Vector2f(point.x, point.y)));
+            differences += (noise(point) != reseeded(point)) ? 1 : 0;
+        }
+        REQUIRE(differences > 90);
+    }
+
+    SECTION("Range")
+    {
+        RequireRange(noise, [](auto& dist, auto& rng) { return Math::Vector2f(dist(rng), dist(rng)); });
+        RequireRange(noise, [](auto& dist, auto& rng) { return Math::Vector3f(dist(rng), dist(rng), dist(rng)); });
+        RequireRange(noise, [](auto& dist, auto& rng) { return Math::Vector4f(dist(rng), dist(rng), dist(rng), dist(rng)); });
+    }
+
+    SECTION("Continuity")
+    {
+        // Note(3011): The kernels have bounded derivatives, so a small step
+        // may only change the value a little, also across simplex boundaries.
+        Math::Noise::Simplex<f64> precise(7);
+        Math::Random64 rng(11);
+        Math::UniformDistribution<f64> dist(-20.0, 20.0);
+        constexpr f64 step = 1.0e-5;
+        for (u32 i = 0; i < SampleCount; ++i)
+        {
+            Math::Vector4d point(dist(rng), dist(rng), dist(rng), dist(rng));
+            Math::Vector4d moved = point + Math::Vector4d(step, -step, step, step);
+            REQUIRE(Math::Abs(precise(Math::Vector2d(point.x, point.y)) - precise(Math::Vector2d(moved.x, moved.y))) < 1.0e-3);
+            REQUIRE(Math::Abs(precise(Math::Vector3d(point.x, point.y, point.z)) - precise(Math::Vector3d(moved.x, moved.y, moved.z))) < 1.0e-3);
+            REQUIRE(Math::Abs(precise(point) - precise(moved)) < 1.0e-3);
+        }
+    }
+
+    SECTION("Worst-case positions")
+    {
+        // Note(3011): The positions within a simplex where the kernel sum can be
+        // largest, moved to many cells by lattice vectors. A cell whose corners
+        // hash to the best (or worst) gradients drives the value to 1 (or 0).
+        Math::Noise::Simplex<f64> precise(3);
+        f64 min = 1.0;
+        f64 max = 0.0;
+        auto record = [&](f64 value)
+        {
+            REQUIRE(value >= 0.0);
+            REQUIRE(value <= 1.0);
+            min = Math::Min(min, value);
+            max = Math::Max(max, value);
+        };
+
+        constexpr f64 unskew2 = 0.21132486540518711775;
+        for (i32 i = -64; i < 64; ++i)
+        {
+            for (i32 j = -64; j < 64; ++j)
+            {
+                f64 t = Cast<f64>(i + j) * unskew2;
+                record(precise(Math::Vector2d(1.0528616 + Cast<f64>(i) - t, 1.4785190 + Cast<f64>(j) - t)));
+            }
+        }
+        REQUIRE(min < 0.001);
+        REQUIRE(max > 0.999);
+
+        min = 1.0;
+        max = 0.0;
+        constexpr f64 unskew3 = 1.0 / 6.0;
+        for (i32 i = -16; i < 16; ++i)
+        {
+            for (i32 j = -16; j < 16; ++j)
+            {
+                for (i32 k = -16; k < 16; ++k)
+                {
+                    f64 t = Cast<f64>(i + j + k) * unskew3;
+                    record(precise(Math::Vector3d(1.8331489 + Cast<f64>(i) - t, 0.1668511 + Cast<f64>(j) - t, 1.0 + Cast<f64>(k) - t)));
+                }
+            }
+        }
+        REQUIRE(min < 0.001);
+        REQUIRE(max > 0.999);
+
+        min = 1.0;
+        max = 0.0;
+        constexpr f64 unskew4 = 0.13819660112501051518;
+        for (i32 i = -8; i < 8; ++i)
+        {
+            for (i32 j = -8; j < 8; ++j)
+            {
+                for (i32 k = -8; k < 8; ++k)
+                {
+                    for (i32 l = -8; l < 8; ++l)
+                    {
+                        f64 t = Cast<f64>(i + j + k + l) * unskew4;
+                        record(precise(Math::Vector4d(1.6159238 + Cast<f64>(i) - t, 0.6159238 + Cast<f64>(j) - t,
+                                                      1.4798492 + Cast<f64>(k) - t, 1.6159238 + Cast<f64>(l) - t)));
+                    }
+                }
+            }
+        }
+        REQUIRE(min < 0.001);
+        REQUIRE(max > 0.999);
+    }
+
+    SECTION("Lattice points")
+    {
+        // Note(3011): Every gradient is zero at its own lattice point.
+        REQUIRE(noise(Math::Vector2f(0.0f, 0.0f)) == 0.5f);
+        REQUIRE(noise(Math::Vector3f(3.0f, -2.0f, 5.0f)) == 0.5f);
+        REQUIRE(noise(Math::Vector4f(0.0f, 0.0f, 0.0f, 0.0f)) == 0.5f);
+    }
+
+    SECTION("Packets match scalar evaluation")
+    {
+        RequirePacketsMatch<8>(noise, 20.0f);
+        RequirePacketsMatch<4>(Math::Noise::Simplex<f64>(3), 300.0);
+    }
+}
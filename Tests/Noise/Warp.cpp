@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Noise.hpp>
+#include <Math/Random.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+
+namespace
+{
+    template <typename Noise, typename Float>
+    void RequireBatchesMatch(const Noise& noise)
+    {
+        Math::Random64 rng(8);
+        Math::UniformDistribution<Float> dist(Float(-20.0), Float(20.0));
+
+        // Note(3011): Not a multiple of the packet width, to cover the tail.
+        std::vector<Math::Vector2T<Float>> points2(203);
+        std::vector<Math::Vector3T<Float>> points3(203);
+        for (SizeType i = 0; i < 203; ++i)
+        {
+            points2[Math::ToUnderlying(i)] = Math::Vector2T<Float>(dist(rng), dist(rng));
+            points3[Math::ToUnderlying(i)] = Math::Vector3T<Float>(dist(rng), dist(rng), dist(rng));
+        }
+
+        std::vector<Float> values2(points2.size());
+        std::vector<Float> values3(points3.size());
+        noise.Evaluate(std::span<const Math::Vector2T<Float>>(points2), std::span<Float>(values2));
+        noise.Evaluate(std::span<const Math::Vector3T<Float>>(points3), std::span<Float>(values3));
+        for (std::size_t i = 0; i < points2.size(); ++i)
+        {
+            REQUIRE(values2[i] == noise(points2[i]));
+            REQUIRE(values3[i] == noise(points3[i]));
+        }
+    }
+
+    // Note(3011): A warper with gradients in 3D only.
+    class GradientIn3D
+    {
+    public:
+        using ValueType = f64;
+
+        GradientIn3D(u64 seed)
+            : mNoise(seed)
+        {}
+
+        f64 operator() (const Math::Vector2d& in) const { return mNoise(in); }
+        f64 operator() (const Math::Vector3d& in) const { return mNoise(in); }
+
+        Math::Noise::GradientSample<Math::Vector3d> EvaluateWithGradient(const Math::Vector3d& in) const
+        {
+            return mNoise.EvaluateWithGradient(in);
+        }
+    private:
+        Math::Noise::Perlin<f64> mNoise;
+    };
+}
+
+TEST_CASE("Domain warping", "[Math][Noise]")
+{
+    using Simplex = Math::Noise::Simplex<f32>;
+    using Perlin = Math::Noise::Perlin<f64>;
+
+    SECTION("No strength is the base noise")
+    {
+        Math::Noise::Warp<Simplex, Simplex> warp(Simplex(1), Simplex(2), 0.0f);
+        Math::Vector3f point(1.5f, -2.25f, 7.0f);
+        REQUIRE(warp(point) == Simplex(1)(point));
+    }
+
+    SECTION("Gradient fields")
+    {
+        Math::Noise::Warp<Perlin, Perlin> warp(Perlin(1), Perlin(2), 0.5, Math::Noise::WarpField::Gradient);
+        Math::Random64 rng(3);
+        Math::UniformDistribution<f64> dist(-10.0, 10.0);
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Math::Vector3d point(dist(rng), dist(rng), dist(rng));
+            Math::Vector3d warped = point + Perlin(2).EvaluateWithGradient(point).Gradient * 0.5;
+            REQUIRE(warp(point) == Perlin(1)(warped));
+        }
+    }
+
+    SECTION("Warpers with gradients default to the gradient field")
+    {
+        Math::Noise::Warp<Perlin, Perlin> warp(Perlin(1), Perlin(2), 0.5);
+        Math::Noise::Warp<Perlin, Perlin> gradient(Perlin(1), Perlin(2), 0.5, Math::Noise::WarpField::Gradient);
+        Math::Random64 rng(4);
+        Math::UniformDistribution<f64> dist(-10.0, 10.0);
+        for (u32 i = 0; i < 100; ++i)
+        {
+            f64 x = dist(rng);
+            f64 y = dist(rng);
+            f64 z = dist(rng);
+            REQUIRE(warp(Math::Vector2d(x, y)) == gradient(Math::Vector2d(x, y)));
+            REQUIRE(warp(Math::Vector3d(x, y, z)) == gradient(Math::Vector3d(x, y, z)));
+        }
+    }
+
+    SECTION("Dimensions without gradients use offsets")
+    {
+        Math::Noise::Warp<Perlin, GradientIn3D> warp(Perlin(1), GradientIn3D(2), 0.5, Math::Noise::WarpField::Gradient);
+        Math::Noise::Warp<Perlin, GradientIn3D> offsets(Perlin(1), GradientIn3D(2), 0.5, Math::Noise::WarpField::Offsets);
+        Math::Vector2d point2(1.5, -2.25);
+        Math::Vector3d point3(1.5, -2.25, 7.0);
+        Math::Vector3d warped = point3 + Perlin(2).EvaluateWithGradient(point3).Gradient * 0.5;
+        REQUIRE(warp(point2) == offsets(point2));
+        REQUIRE(warp(point3) == Perlin(1)(warped));
+    }
+
+    SECTION("Offset fields move the points")
+    {
+        Math::Noise::Warp<Simplex, Simplex> warp(Simplex(1), Simplex(2), 4.0f, Math::Noise::WarpField::Offsets);
+        u32 changed = 0;
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Math::Vector2f point(Math::Cast<f32>(i) * 0.37f, 0.5f);
+            changed += (warp(point) != Simplex(1)(point)) ? 1 : 0;
+        }
+        REQUIRE(changed > 90);
+    }
+
+    SECTION("Batches match scalar evaluation")
+    {
+        RequireBatchesMatch<Math::Noise::Warp<Simplex, Math::Noise::HashedPerlin<f32>>, f32>({ Simplex(1), Math::Noise::HashedPerlin<f32>(2), 2.0f });
+        RequireBatchesMatch<Math::Noise::Warp<Perlin, Perlin>, f64>({ Perlin(1), Perlin(2), 0.7, Math::Noise::WarpField::Gradient });
+        RequireBatchesMatch<Math::Noise::Warp<Perlin, Math::Noise::Worley<f64>>, f64>({ Perlin(1), Math::Noise::Worley<f64>(2), 1.5 });
+        RequireBatchesMatch<Math::Noise::Warp<Perlin, Math::Noise::Simplex<f64>>, f64>({ Perlin(1), Math::Noise::Simplex<f64>(2), 0.7 });
+        RequireBatchesMatch<Math::Noise::Warp<Perlin, GradientIn3D>, f64>({ Perlin(1), GradientIn3D(2), 0.7 });
+    }
+
+    SECTION("Nested warps")
+    {
+        using Inner = Math::Noise::Warp<Simplex, Simplex>;
+        Math::Noise::Warp<Inner, Simplex> warp(Inner(Simplex(1), Simplex(2), 1.0f), Simplex(3), 1.0f);
+        Math::Vector3sz extents(16, 8, 4);
+        std::vector<f32> values(Math::ToUnderlying(extents.x * extents.y * extents.z));
+        Math::Noise::FillGrid(warp, Math::Vector3f(0.0f), Math::Vector3f(0.1f), extents, std::span<f32>(values), 1);
+        for (f32 value : values)
+        {
+            REQUIRE((value >= 0.0f && value <= 1.0f));
+        }
+        REQUIRE(values[17] == warp(Math::Vector3f(0.1f, 0.1f, 0.0f)));
+    }
+}
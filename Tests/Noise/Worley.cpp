@@ -0,0 +1,116 @@
+#include "NoiseTestsCommon.hpp"
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    constexpr u32 SampleCount = 10'000;
+}
+
+TEST_CASE("Worley noise", "[Math][Noise]")
+{
+    Math::Random64 rng(3);
+    Math::UniformDistribution<f64> dist(-50.0, 50.0);
+
+    SECTION("Distance ordering")
+    {
+        Math::Noise::Worley<f64> euclidean(5, Math::Noise::WorleyMetric::Euclidean);
+        Math::Noise::Worley<f64> manhattan(5, Math::Noise::WorleyMetric::Manhattan);
+        Math::Noise::Worley<f64> chebyshev(5, Math::Noise::WorleyMetric::Chebyshev);
+        for (u32 i = 0; i < SampleCount; ++i)
+        {
+            Math::Vector3d point(dist(rng), dist(rng), dist(rng));
+            Math::Noise::WorleySample<f64> e = euclidean.Evaluate(point);
+            Math::Noise::WorleySample<f64> m = manhattan.Evaluate(point);
+            Math::Noise::WorleySample<f64> c = chebyshev.Evaluate(point);
+
+            REQUIRE(e.F1 >= 0.0);
+            REQUIRE(e.F1 <= e.F2);
+            REQUIRE(m.F1 <= m.F2);
+            REQUIRE(c.F1 <= c.F2);
+            // Note(3011): The metrics are ordered for every feature point, so
+            // the minima are too.
+            REQUIRE(c.F1 <= e.F1);
+            REQUIRE(e.F1 <= m.F1);
+        }
+    }
+
+    SECTION("Lipschitz continuity of F1")
+    {
+        Math::Noise::Worley<f64> noise(9);
+        for (u32 i = 0; i < SampleCount; ++i)
+        {
+            Math::Vector2d point(dist(rng), dist(rng));
+            Math::Vector2d moved = point + Math::Vector2d(0.01, -0.02);
+            REQUIRE(Math::Abs(noise(point) - noise(moved)) <= (moved - point).Length() + 1.0e-12);
+        }
+    }
+
+    SECTION("Output selection")
+    {
+        Math::Noise::Worley<f64> f1(2, Math::Noise::WorleyMetric::Euclidean, Math::Noise::WorleyOutput::F1);
+        Math::Noise::Worley<f64> f2(2, Math::Noise::WorleyMetric::Euclidean, Math::Noise::WorleyOutput::F2);
+        Math::Noise::Worley<f64> difference(2, Math::Noise::WorleyMetric::Euclidean, Math::Noise::WorleyOutput::F2MinusF1);
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Math::Vector4d point(dist(rng), dist(rng), dist(rng), dist(rng));
+            Math::Noise::WorleySample<f64> sample = f1.Evaluate(point);
+            REQUIRE(f1(point) == sample.F1);
+            REQUIRE(f2(point) == sample.F2);
+            REQUIRE(difference(point) == sample.F2 - sample.F1);
+        }
+    }
+
+    SECTION("Cell IDs")
+    {
+        // Note(3011): Points next to a feature point belong to its cell.
+        Math::Noise::Worley<f64> noise(4);
+        Math::Noise::Worley<f64> other(5);
+        u32 changes = 0;
+        u32 differences = 0;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            Math::Vector2d point(dist(rng), dist(rng));
+            Math::Noise::WorleySample<f64> sample = noise.Evaluate(point);
+            Math::Noise::WorleySample<f64> nearby = noise.Evaluate(point + Math::Vector2d(1.0e-3, 0.0));
+            changes += (sample.CellID != nearby.CellID) ? 1 : 0;
+            differences += (sample.CellID != other.Evaluate(point).CellID) ? 1 : 0;
+        }
+        REQUIRE(changes < 20);
+        REQUIRE(differences > 990);
+    }
+
+    SECTION("Packets match scalar evaluation")
+    {
+        Math::UniformDistribution<f32> packetDist(-20.0f, 20.0f);
+        for (Math::Noise::WorleyMetric metric : { Math::Noise::WorleyMetric::Euclidean,
+                                                  Math::Noise::WorleyMetric::Manhattan,
+                                                  Math::Noise::WorleyMetric::Chebyshev })
+        {
+            Math::Noise::Worley<f32> noise(1, metric, Math::Noise::WorleyOutput::F2MinusF1);
+            RequirePacketsMatch<8>(noise, 20.0f);
+            RequirePacketsMatch<4>(Math::Noise::Worley<f64>(3, metric, Math::Noise::WorleyOutput::F2), 300.0);
+
+            // Note(3011): The values only cover F2 - F1, the samples also
+            // have to match on their own.
+            Math::Vector3fPacket<8> points;
+            for (SizeType i = 0; i < 8; ++i)
+            {
+                f32 x = packetDist(rng);
+                f32 y = packetDist(rng);
+                f32 z = packetDist(rng);
+                points.Set(i, Math::Vector3f(x, y, z));
+            }
+
+            Math::Array<Math::Noise::WorleySample<f32>, 8> samples = noise.Evaluate(points);
+            for (SizeType i = 0; i < 8; ++i)
+            {
+                Math::Noise::WorleySample<f32> sample = noise.Evaluate(points.Get(i));
+                REQUIRE(samples[i].F1 == sample.F1);
+                REQUIRE(samples[i].F2 == sample.F2);
+                REQUIRE(samples[i].CellID == sample.CellID);
+            }
+        }
+    }
+}
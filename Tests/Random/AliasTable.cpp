@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Random.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    // Note(3011): Computes the exact probability of each outcome implied by the
+    // table, so the construction can be checked without statistical noise.
+    template <typename Table>
+    std::vector<f64> ImpliedProbabilities(const Table& table)
+    {
+        auto entries = table.Entries();
+        std::vector<f64> result(entries.size(), 0.0);
+        f64 bucketProbability = 1.0 / Cast<f64>(entries.size());
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            f64 keep = Cast<f64>(entries[i].Threshold) * 0x1.0p-32;
+            result[i] += bucketProbability * keep;
+            result[Math::ToUnderlying(entries[i].Alias)] += bucketProbability * (1.0 - keep);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("AliasTable construction", "[Math][Random]")
+{
+    SECTION("Implied probabilities match the weights")
+    {
+        std::vector<f32> weights = { 1.0f, 0.0f, 5.0f, 2.5f, 0.25f, 10.0f, 1.0f };
+        Math::AliasTable<f32> table(weights);
+        REQUIRE(table.Size() == weights.size());
+
+        f64 total = 0.0;
+        for (f32 weight : weights)
+        {
+            total += Cast<f64>(weight);
+        }
+
+        std::vector<f64> implied = ImpliedProbabilities(table);
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            f64 expected = Cast<f64>(weights[i]) / total;
+            REQUIRE(Math::Abs(implied[i] - expected) < 1e-6);
+            REQUIRE(Math::Abs(Cast<f64>(table.Pdf(Cast<u32>(i))) - expected) < 1e-6);
+        }
+    }
+
+    SECTION("Zero weights are never sampled")
+    {
+        std::vector<f64> weights = { 0.0, 3.0, 0.0, 1.0 };
+        Math::AliasTable<f64> table(weights);
+
+        Math::Random64 rng(5);
+        for (SizeType i = 0; i < 10'000; ++i)
+        {
+            u32 index = table(rng);
+            REQUIRE((index == 1u || index == 3u));
+        }
+    }
+
+    SECTION("Degenerate weights fall back to uniform")
+    {
+        std::vector<f32> weights(16, 0.0f);
+        Math::AliasTable<f32> table(weights);
+
+        std::vector<f64> implied = ImpliedProbabilities(table);
+        for (f64 probability : implied)
+        {
+            REQUIRE(Math::Abs(probability - 1.0 / 16.0) < 1e-6);
+        }
+    }
+
+    SECTION("Large tables")
+    {
+        std::vector<f32> weights(100'000);
+        Math::Random64 rng(3);
+        Math::UniformUnitDistribution<f32> dist;
+        for (f32& weight : weights)
+        {
+            weight = Math::Squared(dist(rng));
+        }
+
+        Math::AliasTable<f32> table(weights);
+        std::vector<f64> implied = ImpliedProbabilities(table);
+        f64 total = 0.0;
+        for (f32 weight : weights)
+        {
+            total += Cast<f64>(weight);
+        }
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            REQUIRE(Math::Abs(implied[i] - Cast<f64>(weights[i]) / total) < 1e-9);
+        }
+    }
+
+    SECTION("Parallel builds")
+    {
+        // Note(3011): Several chunks and parts, with runs of heavy and light
+        // weights, the table has to come out the same for any thread count.
+        std::vector<f64> weights(70'000);
+        Math::Random64 rng(4);
+        Math::UniformUnitDistribution<f64> dist;
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            weights[i] = (i % 5000 < 100) ? 50.0 * dist(rng) : dist(rng);
+        }
+
+        Math::AliasTable<f64> serial(weights, 1);
+        Math::AliasTable<f64> parallel(weights, 4);
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            REQUIRE(serial.Entries()[i].Threshold == parallel.Entries()[i].Threshold);
+            REQUIRE(serial.Entries()[i].Alias == parallel.Entries()[i].Alias);
+        }
+
+        std::vector<f64> implied = ImpliedProbabilities(parallel);
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            REQUIRE(Math::Abs(implied[i] - Cast<f64>(parallel.Pdf(Cast<u32>(i)))) < 1e-9);
+        }
+    }
+}
+
+TEST_CASE("AliasTable sampling", "[Math][Random]")
+{
+    std::vector<f32> weights = { 1.0f, 2.0f, 3.0f, 4.0f };
+    Math::AliasTable<f32> table(weights);
+
+    SECTION("Sampling frequencies")
+    {
+        Math::Random64 rng(9);
+        std::vector<SizeType> counts(weights.size(), 0);
+        constexpr SizeType sampleCount = 400'000;
+        for (SizeType i = 0; i < sampleCount; ++i)
+        {
+            ++counts[Math::ToUnderlying(table(rng))];
+        }
+
+        for (std::size_t i = 0; i < weights.size(); ++i)
+        {
+            f64 frequency = Cast<f64>(counts[i]) / Cast<f64>(sampleCount);
+            REQUIRE(Math::Abs(frequency - Cast<f64>(weights[i]) / 10.0) < 0.005);
+        }
+    }
+
+    SECTION("Works with 32-bit generators")
+    {
+        Math::Random32 rng(9);
+        for (SizeType i = 0; i < 1000; ++i)
+        {
+            REQUIRE(table(rng) < 4u);
+        }
+    }
+
+    SECTION("Sampling from unit values")
+    {
+        REQUIRE(table.Sample(f32(0.0f)) < 4u);
+        REQUIRE(table.Sample(f32(0.999999f)) < 4u);
+        REQUIRE(table.Sample(f32(1.0f)) < 4u);
+    }
+}
@@ -0,0 +1,242 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Functions.hpp>
+#include <Math/Random.hpp>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    bool IsPermutation(std::vector<u32> values)
+    {
+        std::sort(values.begin(), values.end());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i] != Cast<u32>(i))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Bounded random integers", "[Math][Random]")
+{
+    SECTION("Wide multiplication")
+    {
+        Math::WideProduct product = Math::MultiplyWide(u64::Max(), u64::Max());
+        REQUIRE(product.High == u64::Max() - 1);
+        REQUIRE(product.Low == 1u);
+
+        product = Math::MultiplyWide(0x123456789ABCDEF0, 0x10);
+        REQUIRE(product.High == 0x1u);
+        REQUIRE(product.Low == 0x23456789ABCDEF00u);
+    }
+
+    // Note(3011): The tolerances are ~5 standard deviations of the counts.
+
+    SECTION("Batched draws are jointly uniform")
+    {
+        Math::Random64 rng(21);
+        const u64 bounds[3] = { 3, 5, 7 };
+        std::vector<u32> counts(3 * 5 * 7, 0);
+        for (u32 i = 0; i < 210'000; ++i)
+        {
+            u64 results[3];
+            Math::BoundedRandomBatch(rng, bounds, results);
+            REQUIRE(results[0] < 3u);
+            REQUIRE(results[1] < 5u);
+            REQUIRE(results[2] < 7u);
+            ++counts[Math::ToUnderlying((results[0] * 5 + results[1]) * 7 + results[2])];
+        }
+
+        for (u32 count : counts)
+        {
+            REQUIRE(count > 1750u);
+            REQUIRE(count < 2250u);
+        }
+    }
+
+    SECTION("Large bounds")
+    {
+        Math::Random32 rng(5);
+        u64 bound = (u64(1) << 63) + 12345;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            REQUIRE(Math::BoundedRandom(rng, bound) < bound);
+            REQUIRE(Math::BoundedRandom(rng, 1) == 0u);
+        }
+    }
+}
+
+TEST_CASE("Shuffling", "[Math][Random]")
+{
+    SECTION("All permutations are equally likely")
+    {
+        Math::Random64 rng(3);
+        std::vector<u32> counts(24, 0);
+        for (u32 i = 0; i < 240'000; ++i)
+        {
+            u32 values[4] = { 0, 1, 2, 3 };
+            Math::Shuffle(std::span<u32>(values), rng);
+
+            // Note(3011): Lehmer code of the permutation.
+            u32 code = 0;
+            for (u32 j = 0; j < 4; ++j)
+            {
+                u32 smaller = 0;
+                for (u32 k = j + 1; k < 4; ++k)
+                {
+                    smaller += (values[Math::ToUnderlying(k)] < values[Math::ToUnderlying(j)]) ? 1 : 0;
+                }
+                code = code * (4 - j) + smaller;
+            }
+            ++counts[Math::ToUnderlying(code)];
+        }
+
+        for (u32 count : counts)
+        {
+            REQUIRE(count > 9500u);
+            REQUIRE(count < 10500u);
+        }
+    }
+
+    SECTION("Large spans use every batch size")
+    {
+        Math::Random64 rng(8);
+        std::vector<u32> values = Math::RandomPermutation(100'000, rng);
+        REQUIRE(values.size() == 100'000);
+        REQUIRE(IsPermutation(values));
+
+        u32 fixedPoints = 0;
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            fixedPoints += (values[i] == Cast<u32>(i)) ? 1 : 0;
+        }
+        REQUIRE(fixedPoints < 10u);
+    }
+
+    SECTION("Partial shuffle moves a uniform selection to the front")
+    {
+        Math::Random64 rng(4);
+        std::vector<u32> counts(10, 0);
+        for (u32 i = 0; i < 50'000; ++i)
+        {
+            u32 values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+            Math::PartialShuffle(std::span<u32>(values), 3, rng);
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                ++counts[Math::ToUnderlying(values[j])];
+            }
+        }
+
+        for (u32 count : counts)
+        {
+            REQUIRE(count > 14'000u);
+            REQUIRE(count < 16'000u);
+        }
+    }
+
+    SECTION("Trivial spans")
+    {
+        Math::Random64 rng(1);
+        Math::Shuffle(std::span<u32>(), rng);
+        REQUIRE(Math::RandomPermutation(0, rng).empty());
+        REQUIRE(Math::RandomPermutation(1, rng) == std::vector<u32>{ 0 });
+    }
+}
+
+TEST_CASE("Sampling without replacement", "[Math][Random]")
+{
+    auto check = [](u32 count, u32 size, u32 tolerance)
+    {
+        Math::Random64 rng(Cast<u64>(count));
+        std::vector<u32> hits(Math::ToUnderlying(size), 0);
+        constexpr u32 trials = 20'000;
+        for (u32 i = 0; i < trials; ++i)
+        {
+            std::vector<u32> sample = Math::SampleWithoutReplacement(count, size, rng);
+            REQUIRE(sample.size() == Math::ToUnderlying(count));
+            std::sort(sample.begin(), sample.end());
+            REQUIRE(std::adjacent_find(sample.begin(), sample.end()) == sample.end());
+            for (u32 index : sample)
+            {
+                REQUIRE(index < size);
+                ++hits[Math::ToUnderlying(index)];
+            }
+        }
+
+        u32 expected = trials * count / size;
+        for (u32 hit : hits)
+        {
+            REQUIRE(hit + tolerance > expected);
+            REQUIRE(hit < expected + tolerance);
+        }
+    };
+
+    SECTION("Sparse selections (Floyd)")
+    {
+        check(5, 50, 250);
+        check(1, 7, 400);
+    }
+
+    SECTION("Dense selections (partial shuffle)")
+    {
+        check(30, 50, 350);
+        check(50, 50, 1);
+    }
+
+    SECTION("Counts larger than the size are clamped")
+    {
+        Math::Random64 rng(2);
+        REQUIRE(IsPermutation(Math::SampleWithoutReplacement(10, 4, rng)));
+        REQUIRE(Math::SampleWithoutReplacement(0, 1000, rng).empty());
+    }
+}
+
+TEST_CASE("Reservoir sampling", "[Math][Random]")
+{
+    SECTION("Short streams are kept whole")
+    {
+        Math::Random64 rng(6);
+        Math::ReservoirSampler<u32> reservoir(8);
+        for (u32 i = 0; i < 5; ++i)
+        {
+            reservoir.Add(i, rng);
+        }
+        REQUIRE(reservoir.Seen() == 5u);
+        REQUIRE(IsPermutation(std::vector<u32>(reservoir.Samples().begin(), reservoir.Samples().end())));
+    }
+
+    SECTION("Every value is equally likely to be kept")
+    {
+        Math::Random64 rng(10);
+        std::vector<u32> hits(100, 0);
+        Math::ReservoirSampler<u32> reservoir(5);
+        for (u32 i = 0; i < 20'000; ++i)
+        {
+            reservoir.Clear();
+            for (u32 value = 0; value < 100; ++value)
+            {
+                reservoir.Add(value, rng);
+            }
+
+            REQUIRE(reservoir.Samples().size() == 5);
+            for (u32 value : reservoir.Samples())
+            {
+                ++hits[Math::ToUnderlying(value)];
+            }
+        }
+
+        for (u32 hit : hits)
+        {
+            REQUIRE(hit > 840u);
+            REQUIRE(hit < 1160u);
+        }
+    }
+}
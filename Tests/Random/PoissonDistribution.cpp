@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Random.hpp>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    struct SampleMoments
+    {
+        f64 Mean;
+        f64 Variance;
+    };
+
+    template <typename Dist, typename RNG>
+    SampleMoments Moments(const Dist& dist, RNG& rng, SizeType count)
+    {
+        f64 sum = 0.0;
+        f64 sumSqr = 0.0;
+        for (SizeType i = 0; i < count; ++i)
+        {
+            f64 sample = Cast<f64>(dist(rng));
+            sum += sample;
+            sumSqr += sample * sample;
+        }
+
+        f64 n = Cast<f64>(count);
+        f64 mean = sum / n;
+        return { mean, sumSqr / n - mean * mean };
+    }
+
+    // Note(3011): Always returns the largest value, which the uniform
+    // distributions turn into their largest draw, just below 1.
+    template <typename T>
+    class MaxFakeRNG
+    {
+    public:
+        using ValueType = T;
+        MaxFakeRNG(T) {}
+        ValueType operator()() { return T::Max(); }
+
+        // These are here to satisfy the RandomNumberGenerator concept.
+        [[maybe_unused]] MaxFakeRNG Jump() { return *this; }
+        [[maybe_unused]] MaxFakeRNG LongJump() { return *this; }
+    };
+}
+
+TEST_CASE("PoissonDistribution sample moments", "[Math][Random]")
+{
+    constexpr SizeType sampleCount = 200'000;
+
+    // Note(3011): The tolerances are ~5 standard errors of the estimators,
+    // so these should practically never fail for a correct implementation.
+
+    SECTION("Zero mean")
+    {
+        Math::Random64 rng(7);
+        Math::PoissonDistribution<u32> dist(0.0f);
+        for (SizeType i = 0; i < 1000; ++i)
+        {
+            REQUIRE(dist(rng) == 0u);
+        }
+    }
+
+    SECTION("Means sampled by inversion")
+    {
+        for (f64 mean : { 0.1, 1.0, 4.5, 9.9 })
+        {
+            Math::Random64 rng(11);
+            Math::PoissonDistribution<u64> dist(mean);
+            SampleMoments moments = Moments(dist, rng, sampleCount);
+
+            f64 meanError = 5.0 * Math::Sqrt(mean / Cast<f64>(sampleCount));
+            REQUIRE(Math::Abs(moments.Mean - mean) < meanError);
+            REQUIRE(Math::Abs(moments.Variance - mean) < 0.05 * mean + meanError);
+        }
+    }
+
+    SECTION("Small means with f32 mean type")
+    {
+        // Note(3011): Enough draws that some of them land above the largest
+        // value the CDF reaches when summed in f32.
+        Math::Random32 rng(19);
+        Math::PoissonDistribution<u32> dist(4.0f);
+        SampleMoments moments = Moments(dist, rng, SizeType(1) << 20);
+
+        REQUIRE(Math::Abs(moments.Mean - 4.0) < 5.0 * Math::Sqrt(4.0 / Cast<f64>(SizeType(1) << 20)));
+        REQUIRE(Math::Abs(moments.Variance - 4.0) < 0.05 * 4.0);
+    }
+
+    SECTION("Largest uniform draws")
+    {
+        MaxFakeRNG<u32> rng32(0);
+        u32 sample32 = Math::PoissonDistribution<u32>(4.0f)(rng32);
+        REQUIRE(sample32 >= 10u);
+        REQUIRE(sample32 <= 40u);
+
+        MaxFakeRNG<u64> rng64(0);
+        for (f64 mean : { 0.1, 4.0, 9.9 })
+        {
+            u64 sample64 = Math::PoissonDistribution<u64>(mean)(rng64);
+            REQUIRE(sample64 >= 5u);
+            REQUIRE(sample64 <= 60u);
+        }
+    }
+
+    SECTION("Means sampled by transformed rejection")
+    {
+        for (f64 mean : { 10.0, 57.3, 1000.0, 100'000.0 })
+        {
+            Math::Random64 rng(13);
+            Math::PoissonDistribution<u64> dist(mean);
+            SampleMoments moments = Moments(dist, rng, sampleCount);
+
+            f64 meanError = 5.0 * Math::Sqrt(mean / Cast<f64>(sampleCount));
+            REQUIRE(Math::Abs(moments.Mean - mean) < meanError);
+            REQUIRE(Math::Abs(moments.Variance - mean) < 0.05 * mean);
+        }
+    }
+
+    SECTION("Large means with f32 mean type")
+    {
+        Math::Random32 rng(17);
+        Math::PoissonDistribution<u32> dist(5000.0f);
+        SampleMoments moments = Moments(dist, rng, sampleCount);
+
+        REQUIRE(Math::Abs(moments.Mean - 5000.0) < 5.0 * Math::Sqrt(5000.0 / Cast<f64>(sampleCount)));
+        REQUIRE(Math::Abs(moments.Variance - 5000.0) < 250.0);
+    }
+}
@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <Math/Random.hpp>
 
+#include <span>
+
 using namespace Math::Types;
 using Math::Cast;
 
@@ -243,3 +245,18 @@ TEST_CASE("UniformDistribution with a floating point type", "[Math][Random]")
         }
     }
 }
+
+TEST_CASE("Batch generation matches repeated draws", "[Math][Random]")
+{
+    Math::UniformDistribution<u32> distribution(10, 99);
+    Math::Random64 batchRng(17);
+    Math::Random64 scalarRng(17);
+
+    u32 values[37];
+    Math::Generate(std::span<u32>(values), distribution, batchRng);
+    for (u32 value : values)
+    {
+        REQUIRE(value == distribution(scalarRng));
+    }
+    REQUIRE(batchRng() == scalarRng());
+}
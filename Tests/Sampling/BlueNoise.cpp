@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Sampling.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Math::Types;
+using Math::Cast;
+
+TEST_CASE("Blue noise mask", "[Math][Sampling]")
+{
+    constexpr u32 size = 32;
+    std::vector<f32> mask = Math::Sampling::BlueNoiseMask<f32>(size, size, 5);
+
+    SECTION("Every threshold is used exactly once")
+    {
+        REQUIRE(mask.size() == size * size);
+        std::vector<f32> sorted = mask;
+        std::sort(sorted.begin(), sorted.end());
+        for (std::size_t i = 0; i < sorted.size(); ++i)
+        {
+            REQUIRE(sorted[i] == Cast<f32>((Cast<f64>(i) + 0.5) / Cast<f64>(size * size)));
+        }
+    }
+
+    SECTION("Sparse thresholds are spread out across the edges")
+    {
+        // Note(3011): At 10% coverage no two set pixels should be neighbours,
+        // including the neighbours on the other side of the tile.
+        for (u32 y = 0; y < size; ++y)
+        {
+            for (u32 x = 0; x < size; ++x)
+            {
+                if (mask[Math::ToUnderlying(y * size + x)] >= 0.1f)
+                {
+                    continue;
+                }
+
+                u32 right = y * size + (x + 1) % size;
+                u32 down = ((y + 1) % size) * size + x;
+                REQUIRE(mask[Math::ToUnderlying(right)] >= 0.1f);
+                REQUIRE(mask[Math::ToUnderlying(down)] >= 0.1f);
+            }
+        }
+    }
+
+    SECTION("Rectangular masks")
+    {
+        std::vector<f64> rectangular = Math::Sampling::BlueNoiseMask<f64>(16, 4, 1);
+        REQUIRE(rectangular.size() == 64);
+        for (f64 value : rectangular)
+        {
+            REQUIRE(value > 0.0);
+            REQUIRE(value < 1.0);
+        }
+    }
+}
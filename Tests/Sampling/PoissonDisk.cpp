@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Sampling.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    template <typename PointType, typename T>
+    bool RespectsRadius(const std::vector<PointType>& points, T radius)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < points.size(); ++j)
+            {
+                if ((points[i] - points[j]).Length() < radius)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Note(3011): Bridson's algorithm is not guaranteed to be maximal, but with
+    // the default number of attempts a hole larger than two radii is very rare.
+    template <typename T>
+    bool CoversRectangle(const std::vector<Math::Point2T<T>>& points, const Math::Geometry2D::Rectangle<T>& rectangle, T radius)
+    {
+        constexpr u32 probes = 64;
+        for (u32 y = 0; y < probes; ++y)
+        {
+            for (u32 x = 0; x < probes; ++x)
+            {
+                Math::Point2T<T> probe(
+                    rectangle.Min.x + (rectangle.Max.x - rectangle.Min.x) * Cast<T>(x) / Cast<T>(probes - 1),
+                    rectangle.Min.y + (rectangle.Max.y - rectangle.Min.y) * Cast<T>(y) / Cast<T>(probes - 1)
+                );
+
+                bool covered = false;
+                for (const Math::Point2T<T>& point : points)
+                {
+                    covered = covered || (point - probe).Length() < Cast<T>(2) * radius;
+                }
+
+                if (!covered)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Poisson disk sampling", "[Math][Sampling]")
+{
+    SECTION("Rectangle")
+    {
+        Math::Geometry2D::Rectangle<f32> domain(Math::Point2f(-3.0f, 1.0f), Math::Point2f(7.0f, 6.0f));
+        std::vector<Math::Point2f> points = Math::Sampling::PoissonDisk(domain, 0.2f, 1);
+
+        REQUIRE(points.size() > 500);
+        REQUIRE(RespectsRadius(points, 0.2f));
+        REQUIRE(CoversRectangle(points, domain, f32(0.2f)));
+        for (const Math::Point2f& point : points)
+        {
+            REQUIRE(Math::Geometry2D::Contains(domain, point));
+        }
+    }
+
+    SECTION("Circle")
+    {
+        Math::Geometry2D::Circle<f64> domain(Math::Point2d(1.0, 2.0), 4.0);
+        std::vector<Math::Point2d> points = Math::Sampling::PoissonDisk(domain, 0.25, 2);
+
+        REQUIRE(points.size() > 400);
+        REQUIRE(RespectsRadius(points, 0.25));
+        for (const Math::Point2d& point : points)
+        {
+            REQUIRE(Math::Geometry2D::Contains(domain, point));
+        }
+    }
+
+    SECTION("Box")
+    {
+        Math::Geometry::Box<f32> domain(Math::Point3f(0.0f, 0.0f, 0.0f), Math::Point3f(2.0f, 1.0f, 1.5f));
+        std::vector<Math::Point3f> points = Math::Sampling::PoissonDisk(domain, 0.15f, 3);
+
+        REQUIRE(points.size() > 300);
+        REQUIRE(RespectsRadius(points, 0.15f));
+        for (const Math::Point3f& point : points)
+        {
+            REQUIRE(point.x >= 0.0f);
+            REQUIRE(point.x <= 2.0f);
+            REQUIRE(point.y >= 0.0f);
+            REQUIRE(point.y <= 1.0f);
+            REQUIRE(point.z >= 0.0f);
+            REQUIRE(point.z <= 1.5f);
+        }
+    }
+
+    SECTION("Results do not depend on the thread count")
+    {
+        Math::Geometry2D::Rectangle<f32> domain(Math::Point2f(0.0f, 0.0f), Math::Point2f(40.0f, 40.0f));
+        std::vector<Math::Point2f> serial = Math::Sampling::PoissonDisk(domain, 0.3f, 9, 30, 1);
+        std::vector<Math::Point2f> parallel = Math::Sampling::PoissonDisk(domain, 0.3f, 9, 30, 8);
+
+        REQUIRE(serial.size() == parallel.size());
+        for (std::size_t i = 0; i < serial.size(); ++i)
+        {
+            REQUIRE(serial[i].x == parallel[i].x);
+            REQUIRE(serial[i].y == parallel[i].y);
+        }
+
+        REQUIRE(Math::Sampling::PoissonDisk(domain, 0.3f, 10, 30, 8).size() != serial.size());
+    }
+}
@@ -0,0 +1,224 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Constants.hpp>
+#include <Math/Geometry.hpp>
+#include <Math/Random.hpp>
+#include <Math/Sampling.hpp>
+
+#include <cmath>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    constexpr u32 SampleCount = 100'000;
+
+    template <typename Func>
+    f64 Average(u64 seed, Func&& func)
+    {
+        Math::Random64 rng(seed);
+        Math::UniformUnitDistribution<f64> dist;
+        f64 sum = 0.0;
+        for (u32 i = 0; i < SampleCount; ++i)
+        {
+            f64 u1 = dist(rng);
+            f64 u2 = dist(rng);
+            sum += func(Math::Vector2d(u1, u2));
+        }
+        return sum / Cast<f64>(SampleCount);
+    }
+}
+
+TEST_CASE("Branch-free sine and cosine", "[Math][Sampling]")
+{
+    for (i32 i = -1000; i <= 2000; ++i)
+    {
+        f64 turns = Cast<f64>(i) / 1000.0 + 0.00037;
+        f64 sin;
+        f64 cos;
+        Math::Implementation::SinCosTurns(turns, sin, cos);
+        f64 angle = turns * Math::Constant::Tau<f64>;
+        REQUIRE(Math::Abs(sin - f64(std::sin(Math::ToUnderlying(angle)))) < 1.0e-14);
+        REQUIRE(Math::Abs(cos - f64(std::cos(Math::ToUnderlying(angle)))) < 1.0e-14);
+
+        f32 sinf;
+        f32 cosf;
+        Math::Implementation::SinCosTurns(Cast<f32>(turns), sinf, cosf);
+        REQUIRE(Math::Abs(Cast<f64>(sinf) - sin) < 1.0e-6);
+        REQUIRE(Math::Abs(Cast<f64>(cosf) - cos) < 1.0e-6);
+    }
+}
+
+TEST_CASE("Sampling warps", "[Math][Sampling]")
+{
+    // Note(3011): The tolerances are ~5 standard deviations of the estimates.
+
+    SECTION("Disk")
+    {
+        f64 inner = Average(1, [](const Math::Vector2d& u)
+        {
+            Math::Vector2d p = Math::Sampling::SampleUniformDisk(u);
+            REQUIRE(p.LenSqr() <= 1.0 + 1.0e-12);
+            return (p.LenSqr() < 0.25) ? 1.0 : 0.0;
+        });
+        REQUIRE(Math::Abs(inner - 0.25) < 0.007);
+
+        f64 firstQuadrant = Average(2, [](const Math::Vector2d& u)
+        {
+            Math::Vector2d p = Math::Sampling::SampleUniformDisk(u);
+            return (p.x > 0.0 && p.y > 0.0) ? 1.0 : 0.0;
+        });
+        REQUIRE(Math::Abs(firstQuadrant - 0.25) < 0.007);
+    }
+
+    SECTION("Triangle")
+    {
+        Math::Geometry::Triangle<f64> triangle(
+            Math::Point3d(1.0, 0.0, 0.0), Math::Point3d(3.0, 0.0, 0.0), Math::Point3d(1.0, 4.0, 0.0));
+        REQUIRE(Math::Abs(Math::Sampling::PdfTriangle(triangle) - 0.25) < 1.0e-12);
+
+        f64 meanX = Average(3, [&](const Math::Vector2d& u)
+        {
+            Math::Vector2d barycentric = Math::Sampling::SampleUniformTriangle(u);
+            REQUIRE(barycentric.x >= 0.0);
+            REQUIRE(barycentric.y >= 0.0);
+            REQUIRE(barycentric.x + barycentric.y <= 1.0 + 1.0e-12);
+
+            Math::Point3d p = Math::Sampling::SampleTriangle(triangle, u);
+            REQUIRE(p.x >= 1.0 - 1.0e-12);
+            REQUIRE(p.y >= -1.0e-12);
+            REQUIRE(2.0 * (p.x - 1.0) + p.y <= 4.0 + 1.0e-12);
+            return p.x;
+        });
+        // Note(3011): The centroid.
+        REQUIRE(Math::Abs(meanX - 5.0 / 3.0) < 0.01);
+    }
+
+    SECTION("Sphere")
+    {
+        f64 meanZ = Average(4, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SampleUniformSphere(u);
+            REQUIRE(Math::Abs(direction.Length() - 1.0) < 1.0e-12);
+            return (direction.z > 0.5) ? 1.0 : 0.0;
+        });
+        REQUIRE(Math::Abs(meanZ - 0.25) < 0.007);
+
+        Math::Geometry::Sphere<f64> sphere(Math::Point3d(1.0, 2.0, 3.0), 2.0);
+        Math::Random64 rng(5);
+        Math::UniformUnitDistribution<f64> dist;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            f64 u1 = dist(rng);
+            f64 u2 = dist(rng);
+            Math::Point3d p = Math::Sampling::SampleSphere(sphere, Math::Vector2d(u1, u2));
+            REQUIRE(Math::Abs((p - sphere.Center).Length() - 2.0) < 1.0e-12);
+        }
+        REQUIRE(Math::Abs(Math::Sampling::PdfSphere(sphere) * 16.0 * Math::Constant::Pi<f64> - 1.0) < 1.0e-12);
+    }
+
+    SECTION("Hemispheres")
+    {
+        f64 uniformZ = Average(6, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SampleUniformHemisphere(u);
+            REQUIRE(Math::Abs(direction.Length() - 1.0) < 1.0e-12);
+            REQUIRE(direction.z >= 0.0);
+            return direction.z;
+        });
+        REQUIRE(Math::Abs(uniformZ - 0.5) < 0.005);
+
+        f64 cosineZ = Average(7, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SampleCosineHemisphere(u);
+            REQUIRE(Math::Abs(direction.Length() - 1.0) < 1.0e-12);
+            REQUIRE(direction.z >= 0.0);
+            return direction.z;
+        });
+        REQUIRE(Math::Abs(cosineZ - 2.0 / 3.0) < 0.004);
+
+        f64 lobeZ = Average(8, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SamplePhongLobe(u, 10.0);
+            REQUIRE(Math::Abs(direction.Length() - 1.0) < 1.0e-12);
+            return direction.z;
+        });
+        REQUIRE(Math::Abs(lobeZ - 11.0 / 12.0) < 0.002);
+
+        f64 coneZ = Average(9, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SampleUniformCone(u, 0.8);
+            REQUIRE(Math::Abs(direction.Length() - 1.0) < 1.0e-12);
+            REQUIRE(direction.z >= 0.8 - 1.0e-12);
+            return direction.z;
+        });
+        REQUIRE(Math::Abs(coneZ - 0.9) < 0.001);
+    }
+
+    SECTION("Densities integrate to one")
+    {
+        // Note(3011): Integrated over the hemisphere with uniform samples.
+        f64 cosine = Average(10, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SampleUniformHemisphere(u);
+            return Math::Sampling::PdfCosineHemisphere(direction.z) / Math::Sampling::PdfUniformHemisphere<f64>();
+        });
+        REQUIRE(Math::Abs(cosine - 1.0) < 0.01);
+
+        f64 lobe = Average(11, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SampleUniformHemisphere(u);
+            return Math::Sampling::PdfPhongLobe(direction.z, 4.0) / Math::Sampling::PdfUniformHemisphere<f64>();
+        });
+        REQUIRE(Math::Abs(lobe - 1.0) < 0.03);
+
+        f64 cone = Average(12, [](const Math::Vector2d& u)
+        {
+            Math::Vector3d direction = Math::Sampling::SampleUniformHemisphere(u);
+            f64 pdf = (direction.z >= 0.5) ? Math::Sampling::PdfUniformCone<f64>(0.5) : 0.0;
+            return pdf / Math::Sampling::PdfUniformHemisphere<f64>();
+        });
+        REQUIRE(Math::Abs(cone - 1.0) < 0.02);
+
+        f64 disk = Average(13, [](const Math::Vector2d& u)
+        {
+            Math::Vector2d p(2.0 * u.x - 1.0, 2.0 * u.y - 1.0);
+            return (p.LenSqr() < 1.0) ? 4.0 * Math::Sampling::PdfUniformDisk<f64>() : 0.0;
+        });
+        REQUIRE(Math::Abs(disk - 1.0) < 0.01);
+    }
+}
+
+TEST_CASE("Packet sampling warps", "[Math][Sampling]")
+{
+    Math::Random64 rng(14);
+    Math::UniformUnitDistribution<f32> dist;
+    Math::Vector2fPacket<8> u;
+    for (SizeType i = 0; i < 8; ++i)
+    {
+        f32 u1 = dist(rng);
+        f32 u2 = dist(rng);
+        u.Set(i, Math::Vector2f(u1, u2));
+    }
+
+    Math::Vector2fPacket<8> disk = Math::Sampling::SampleUniformDisk(u);
+    Math::Vector3fPacket<8> sphere = Math::Sampling::SampleUniformSphere(u);
+    Math::Vector3fPacket<8> cosine = Math::Sampling::SampleCosineHemisphere(u);
+    Math::Vector3fPacket<8> lobe = Math::Sampling::SamplePhongLobe(u, 20.0f);
+    Math::Array<f32, 8> pdf = Math::Sampling::PdfCosineHemisphere(cosine.z);
+    for (SizeType i = 0; i < 8; ++i)
+    {
+        Math::Vector2f expectedDisk = Math::Sampling::SampleUniformDisk(u.Get(i));
+        REQUIRE(disk.x[i] == expectedDisk.x);
+        REQUIRE(disk.y[i] == expectedDisk.y);
+
+        Math::Vector3f expectedSphere = Math::Sampling::SampleUniformSphere(u.Get(i));
+        REQUIRE(sphere.Get(i).x == expectedSphere.x);
+        REQUIRE(sphere.Get(i).y == expectedSphere.y);
+        REQUIRE(sphere.Get(i).z == expectedSphere.z);
+
+        REQUIRE(cosine.z[i] == Math::Sampling::SampleCosineHemisphere(u.Get(i)).z);
+        REQUIRE(lobe.z[i] == Math::Sampling::SamplePhongLobe(u.Get(i), 20.0f).z);
+        REQUIRE(pdf[i] == Math::Sampling::PdfCosineHemisphere(cosine.z[i]));
+    }
+}
@@ -0,0 +1,208 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Functions.hpp>
+#include <Math/Sequences.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    // Checks that the first `count` values of a dimension fall into `count`
+    // distinct equally sized intervals, which holds for the first b^k points
+    // of every dimension of a (t, s)-sequence in base b.
+    template <typename Func>
+    bool IsStratified(u32 count, Func&& sample)
+    {
+        std::vector<bool> hit(Math::ToUnderlying(count), false);
+        for (u32 i = 0; i < count; ++i)
+        {
+            f64 value = sample(i);
+            if (value < 0.0 || value >= 1.0)
+            {
+                return false;
+            }
+
+            // Note(3011): The small offset absorbs the rounding error of values
+            // that lie exactly on a stratum boundary, e.g. 2/9 computed as 2 * (1/9).
+            auto stratum = Math::ToUnderlying(Math::Floor<i64>(value * Cast<f64>(count) + 1e-9));
+            if (hit[static_cast<std::size_t>(stratum)])
+            {
+                return false;
+            }
+            hit[static_cast<std::size_t>(stratum)] = true;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Sobol sequence", "[Math][Sequences]")
+{
+    SECTION("Unscrambled values")
+    {
+        Math::Sobol sobol(0, Math::Scrambling::None);
+        f64 expected0[] = { 0.0, 0.5, 0.25, 0.75, 0.125, 0.625, 0.375, 0.875 };
+        f64 expected1[] = { 0.0, 0.5, 0.75, 0.25, 0.625, 0.125, 0.375, 0.875 };
+        for (u32 i = 0; i < 8; ++i)
+        {
+            REQUIRE(sobol.Sample<f64>(i, 0) == expected0[Math::ToUnderlying(i)]);
+            REQUIRE(sobol.Sample<f64>(i, 1) == expected1[Math::ToUnderlying(i)]);
+        }
+    }
+
+    SECTION("Every dimension is stratified")
+    {
+        for (Math::Scrambling scrambling : { Math::Scrambling::None, Math::Scrambling::RandomDigit, Math::Scrambling::Owen })
+        {
+            Math::Sobol sobol(1234, scrambling);
+            for (u32 dimension = 0; dimension < Cast<u32>(Math::Sobol::MaxDimension); ++dimension)
+            {
+                REQUIRE(IsStratified(1024, [&](u32 i) { return Cast<f64>(sobol.Sample<f64>(i, dimension)); }));
+            }
+        }
+    }
+
+    SECTION("First two dimensions form a (0, m, 2)-net")
+    {
+        Math::Sobol sobol(77);
+        // Note(3011): 256 points, check all elementary intervals of shape 2^-a x 2^-(8-a).
+        for (u32 a = 0; a <= 8; ++a)
+        {
+            u32 columns = u32(1) << a;
+            u32 rows = u32(1) << (8 - a);
+            std::vector<bool> hit(256, false);
+            for (u32 i = 0; i < 256; ++i)
+            {
+                Math::Vector2d sample = sobol.Sample2D<f64>(i, 0);
+                u32 x = Cast<u32>(sample.x * Cast<f64>(columns));
+                u32 y = Cast<u32>(sample.y * Cast<f64>(rows));
+                std::size_t cell = Math::ToUnderlying(y * columns + x);
+                REQUIRE(!hit[cell]);
+                hit[cell] = true;
+            }
+        }
+    }
+
+    SECTION("Scrambling depends on the seed")
+    {
+        Math::Sobol a(1);
+        Math::Sobol b(2);
+        REQUIRE(a.SampleBits(5, 3) != b.SampleBits(5, 3));
+        REQUIRE(a.SampleBits(5, 3) == Math::Sobol(1).SampleBits(5, 3));
+    }
+
+#if defined(NDEBUG)
+    // Note(3011): Debug builds assert instead.
+    SECTION("Dimensions past the matrices are rejected")
+    {
+        Math::Sobol sobol(5);
+        u32 last = Cast<u32>(Math::Sobol::MaxDimension - 1);
+        REQUIRE(sobol.Sample<f64>(3, last) == sobol.Sample<f64>(3, last));
+        REQUIRE(sobol.Sample<f64>(3, last + 1) != sobol.Sample<f64>(3, last + 1));
+        REQUIRE(sobol.SampleBits(3, last + 1) == 0u);
+    }
+#endif
+}
+
+TEST_CASE("Halton sequence", "[Math][Sequences]")
+{
+    SECTION("Unscrambled values")
+    {
+        Math::Halton halton(0, Math::Scrambling::None);
+        REQUIRE(Math::Halton::Base(0) == 2u);
+        REQUIRE(Math::Halton::Base(1) == 3u);
+        REQUIRE(Math::Halton::Base(Cast<u32>(Math::Halton::MaxDimension - 1)) == 719u);
+
+        REQUIRE(Math::Equal(halton.Sample<f64>(1, 1), 1.0 / 3.0));
+        REQUIRE(Math::Equal(halton.Sample<f64>(5, 1), 7.0 / 9.0));
+        REQUIRE(Math::Equal(halton.Sample<f64>(7, 3), 1.0 / 49.0));
+    }
+
+    SECTION("Dimensions are stratified in their base")
+    {
+        for (Math::Scrambling scrambling : { Math::Scrambling::None, Math::Scrambling::RandomDigit, Math::Scrambling::Owen })
+        {
+            Math::Halton halton(99, scrambling);
+            for (u32 dimension = 0; dimension < 16; ++dimension)
+            {
+                u32 base = Math::Halton::Base(dimension);
+                u32 count = base * base;
+                REQUIRE(IsStratified(count, [&](u32 i) { return Cast<f64>(halton.Sample<f64>(Cast<u64>(i), dimension)); }));
+            }
+        }
+    }
+
+#if defined(NDEBUG)
+    // Note(3011): Debug builds assert instead.
+    SECTION("Dimensions past the bases are rejected")
+    {
+        Math::Halton halton(5);
+        u32 outside = Cast<u32>(Math::Halton::MaxDimension);
+        REQUIRE(Math::Halton::Base(outside) == 0u);
+        REQUIRE(halton.Sample<f64>(3, outside) != halton.Sample<f64>(3, outside));
+    }
+#endif
+
+    SECTION("Single precision samples stay below one")
+    {
+        Math::Halton halton(3);
+        for (u64 i = 0; i < 4096; ++i)
+        {
+            REQUIRE(halton.Sample<f32>(i, 5) < 1.0f);
+        }
+    }
+}
+
+TEST_CASE("R sequence", "[Math][Sequences]")
+{
+    SECTION("One dimensional golden ratio sequence")
+    {
+        Math::RSequence sequence(1, 0, Math::Scrambling::None);
+        f64 alpha = 1.0 / Math::Constant::Phi<f64>;
+        for (u64 i = 0; i < 100; ++i)
+        {
+            f64 expected = Math::Frac(0.5 + Cast<f64>(i) * alpha);
+            REQUIRE(Math::Abs(sequence.Sample<f64>(i, 0) - expected) < 1e-9);
+        }
+    }
+
+    SECTION("Samples are in the unit interval and well spread")
+    {
+        Math::RSequence sequence(2, 42);
+        constexpr u32 count = 4096;
+        std::vector<u32> cells(64, 0);
+        for (u32 i = 0; i < count; ++i)
+        {
+            Math::Vector2f sample = sequence.Sample2D<f32>(Cast<u64>(i), 0);
+            REQUIRE(sample.x >= 0.0f);
+            REQUIRE(sample.x < 1.0f);
+            REQUIRE(sample.y >= 0.0f);
+            REQUIRE(sample.y < 1.0f);
+            ++cells[Math::ToUnderlying(Cast<u32>(sample.y * 8.0f) * 8 + Cast<u32>(sample.x * 8.0f))];
+        }
+
+        for (u32 cellCount : cells)
+        {
+            REQUIRE(cellCount >= 56u);
+            REQUIRE(cellCount <= 72u);
+        }
+    }
+
+    SECTION("Scrambling is a rotation of every dimension")
+    {
+        Math::RSequence plain(3, 7, Math::Scrambling::None);
+        Math::RSequence digit(3, 7, Math::Scrambling::RandomDigit);
+        Math::RSequence owen(3, 7, Math::Scrambling::Owen);
+        for (u32 dimension = 0; dimension < 3; ++dimension)
+        {
+            u64 shift = digit.SampleBits(0, dimension) - plain.SampleBits(0, dimension);
+            for (u64 i = 0; i < 100; ++i)
+            {
+                REQUIRE(digit.SampleBits(i, dimension) == plain.SampleBits(i, dimension) + shift);
+                REQUIRE(owen.SampleBits(i, dimension) == digit.SampleBits(i, dimension));
+            }
+            REQUIRE(plain.SampleBits(1, dimension) != plain.SampleBits(1, (dimension + 1) % 3));
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Math/Functions.hpp>
+#include <Math/Sequences.hpp>
+
+#include <vector>
+
+using namespace Math::Types;
+using Math::Cast;
+
+namespace
+{
+    // Checks that every cell of a columns x rows grid holds exactly one point.
+    template <typename Func>
+    bool OnePointPerCell(u32 columns, u32 rows, Func&& sample)
+    {
+        std::vector<bool> hit(Math::ToUnderlying(columns * rows), false);
+        for (u32 i = 0; i < columns * rows; ++i)
+        {
+            Math::Vector2d point = sample(i);
+            if (point.x < 0.0 || point.x >= 1.0 || point.y < 0.0 || point.y >= 1.0)
+            {
+                return false;
+            }
+
+            u32 x = Cast<u32>(point.x * Cast<f64>(columns));
+            u32 y = Cast<u32>(point.y * Cast<f64>(rows));
+            std::size_t cell = Math::ToUnderlying(y * columns + x);
+            if (hit[cell])
+            {
+                return false;
+            }
+            hit[cell] = true;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Stratified sampler", "[Math][Sequences]")
+{
+    SECTION("Square counts")
+    {
+        Math::StratifiedSampler sampler(16, 3);
+        for (u32 pattern = 0; pattern < 8; ++pattern)
+        {
+            REQUIRE(OnePointPerCell(4, 4, [&](u32 i) { return sampler.Sample2D<f64>(i, pattern); }));
+        }
+    }
+
+    SECTION("Other counts")
+    {
+        Math::StratifiedSampler sampler(12, 3);
+        REQUIRE(sampler.Count() == 12u);
+        REQUIRE(OnePointPerCell(3, 4, [&](u32 i) { return sampler.Sample2D<f64>(i, 5); }));
+
+        Math::StratifiedSampler single(1);
+        Math::Vector2f point = single.Sample2D<f32>(0);
+        REQUIRE(point.x >= 0.0f);
+        REQUIRE(point.x < 1.0f);
+    }
+}
+
+TEST_CASE("Correlated multi-jittered sampler", "[Math][Sequences]")
+{
+    for (u32 count : { 16u, 12u, 30u })
+    {
+        Math::CMJSampler sampler(count, 9);
+        for (u32 pattern = 0; pattern < 8; ++pattern)
+        {
+            auto sample = [&](u32 i) { return sampler.Sample2D<f64>(i, pattern); };
+            // Note(3011): The n-rooks property, and the coarse grid.
+            REQUIRE(OnePointPerCell(count, 1, sample));
+            REQUIRE(OnePointPerCell(1, count, sample));
+            u32 columns = Math::Implementation::JitterGridColumns(count);
+            REQUIRE(OnePointPerCell(columns, count / columns, sample));
+        }
+    }
+
+    SECTION("Patterns are decorrelated")
+    {
+        Math::CMJSampler sampler(16);
+        REQUIRE(sampler.Sample2D<f64>(0, 0).x != sampler.Sample2D<f64>(0, 1).x);
+    }
+}
+
+TEST_CASE("PMJ02 sampler", "[Math][Sequences]")
+{
+    SECTION("Every power of two prefix is a (0, m, 2)-net")
+    {
+        Math::PMJ02Sampler sampler(42);
+        for (u32 pattern = 0; pattern < 4; ++pattern)
+        {
+            for (u32 m = 0; m <= 8; ++m)
+            {
+                for (u32 a = 0; a <= m; ++a)
+                {
+                    REQUIRE(OnePointPerCell(u32(1) << a, u32(1) << (m - a), [&](u32 i)
+                    {
+                        return sampler.Sample2D<f64>(i, pattern);
+                    }));
+                }
+            }
+        }
+    }
+
+    SECTION("Later blocks are nets as well")
+    {
+        Math::PMJ02Sampler sampler(7);
+        for (u32 a = 0; a <= 6; ++a)
+        {
+            REQUIRE(OnePointPerCell(u32(1) << a, u32(1) << (6 - a), [&](u32 i)
+            {
+                return sampler.Sample2D<f64>(64 * 5 + i, 11);
+            }));
+        }
+    }
+
+    SECTION("Patterns are decorrelated")
+    {
+        Math::PMJ02Sampler sampler;
+        REQUIRE(sampler.Sample2D<f32>(0, 0).x != sampler.Sample2D<f32>(0, 1).x);
+    }
+}